@@ -19,6 +19,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 #include <algorithm>
 #include <cerrno>
+#include <dirent.h>
 #include <fcntl.h>
 #include <regex>
 #include <sys/file.h>
@@ -27,6 +28,8 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <unistd.h>
 
 #include "builder/BuilderJson.h"
+#include "builder/BuilderPool.h"
+#include "builder/BuilderWorker.h"
 #include "common/Ctx.h"
 #include "common/Thread.h"
 #include "common/types.h"
@@ -40,7 +43,10 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "metadata/Checkpoint.h"
 #include "metadata/Metadata.h"
 #include "metadata/SchemaElement.h"
+#include "metadata/SerializerBinary.h"
 #include "metadata/SerializerJson.h"
+#include "parser/ParserPool.h"
+#include "parser/ParserWorker.h"
 #include "parser/TransactionBuffer.h"
 #include "replicator/Replicator.h"
 #include "replicator/ReplicatorBatch.h"
@@ -95,6 +101,14 @@ namespace OpenLogReplicator {
             delete replicatorTmp;
         replicators.clear();
 
+        for (ParserPool* parserPool: parserPools)
+            delete parserPool;
+        parserPools.clear();
+
+        for (BuilderPool* builderPool: builderPools)
+            delete builderPool;
+        builderPools.clear();
+
         for (Builder* builder: builders)
             delete builder;
         builders.clear();
@@ -161,7 +175,7 @@ namespace OpenLogReplicator {
 
         if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
             static const char* documentNames[] = {"version", "dump-path", "dump-raw-data", "dump-redo-log", "log-level", "trace",
-                                                  "source", "target", nullptr};
+                                                  "source", "target", "memory", "parser-threads", nullptr};
             Ctx::checkJsonFields(configFileName, document, documentNames);
         }
 
@@ -203,81 +217,96 @@ namespace OpenLogReplicator {
                                                     ", expected: one of {0 .. 524287}");
         }
 
-        // Iterate through sources
+        // Many sources share one memory pool, configured outside the sources
         const rapidjson::Value& sourceArrayJson = Ctx::getJsonFieldA(configFileName, document, "source");
-        if (sourceArrayJson.Size() != 1) {
+        uint64_t poolMaxMb = 0;
+        if (document.HasMember("memory"))
+            poolMaxMb = mainProcessMemory(document);
+        else if (sourceArrayJson.Size() != 1) {
             throw ConfigurationException(30001, "bad JSON, invalid \"source\" value: " + std::to_string(sourceArrayJson.Size()) +
-                                                " elements, expected: 1 element");
+                                                " elements, expected: 1 element when \"memory\" is not set");
+        }
+        if (sourceArrayJson.Size() < 1) {
+            throw ConfigurationException(30001, "bad JSON, invalid \"source\" value: " + std::to_string(sourceArrayJson.Size()) +
+                                                " elements, expected: at least 1 element");
+        }
+
+        // Parser threads shared by sources which don't have their own
+        ParserPool* sharedParserPool = nullptr;
+        if (document.HasMember("parser-threads")) {
+            uint64_t parserThreads = Ctx::getJsonFieldU64(configFileName, document, "parser-threads");
+            if (parserThreads > 64)
+                throw ConfigurationException(30001, "bad JSON, invalid \"parser-threads\" value: " + std::to_string(parserThreads) +
+                                                    ", expected: one of {0 .. 64}");
+
+            if (parserThreads > 0) {
+                sharedParserPool = new ParserPool(ctx);
+                parserPools.push_back(sharedParserPool);
+
+                for (uint64_t i = 0; i < parserThreads; ++i) {
+                    auto parserWorker = new ParserWorker(ctx, "parser-" + std::to_string(i), sharedParserPool);
+                    sharedParserPool->addWorker(parserWorker);
+                    ctx->spawnThread(parserWorker);
+                }
+            }
         }
 
+        // Iterate through sources
         for (rapidjson::SizeType j = 0; j < sourceArrayJson.Size(); ++j) {
             const rapidjson::Value& sourceJson = Ctx::getJsonFieldO(configFileName, sourceArrayJson, "source", j);
+            // Threads created for the source inherit its memory quota
+            Ctx::memoryQuotaSet(nullptr);
 
             if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
                 static const char* sourceNames[] = {"alias", "memory", "name", "reader", "flags", "state", "debug",
                                                     "transaction-max-mb", "metrics", "format", "redo-read-sleep-us", "arch-read-sleep-us",
                                                     "arch-read-tries", "redo-verify-delay-us", "refresh-interval-us", "arch",
-                                                    "filter", nullptr};
+                                                    "filter", "redo-read-queue-depth", "arch-prefetch", nullptr};
                 Ctx::checkJsonFields(configFileName, sourceJson, sourceNames);
             }
 
             const char* alias = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, sourceJson, "alias");
             ctx->info(0, "adding source: " + std::string(alias));
 
-            uint64_t memoryMinMb = 32;
-            uint64_t memoryMaxMb = 1024;
-            uint64_t readBufferMax = memoryMaxMb / 4 / Ctx::MEMORY_CHUNK_SIZE_MB;
-
-            // MEMORY
-            if (sourceJson.HasMember("memory")) {
-                const rapidjson::Value& memoryJson = Ctx::getJsonFieldO(configFileName, sourceJson, "memory");
+            uint64_t memoryMaxMb;
+            if (document.HasMember("memory")) {
+                // The memory pool is shared by all sources, a source may only limit its own part of it
+                memoryMaxMb = poolMaxMb;
+                if (sourceJson.HasMember("memory")) {
+                    const rapidjson::Value& memoryJson = Ctx::getJsonFieldO(configFileName, sourceJson, "memory");
 
-                if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
-                    static const char* memoryNames[] = {"min-mb", "max-mb", "read-buffer-max-mb", nullptr};
-                    Ctx::checkJsonFields(configFileName, memoryJson, memoryNames);
-                }
-
-                if (memoryJson.HasMember("min-mb")) {
-                    memoryMinMb = Ctx::getJsonFieldU64(configFileName, memoryJson, "min-mb");
-                    memoryMinMb = (memoryMinMb / Ctx::MEMORY_CHUNK_SIZE_MB) * Ctx::MEMORY_CHUNK_SIZE_MB;
-                    if (memoryMinMb < Ctx::MEMORY_CHUNK_MIN_MB)
-                        throw ConfigurationException(30001, "bad JSON, invalid \"min-mb\" value: " + std::to_string(memoryMinMb) +
-                                                            ", expected: at least " + std::to_string(Ctx::MEMORY_CHUNK_MIN_MB));
-                }
-
-                if (memoryJson.HasMember("max-mb")) {
-                    memoryMaxMb = Ctx::getJsonFieldU64(configFileName, memoryJson, "max-mb");
-                    memoryMaxMb = (memoryMaxMb / Ctx::MEMORY_CHUNK_SIZE_MB) * Ctx::MEMORY_CHUNK_SIZE_MB;
-                    if (memoryMaxMb < memoryMinMb)
-                        throw ConfigurationException(30001, "bad JSON, invalid \"max-mb\" value: " + std::to_string(memoryMaxMb) +
-                                                            ", expected: at least like \"min-mb\" value (" + std::to_string(memoryMinMb) + ")");
-
-                    readBufferMax = memoryMaxMb / 4 / Ctx::MEMORY_CHUNK_SIZE_MB;
-                    if (readBufferMax > 32 / Ctx::MEMORY_CHUNK_SIZE_MB)
-                        readBufferMax = 32 / Ctx::MEMORY_CHUNK_SIZE_MB;
-                }
+                    if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
+                        static const char* memoryNames[] = {"max-mb", nullptr};
+                        Ctx::checkJsonFields(configFileName, memoryJson, memoryNames);
+                    }
 
-                if (memoryJson.HasMember("read-buffer-max-mb")) {
-                    readBufferMax = Ctx::getJsonFieldU64(configFileName, memoryJson, "read-buffer-max-mb") / Ctx::MEMORY_CHUNK_SIZE_MB;
-                    if (readBufferMax * Ctx::MEMORY_CHUNK_SIZE_MB > memoryMaxMb)
-                        throw ConfigurationException(30001, "bad JSON, invalid \"read-buffer-max-mb\" value: " +
-                                                            std::to_string(readBufferMax * Ctx::MEMORY_CHUNK_SIZE_MB) +
-                                                            ", expected: not greater than \"max-mb\" value (" + std::to_string(memoryMaxMb) + ")");
-                    if (readBufferMax <= 1)
-                        throw ConfigurationException(30001, "bad JSON, invalid \"read-buffer-max-mb\" value: " +
-                                                            std::to_string(readBufferMax) + ", expected: at least: " +
-                                                            std::to_string(Ctx::MEMORY_CHUNK_SIZE_MB * 2));
+                    if (memoryJson.HasMember("max-mb")) {
+                        memoryMaxMb = Ctx::getJsonFieldU64(configFileName, memoryJson, "max-mb");
+                        memoryMaxMb = (memoryMaxMb / Ctx::MEMORY_CHUNK_SIZE_MB) * Ctx::MEMORY_CHUNK_SIZE_MB;
+                        if (memoryMaxMb < Ctx::MEMORY_CHUNK_MIN_MB || memoryMaxMb > poolMaxMb)
+                            throw ConfigurationException(30001, "bad JSON, invalid \"max-mb\" value: " + std::to_string(memoryMaxMb) +
+                                                                ", expected: one of {" + std::to_string(Ctx::MEMORY_CHUNK_MIN_MB) + " .. " +
+                                                                std::to_string(poolMaxMb) + "}");
+                        Ctx::memoryQuotaSet(ctx->memoryQuotaCreate(memoryMaxMb));
+                    }
                 }
-            }
+            } else
+                memoryMaxMb = mainProcessMemory(sourceJson);
 
             const char* name = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, sourceJson, "name");
+            for (const Replicator* replicatorTmp: replicators)
+                if (replicatorTmp->database == name)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"name\" value: " + std::string(name) +
+                                                        ", expected: unique value, used by other source");
+            if (j > 0)
+                mainProcessShared(sourceArrayJson[0], sourceJson, alias);
             const rapidjson::Value& readerJson = Ctx::getJsonFieldO(configFileName, sourceJson, "reader");
 
             if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
                 static const char* readerNames[] = {"disable-checks", "start-scn", "start-seq", "start-time-rel", "start-time",
                                                     "con-id", "type", "redo-copy-path", "db-timezone", "host-timezone", "log-timezone",
                                                     "user", "password", "server", "redo-log", "path-mapping", "log-archive-format",
-                                                    nullptr};
+                                                    "parser-threads", nullptr};
                 Ctx::checkJsonFields(configFileName, readerJson, readerNames);
             }
 
@@ -326,13 +355,14 @@ namespace OpenLogReplicator {
 
             uint64_t stateType = State::TYPE_DISK;
             const char* statePath = "checkpoint";
+            bool stateBinary = false;
 
             if (sourceJson.HasMember("state")) {
                 const rapidjson::Value& stateJson = Ctx::getJsonFieldO(configFileName, sourceJson, "state");
 
                 if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
-                    static const char* stateNames[] = {"type", "path", "interval-s", "interval-mb", "keep-checkpoints",
-                                                       "schema-force-interval", nullptr};
+                    static const char* stateNames[] = {"type", "path", "format", "interval-s", "interval-mb", "keep-checkpoints",
+                                                       "schema-force-interval", "schema-delta-max", nullptr};
                     Ctx::checkJsonFields(configFileName, stateJson, stateNames);
                 }
 
@@ -347,6 +377,17 @@ namespace OpenLogReplicator {
                                                             ", expected: one of {\"disk\"}");
                 }
 
+                if (stateJson.HasMember("format")) {
+                    const char* stateFormatStr = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, stateJson, "format");
+                    if (strcmp(stateFormatStr, "json") == 0)
+                        stateBinary = false;
+                    else if (strcmp(stateFormatStr, "binary") == 0)
+                        stateBinary = true;
+                    else
+                        throw ConfigurationException(30001, std::string("bad JSON, invalid \"format\" value: ") + stateFormatStr +
+                                                            ", expected: one of {\"json\", \"binary\"}");
+                }
+
                 if (stateJson.HasMember("interval-s"))
                     ctx->checkpointIntervalS = Ctx::getJsonFieldU64(configFileName, stateJson, "interval-s");
 
@@ -358,6 +399,9 @@ namespace OpenLogReplicator {
 
                 if (stateJson.HasMember("schema-force-interval"))
                     ctx->schemaForceInterval = Ctx::getJsonFieldU64(configFileName, stateJson, "schema-force-interval");
+
+                if (stateJson.HasMember("schema-delta-max"))
+                    ctx->schemaDeltaMax = Ctx::getJsonFieldU64(configFileName, stateJson, "schema-delta-max");
             }
 
             const char* debugOwner = nullptr;
@@ -399,6 +443,14 @@ namespace OpenLogReplicator {
             if (readerJson.HasMember("con-id"))
                 conId = Ctx::getJsonFieldI16(configFileName, readerJson, "con-id");
 
+            uint64_t parserThreads = 0;
+            if (readerJson.HasMember("parser-threads")) {
+                parserThreads = Ctx::getJsonFieldU64(configFileName, readerJson, "parser-threads");
+                if (parserThreads > 64)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"parser-threads\" value: " + std::to_string(parserThreads) +
+                                                        ", expected: one of {0 .. 64}");
+            }
+
             if (sourceJson.HasMember("transaction-max-mb")) {
                 uint64_t transactionMaxMb = Ctx::getJsonFieldU64(configFileName, sourceJson, "transaction-max-mb");
                 if (transactionMaxMb > memoryMaxMb)
@@ -408,9 +460,6 @@ namespace OpenLogReplicator {
                 ctx->transactionSizeMax = transactionMaxMb * 1024 * 1024;
             }
 
-            // MEMORY MANAGER
-            ctx->initialize(memoryMinMb, memoryMaxMb, readBufferMax);
-
             // METADATA
             Metadata* metadata = new Metadata(ctx, locales, name, conId, startScn,
                                               startSequence, startTime, startTimeRel);
@@ -427,7 +476,10 @@ namespace OpenLogReplicator {
             if (stateType == State::TYPE_DISK) {
                 metadata->state = new StateDisk(ctx, statePath);
                 metadata->stateDisk = new StateDisk(ctx, "scripts");
-                metadata->serializer = new SerializerJson();
+                if (stateBinary)
+                    metadata->serializer = new SerializerBinary();
+                else
+                    metadata->serializer = new SerializerJson();
             }
 
             // CHECKPOINT
@@ -443,6 +495,9 @@ namespace OpenLogReplicator {
             // METRICS
             if (sourceJson.HasMember("metrics")) {
                 const rapidjson::Value& metricsJson = Ctx::getJsonFieldO(configFileName, sourceJson, "metrics");
+                if (ctx->metrics != nullptr)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"metrics\" value for source: " + std::string(alias) +
+                                                        ", expected: set for one source only");
 
                 if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
                     static const char* metricsNames[] = {"type", "bind", "tag-names", nullptr};
@@ -493,7 +548,7 @@ namespace OpenLogReplicator {
             if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
                 static const char* formatNames[] = {"db", "attributes", "interval-dts", "interval-ytm", "message", "rid", "xid",
                                                     "timestamp", "timestamp-tz", "timestamp-all", "char", "scn", "scn-all",
-                                                    "unknown", "schema", "column", "unknown-type", "flush-buffer", "type",
+                                                    "unknown", "schema", "column", "unknown-type", "lob", "flush-buffer", "threads", "type",
                                                     nullptr};
                 Ctx::checkJsonFields(configFileName, formatJson, formatNames);
             }
@@ -644,37 +699,71 @@ namespace OpenLogReplicator {
                                                         ", expected: one of {0, 1}");
             }
 
+            uint64_t lobFormat = Builder::LOB_FORMAT_VALUE;
+            if (formatJson.HasMember("lob")) {
+                lobFormat = Ctx::getJsonFieldU64(configFileName, formatJson, "lob");
+                if (lobFormat > 1)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"lob\" value: " + std::to_string(lobFormat) +
+                                                        ", expected: one of {0, 1}");
+            }
+
             uint64_t flushBuffer = 1048576;
             if (formatJson.HasMember("flush-buffer"))
                 flushBuffer = Ctx::getJsonFieldU64(configFileName, formatJson, "flush-buffer");
 
+            uint64_t builderThreads = 0;
+            if (formatJson.HasMember("threads")) {
+                builderThreads = Ctx::getJsonFieldU64(configFileName, formatJson, "threads");
+                if (builderThreads > 64)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"threads\" value: " + std::to_string(builderThreads) +
+                                                        ", expected: one of {0 .. 64}");
+            }
+
             const char* formatType = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, formatJson, "type");
 
-            Builder* builder;
-            if (strcmp("json", formatType) == 0) {
-                builder = new BuilderJson(ctx, locales, metadata, dbFormat, attributesFormat,
-                                          intervalDtsFormat, intervalYtmFormat, messageFormat,
-                                          ridFormat, xidFormat, timestampFormat,
-                                          timestampTzFormat, timestampAll, charFormat, scnFormat,
-                                          scnAll, unknownFormat, schemaFormat, columnFormat,
-                                          unknownType, flushBuffer);
-            } else if (strcmp("protobuf", formatType) == 0) {
+            // The first builder is used by the parser thread, every builder pool thread has its own one
+            Builder* builder = nullptr;
+            BuilderPool* builderPool = nullptr;
+            for (uint64_t i = 0; i <= builderThreads; ++i) {
+                Builder* builderTmp;
+                if (strcmp("json", formatType) == 0) {
+                    builderTmp = new BuilderJson(ctx, locales, metadata, dbFormat, attributesFormat,
+                                                 intervalDtsFormat, intervalYtmFormat, messageFormat,
+                                                 ridFormat, xidFormat, timestampFormat,
+                                                 timestampTzFormat, timestampAll, charFormat, scnFormat,
+                                                 scnAll, unknownFormat, schemaFormat, columnFormat,
+                                                 unknownType, lobFormat, flushBuffer);
+                } else if (strcmp("protobuf", formatType) == 0) {
 #ifdef LINK_LIBRARY_PROTOBUF
-                builder = new BuilderProtobuf(ctx, locales, metadata, dbFormat, attributesFormat,
-                                              intervalDtsFormat, intervalYtmFormat, messageFormat,
-                                              ridFormat, xidFormat, timestampFormat,
-                                              timestampTzFormat, timestampAll, charFormat, scnFormat,
-                                              scnAll, unknownFormat, schemaFormat,
-                                              columnFormat, unknownType, flushBuffer);
+                    builderTmp = new BuilderProtobuf(ctx, locales, metadata, dbFormat, attributesFormat,
+                                                     intervalDtsFormat, intervalYtmFormat, messageFormat,
+                                                     ridFormat, xidFormat, timestampFormat,
+                                                     timestampTzFormat, timestampAll, charFormat, scnFormat,
+                                                     scnAll, unknownFormat, schemaFormat,
+                                                     columnFormat, unknownType, lobFormat, flushBuffer);
 #else
-                throw ConfigurationException(30001, "bad JSON, invalid \"format\" value: " + std::string(formatType) +
-                                             ", expected: not \"protobuf\" since the code is not compiled");
+                    throw ConfigurationException(30001, "bad JSON, invalid \"format\" value: " + std::string(formatType) +
+                                                 ", expected: not \"protobuf\" since the code is not compiled");
 #endif /* LINK_LIBRARY_PROTOBUF */
-            } else
-                throw ConfigurationException(30001, "bad JSON, invalid \"format\" value: " + std::string(formatType) +
-                                                    ", expected: \"protobuf\" or \"json\"");
-            builders.push_back(builder);
-            builder->initialize();
+                } else
+                    throw ConfigurationException(30001, "bad JSON, invalid \"format\" value: " + std::string(formatType) +
+                                                        ", expected: \"protobuf\" or \"json\"");
+                builders.push_back(builderTmp);
+                builderTmp->initialize();
+
+                if (i == 0) {
+                    builder = builderTmp;
+                    if (builderThreads > 0) {
+                        builderPool = new BuilderPool(ctx, builder, metadata, transactionBuffer);
+                        builderPools.push_back(builderPool);
+                        builder->pool = builderPool;
+                    }
+                } else {
+                    auto builderWorker = new BuilderWorker(ctx, std::string(alias) + "-builder-" + std::to_string(i), builderPool, builderTmp);
+                    builderPool->addWorker(builderWorker);
+                    ctx->spawnThread(builderWorker);
+                }
+            }
 
             // READER
             const char* readerType = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, readerJson, "type");
@@ -693,6 +782,25 @@ namespace OpenLogReplicator {
                                                         std::to_string(ctx->archReadTries) + ", expected: one of: {1 .. 1000000000}");
             }
 
+            if (sourceJson.HasMember("arch-prefetch")) {
+                ctx->archPrefetch = Ctx::getJsonFieldU64(configFileName, sourceJson, "arch-prefetch");
+                if (ctx->archPrefetch > 16)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"arch-prefetch\" value: " +
+                                                        std::to_string(ctx->archPrefetch) + ", expected: one of {0 .. 16}");
+            }
+
+            if (sourceJson.HasMember("redo-read-queue-depth")) {
+                ctx->redoReadQueueDepth = Ctx::getJsonFieldU64(configFileName, sourceJson, "redo-read-queue-depth");
+                if (ctx->redoReadQueueDepth > 64)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"redo-read-queue-depth\" value: " +
+                                                        std::to_string(ctx->redoReadQueueDepth) + ", expected: one of {0 .. 64}");
+#ifndef LINK_LIBRARY_URING
+                if (ctx->redoReadQueueDepth > 0)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"redo-read-queue-depth\" value: " +
+                                                        std::to_string(ctx->redoReadQueueDepth) + ", expected: 0 since the code is not compiled");
+#endif /* LINK_LIBRARY_URING */
+            }
+
             if (sourceJson.HasMember("redo-verify-delay-us"))
                 ctx->redoVerifyDelayUs = Ctx::getJsonFieldU64(configFileName, sourceJson, "redo-verify-delay-us");
 
@@ -793,6 +901,20 @@ namespace OpenLogReplicator {
                 throw ConfigurationException(30001, "bad JSON, invalid \"type\" value: " + std::string(readerType) +
                                                     ", expected: one of {\"online\", \"offline\", \"batch\"}");
 
+            // Redo log records of one LWN are decoded by the parser thread together with the pool threads
+            if (parserThreads > 0) {
+                auto parserPool = new ParserPool(ctx);
+                parserPools.push_back(parserPool);
+                replicator->parserPool = parserPool;
+
+                for (uint64_t i = 0; i < parserThreads; ++i) {
+                    auto parserWorker = new ParserWorker(ctx, std::string(alias) + "-parser-" + std::to_string(i), parserPool);
+                    parserPool->addWorker(parserWorker);
+                    ctx->spawnThread(parserWorker);
+                }
+            } else
+                replicator->parserPool = sharedParserPool;
+
             if (sourceJson.HasMember("filter")) {
                 const rapidjson::Value& filterJson = Ctx::getJsonFieldO(configFileName, sourceJson, "filter");
 
@@ -866,15 +988,16 @@ namespace OpenLogReplicator {
 
             metadata->commitElements();
             replicators.push_back(replicator);
+            ++ctx->replicatorsRunning;
             ctx->spawnThread(replicator);
             replicator = nullptr;
         }
 
         // Iterate through targets
         const rapidjson::Value& targetArrayJson = Ctx::getJsonFieldA(configFileName, document, "target");
-        if (targetArrayJson.Size() != 1) {
+        if (targetArrayJson.Size() < 1) {
             throw ConfigurationException(30001, "bad JSON, invalid \"target\" value: " + std::to_string(targetArrayJson.Size()) +
-                                                " elements, expected: 1 element");
+                                                " elements, expected: at least 1 element");
         }
 
         for (rapidjson::SizeType j = 0; j < targetArrayJson.Size(); ++j) {
@@ -890,16 +1013,27 @@ namespace OpenLogReplicator {
             if (replicator2 == nullptr)
                 throw ConfigurationException(30001, "bad JSON, invalid \"source\" value: " + std::string(source) +
                                                     ", expected: value used earlier in \"source\" field");
+            // Messages of the source are freed by the writer
+            Ctx::memoryQuotaSet(replicator2->memoryQuota);
 
             // Writer
             Writer* writer;
             const rapidjson::Value& writerJson = Ctx::getJsonFieldO(configFileName, targetJson, "writer");
             const char* writerType = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, writerJson, "type");
 
+            // A stream client controls the starting position of the source, it can't be shared with other targets
+            if (strcmp(writerType, "zeromq") == 0 || strcmp(writerType, "network") == 0) {
+                for (rapidjson::SizeType k = 0; k < targetArrayJson.Size(); ++k) {
+                    if (k != j && strcmp(Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, targetArrayJson[k], "source"), source) == 0)
+                        throw ConfigurationException(30001, "bad JSON, invalid \"source\" value: " + std::string(source) +
+                                                            ", expected: not used by other targets for writer type: " + writerType);
+                }
+            }
+
             if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
                 static const char* writerNames[] = {"type", "poll-interval-us", "queue-size", "max-file-size", "timestamp-format",
                                                     "output", "new-line", "append", "max-message-mb", "topic", "properties",
-                                                    "uri", nullptr};
+                                                    "uri", "batch-kb", "linger-us", "zero-copy-kb", nullptr};
                 Ctx::checkJsonFields(configFileName, writerJson, writerNames);
             }
 
@@ -999,8 +1133,33 @@ namespace OpenLogReplicator {
 #ifdef LINK_LIBRARY_PROTOBUF
                 const char* uri = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, writerJson, "uri");
 
+                uint64_t batchKb = StreamNetwork::DEFAULT_BATCH_BYTES / 1024;
+                if (writerJson.HasMember("batch-kb")) {
+                    batchKb = Ctx::getJsonFieldU64(configFileName, writerJson, "batch-kb");
+                    if (batchKb < 1 || batchKb > 65536)
+                        throw ConfigurationException(30001, "bad JSON, invalid \"batch-kb\" value: " + std::to_string(batchKb) +
+                                                            ", expected: one of {1 .. 65536}");
+                }
+
+                uint64_t lingerUs = 0;
+                if (writerJson.HasMember("linger-us")) {
+                    lingerUs = Ctx::getJsonFieldU64(configFileName, writerJson, "linger-us");
+                    if (lingerUs > 1000000)
+                        throw ConfigurationException(30001, "bad JSON, invalid \"linger-us\" value: " + std::to_string(lingerUs) +
+                                                            ", expected: one of {0 .. 1000000}");
+                }
+
+                uint64_t zeroCopyKb = 0;
+                if (writerJson.HasMember("zero-copy-kb")) {
+                    zeroCopyKb = Ctx::getJsonFieldU64(configFileName, writerJson, "zero-copy-kb");
+                    if (zeroCopyKb > 1048576)
+                        throw ConfigurationException(30001, "bad JSON, invalid \"zero-copy-kb\" value: " + std::to_string(zeroCopyKb) +
+                                                            ", expected: one of {0 .. 1048576}");
+                }
+
                 StreamNetwork* stream = new StreamNetwork(ctx, uri);
                 stream->initialize();
+                stream->setBatch(batchKb * 1024, lingerUs, zeroCopyKb * 1024);
                 writer = new WriterStream(ctx, std::string(alias) + "-writer", replicator2->database,
                                           replicator2->builder, replicator2->metadata, stream);
 #else
@@ -1013,9 +1172,14 @@ namespace OpenLogReplicator {
 
             writers.push_back(writer);
             writer->initialize();
-            ctx->spawnThread(writer);
         }
 
+        Ctx::memoryQuotaSet(nullptr);
+
+        // All writers of a source are registered before any of them starts
+        for (Writer* writer: writers)
+            ctx->spawnThread(writer);
+
         ctx->mainLoop();
 
         if (ctx->trace & Ctx::TRACE_THREADS) {
@@ -1027,6 +1191,131 @@ namespace OpenLogReplicator {
         return 0;
     }
 
+    uint64_t OpenLogReplicator::mainProcessMemory(const rapidjson::Value& parentJson) {
+        uint64_t memoryMinMb = 32;
+        uint64_t memoryMaxMb = 1024;
+        uint64_t readBufferMax = memoryMaxMb / 4 / Ctx::MEMORY_CHUNK_SIZE_MB;
+
+        // MEMORY
+        if (parentJson.HasMember("memory")) {
+            const rapidjson::Value& memoryJson = Ctx::getJsonFieldO(configFileName, parentJson, "memory");
+
+            if (!ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
+                static const char* memoryNames[] = {"min-mb", "max-mb", "read-buffer-max-mb", "swap-path", "swap-mb", "huge-pages",
+                                                     "numa-node", nullptr};
+                Ctx::checkJsonFields(configFileName, memoryJson, memoryNames);
+            }
+
+            if (memoryJson.HasMember("min-mb")) {
+                memoryMinMb = Ctx::getJsonFieldU64(configFileName, memoryJson, "min-mb");
+                memoryMinMb = (memoryMinMb / Ctx::MEMORY_CHUNK_SIZE_MB) * Ctx::MEMORY_CHUNK_SIZE_MB;
+                if (memoryMinMb < Ctx::MEMORY_CHUNK_MIN_MB)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"min-mb\" value: " + std::to_string(memoryMinMb) +
+                                                        ", expected: at least " + std::to_string(Ctx::MEMORY_CHUNK_MIN_MB));
+            }
+
+            if (memoryJson.HasMember("max-mb")) {
+                memoryMaxMb = Ctx::getJsonFieldU64(configFileName, memoryJson, "max-mb");
+                memoryMaxMb = (memoryMaxMb / Ctx::MEMORY_CHUNK_SIZE_MB) * Ctx::MEMORY_CHUNK_SIZE_MB;
+                if (memoryMaxMb < memoryMinMb)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"max-mb\" value: " + std::to_string(memoryMaxMb) +
+                                                        ", expected: at least like \"min-mb\" value (" + std::to_string(memoryMinMb) + ")");
+
+                readBufferMax = memoryMaxMb / 4 / Ctx::MEMORY_CHUNK_SIZE_MB;
+                if (readBufferMax > 32 / Ctx::MEMORY_CHUNK_SIZE_MB)
+                    readBufferMax = 32 / Ctx::MEMORY_CHUNK_SIZE_MB;
+            }
+
+            if (memoryJson.HasMember("read-buffer-max-mb")) {
+                readBufferMax = Ctx::getJsonFieldU64(configFileName, memoryJson, "read-buffer-max-mb") / Ctx::MEMORY_CHUNK_SIZE_MB;
+                if (readBufferMax * Ctx::MEMORY_CHUNK_SIZE_MB > memoryMaxMb)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"read-buffer-max-mb\" value: " +
+                                                        std::to_string(readBufferMax * Ctx::MEMORY_CHUNK_SIZE_MB) +
+                                                        ", expected: not greater than \"max-mb\" value (" + std::to_string(memoryMaxMb) + ")");
+                if (readBufferMax <= 1)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"read-buffer-max-mb\" value: " +
+                                                        std::to_string(readBufferMax) + ", expected: at least: " +
+                                                        std::to_string(Ctx::MEMORY_CHUNK_SIZE_MB * 2));
+            }
+
+            if (memoryJson.HasMember("swap-path")) {
+                ctx->swapPath = Ctx::getJsonFieldS(configFileName, MAX_PATH_LENGTH, memoryJson, "swap-path");
+                DIR* swapDir = opendir(ctx->swapPath.c_str());
+                if (swapDir == nullptr)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"swap-path\" value: " + ctx->swapPath +
+                                                        ", expected: existing directory");
+                closedir(swapDir);
+                ctx->swapMb = memoryMaxMb * 3 / 4;
+            }
+
+            if (memoryJson.HasMember("swap-mb")) {
+                ctx->swapMb = Ctx::getJsonFieldU64(configFileName, memoryJson, "swap-mb");
+                if (ctx->swapMb > memoryMaxMb)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"swap-mb\" value: " + std::to_string(ctx->swapMb) +
+                                                        ", expected: not greater than \"max-mb\" value (" + std::to_string(memoryMaxMb) + ")");
+            }
+
+            if (memoryJson.HasMember("huge-pages")) {
+                ctx->memoryHugePages = Ctx::getJsonFieldU64(configFileName, memoryJson, "huge-pages");
+                if (ctx->memoryHugePages > Ctx::MEMORY_HUGE_PAGES_1GB)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"huge-pages\" value: " + std::to_string(ctx->memoryHugePages) +
+                                                        ", expected: one of {0 .. 3}");
+            }
+
+            if (memoryJson.HasMember("numa-node")) {
+                uint64_t numaNode = Ctx::getJsonFieldU64(configFileName, memoryJson, "numa-node");
+                if (numaNode > Ctx::MEMORY_NUMA_NODE_MAX)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"numa-node\" value: " + std::to_string(numaNode) +
+                                                        ", expected: one of {0 .. " + std::to_string(Ctx::MEMORY_NUMA_NODE_MAX) + "}");
+                if (ctx->memoryHugePages == Ctx::MEMORY_HUGE_PAGES_NONE)
+                    throw ConfigurationException(30001, "bad JSON, invalid \"numa-node\" value: " + std::to_string(numaNode) +
+                                                        ", expected: not set when \"huge-pages\" is 0");
+                ctx->memoryNumaNode = static_cast<int64_t>(numaNode);
+            }
+        }
+
+        ctx->initialize(memoryMinMb, memoryMaxMb, readBufferMax);
+        return memoryMaxMb;
+    }
+
+    // Parameters kept in the context are shared by all sources, a source can't override the value set by another one
+    void OpenLogReplicator::mainProcessShared(const rapidjson::Value& firstSourceJson, const rapidjson::Value& sourceJson, const char* alias) const {
+        static const char* sourceNames[] = {"flags", "transaction-max-mb", "redo-read-sleep-us", "arch-read-sleep-us", "arch-read-tries",
+                                            "arch-prefetch", "redo-read-queue-depth", "redo-verify-delay-us", "refresh-interval-us", nullptr};
+        static const char* readerNames[] = {"disable-checks", "redo-copy-path", "db-timezone", "host-timezone", "log-timezone", nullptr};
+        static const char* stateNames[] = {"interval-s", "interval-mb", "keep-checkpoints", "schema-force-interval", "schema-delta-max",
+                                           nullptr};
+        static const char* debugNames[] = {"stop-log-switches", "stop-checkpoints", "stop-transactions", nullptr};
+
+        mainProcessSharedFields(&firstSourceJson, &sourceJson, sourceNames, alias);
+        for (const auto& [element, names]: {std::make_pair("reader", readerNames), std::make_pair("state", stateNames),
+                                            std::make_pair("debug", debugNames)}) {
+            const rapidjson::Value* firstJson = nullptr;
+            if (firstSourceJson.HasMember(element))
+                firstJson = &firstSourceJson[element];
+            const rapidjson::Value* json = nullptr;
+            if (sourceJson.HasMember(element))
+                json = &sourceJson[element];
+            mainProcessSharedFields(firstJson, json, names, alias);
+        }
+    }
+
+    void OpenLogReplicator::mainProcessSharedFields(const rapidjson::Value* firstJson, const rapidjson::Value* json, const char* names[],
+                                                    const char* alias) const {
+        if (firstJson != nullptr && !firstJson->IsObject())
+            firstJson = nullptr;
+        if (json != nullptr && !json->IsObject())
+            json = nullptr;
+
+        for (uint64_t i = 0; names[i] != nullptr; ++i) {
+            bool firstHas = firstJson != nullptr && firstJson->HasMember(names[i]);
+            bool has = json != nullptr && json->HasMember(names[i]);
+            if (firstHas != has || (has && (*firstJson)[names[i]] != (*json)[names[i]]))
+                throw ConfigurationException(30001, "bad JSON, invalid \"" + std::string(names[i]) + "\" value for source: " + alias +
+                                                    ", expected: the same as for the first source, the parameter is shared by all sources");
+        }
+    }
+
     void OpenLogReplicator::mainProcessMapping(const rapidjson::Value& readerJson) {
         if (readerJson.HasMember("path-mapping")) {
             const rapidjson::Value& pathMappingArrayJson = Ctx::getJsonFieldA(configFileName, readerJson, "path-mapping");
@@ -26,10 +26,12 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     class Builder;
+    class BuilderPool;
     class Ctx;
     class Checkpoint;
     class Locales;
     class Metadata;
+    class ParserPool;
     class Replicator;
     class TransactionBuffer;
     class Writer;
@@ -40,7 +42,9 @@ namespace OpenLogReplicator {
         std::vector<Checkpoint*> checkpoints;
         std::vector<Locales*> localess;
         std::vector<Builder*> builders;
+        std::vector<BuilderPool*> builderPools;
         std::vector<Metadata*> metadatas;
+        std::vector<ParserPool*> parserPools;
         std::vector<TransactionBuffer*> transactionBuffers;
         std::vector<Writer*> writers;
         Replicator* replicator;
@@ -49,6 +53,9 @@ namespace OpenLogReplicator {
         std::string configFileName;
         Ctx* ctx;
 
+        uint64_t mainProcessMemory(const rapidjson::Value& parentJson);
+        void mainProcessShared(const rapidjson::Value& firstSourceJson, const rapidjson::Value& sourceJson, const char* alias) const;
+        void mainProcessSharedFields(const rapidjson::Value* firstJson, const rapidjson::Value* json, const char* names[], const char* alias) const;
         void mainProcessMapping(const rapidjson::Value& readerJson);
 
     public:
@@ -29,6 +29,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "../metadata/Metadata.h"
 #include "../metadata/Schema.h"
 #include "Builder.h"
+#include "BuilderPool.h"
 #include "SystemTransaction.h"
 
 namespace OpenLogReplicator {
@@ -36,7 +37,7 @@ namespace OpenLogReplicator {
                      uint64_t newIntervalDtsFormat, uint64_t newIntervalYtmFormat, uint64_t newMessageFormat, uint64_t newRidFormat, uint64_t newXidFormat,
                      uint64_t newTimestampFormat, uint64_t newTimestampTzFormat, uint64_t newTimestampAll, uint64_t newCharFormat, uint64_t newScnFormat,
                      uint64_t newScnAll, uint64_t newUnknownFormat, uint64_t newSchemaFormat, uint64_t newColumnFormat, uint64_t newUnknownType,
-                     uint64_t newFlushBuffer) :
+                     uint64_t newLobFormat, uint64_t newFlushBuffer) :
             ctx(newCtx),
             locales(newLocales),
             metadata(newMetadata),
@@ -58,6 +59,7 @@ namespace OpenLogReplicator {
             schemaFormat(newSchemaFormat),
             columnFormat(newColumnFormat),
             unknownType(newUnknownType),
+            lobFormat(newLobFormat),
             unconfirmedLength(0),
             messageLength(0),
             messagePosition(0),
@@ -78,7 +80,11 @@ namespace OpenLogReplicator {
             compressedBefore(false),
             compressedAfter(false),
             prevCharsSize(0),
+            lobCollect(false),
             systemTransaction(nullptr),
+            pool(nullptr),
+            workerPool(nullptr),
+            workerTicket(0),
             buffersAllocated(0),
             firstBuilderQueue(nullptr),
             lastBuilderQueue(nullptr),
@@ -133,19 +139,20 @@ namespace OpenLogReplicator {
 
     void Builder::processValue(LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, typeCol col, const uint8_t* data, uint64_t length,
                                uint64_t offset, bool after, bool compressed) {
+        lobCollect = false;
         if (compressed) {
             std::string columnName("COMPRESSED");
-            columnRaw(columnName, data, length);
+            columnRaw(nullptr, columnName, data, length);
             return;
         }
         if (table == nullptr) {
             std::string columnName("COL_" + std::to_string(col));
-            columnRaw(columnName, data, length);
+            columnRaw(nullptr, columnName, data, length);
             return;
         }
         OracleColumn* column = table->columns[col];
         if (ctx->flagsSet(Ctx::REDO_FLAGS_RAW_COLUMN_DATA)) {
-            columnRaw(column->name, data, length);
+            columnRaw(column, column->name, data, length);
             return;
         }
         if (column->guard && !ctx->flagsSet(Ctx::REDO_FLAGS_SHOW_GUARD_COLUMNS))
@@ -175,44 +182,52 @@ namespace OpenLogReplicator {
             case SysCol::TYPE_VARCHAR:
             case SysCol::TYPE_CHAR:
                 parseString(data, length, column->charsetId, offset, false, false, false, table->systemTable > 0);
-                columnString(column->name);
+                columnString(column, column->name);
                 break;
 
             case SysCol::TYPE_NUMBER:
                 parseNumber(data, length, offset);
-                columnNumber(column->name, column->precision, column->scale);
+                columnNumber(column, column->name, column->precision, column->scale);
                 break;
 
             case SysCol::TYPE_BLOB:
                 if (after) {
-                    if (parseLob(lobCtx, data, length, 0, table->obj, offset, false, table->sys)) {
+                    // XMLTYPE is decoded from the whole value
+                    if (lobFormat == LOB_FORMAT_STREAM && !(column->xmlType && ctx->flagsSet(Ctx::REDO_FLAGS_EXPERIMENTAL_XMLTYPE)))
+                        parseLobStream(lobCtx, data, length, 0, table->obj, offset, false, table->sys, column, column->name);
+                    else if (parseLob(lobCtx, data, length, 0, table->obj, offset, false, table->sys)) {
                         if (column->xmlType && ctx->flagsSet(Ctx::REDO_FLAGS_EXPERIMENTAL_XMLTYPE)) {
                             if (parseXml(xmlCtx, reinterpret_cast<uint8_t*>(valueBuffer), valueLength, offset))
-                                columnString(column->name);
+                                columnString(column, column->name);
                             else
-                                columnRaw(column->name, reinterpret_cast<uint8_t*>(valueBufferOld), valueLengthOld);
+                                columnRaw(column, column->name, reinterpret_cast<uint8_t*>(valueBufferOld), valueLengthOld);
                         } else
-                            columnRaw(column->name, reinterpret_cast<uint8_t*>(valueBuffer), valueLength);
+                            columnRaw(column, column->name, reinterpret_cast<uint8_t*>(valueBuffer), valueLength);
                     }
                 }
                 break;
 
             case SysCol::TYPE_JSON:
-                if (ctx->flagsSet(Ctx::REDO_FLAGS_EXPERIMENTAL_JSON))
-                    if (parseLob(lobCtx, data, length, 0, table->obj, offset, false, table->sys))
-                        columnRaw(column->name, reinterpret_cast<uint8_t*>(valueBuffer), valueLength);
+                if (ctx->flagsSet(Ctx::REDO_FLAGS_EXPERIMENTAL_JSON)) {
+                    if (lobFormat == LOB_FORMAT_STREAM)
+                        parseLobStream(lobCtx, data, length, 0, table->obj, offset, false, table->sys, column, column->name);
+                    else if (parseLob(lobCtx, data, length, 0, table->obj, offset, false, table->sys))
+                        columnRaw(column, column->name, reinterpret_cast<uint8_t*>(valueBuffer), valueLength);
+                }
                 break;
 
             case SysCol::TYPE_CLOB:
                 if (after) {
-                    if (parseLob(lobCtx, data, length, column->charsetId, table->obj, offset, true, table->systemTable > 0))
-                        columnString(column->name);
+                    if (lobFormat == LOB_FORMAT_STREAM)
+                        parseLobStream(lobCtx, data, length, column->charsetId, table->obj, offset, true, table->systemTable > 0, column, column->name);
+                    else if (parseLob(lobCtx, data, length, column->charsetId, table->obj, offset, true, table->systemTable > 0))
+                        columnString(column, column->name);
                 }
                 break;
 
             case SysCol::TYPE_TIMESTAMP_WITH_LOCAL_TZ:
                 if (length != 7 && length != 11)
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 else {
                     int64_t year;
                     int64_t month = data[2] - 1;    // 0..11
@@ -241,14 +256,14 @@ namespace OpenLogReplicator {
 
                     if (second < 0 || second > 59 || minute < 0 || minute > 59 || hour < 0 || hour > 23 || day < 0 || day > 30 || month < 0 || month > 11 ||
                             fraction > 999999999) {
-                        columnUnknown(column->name, data, length);
+                        columnUnknown(column, column->name, data, length);
                     } else {
                         time_t timestamp = ctx->valuesToEpoch(year, month, day, hour, minute, second, metadata->dbTimezone);
                         if (year < 0 && fraction > 0) {
                             fraction = 1000000000 - fraction;
                             --timestamp;
                         }
-                        columnTimestamp(column->name, timestamp, fraction);
+                        columnTimestamp(column, column->name, timestamp, fraction);
                     }
                 }
                 break;
@@ -256,7 +271,7 @@ namespace OpenLogReplicator {
             case SysCol::TYPE_DATE:
             case SysCol::TYPE_TIMESTAMP:
                 if (length != 7 && length != 11)
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 else {
                     int64_t year;
                     int64_t month = data[2] - 1;    // 0..11
@@ -285,39 +300,39 @@ namespace OpenLogReplicator {
 
                     if (second < 0 || second > 59 || minute < 0 || minute > 59 || hour < 0 || hour > 23 || day < 0 || day > 30 || month < 0 || month > 11 ||
                             fraction > 999999999) {
-                        columnUnknown(column->name, data, length);
+                        columnUnknown(column, column->name, data, length);
                     } else {
                         time_t timestamp = ctx->valuesToEpoch(year, month, day, hour, minute, second, 0);
                         if (year < 0 && fraction > 0) {
                             fraction = 1000000000 - fraction;
                             --timestamp;
                         }
-                        columnTimestamp(column->name, timestamp, fraction);
+                        columnTimestamp(column, column->name, timestamp, fraction);
                     }
                 }
                 break;
 
             case SysCol::TYPE_RAW:
-                columnRaw(column->name, data, length);
+                columnRaw(column, column->name, data, length);
                 break;
 
             case SysCol::TYPE_FLOAT:
                 if (length == 4)
-                    columnFloat(column->name, decodeFloat(data));
+                    columnFloat(column, column->name, decodeFloat(data));
                 else
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 break;
 
             case SysCol::TYPE_DOUBLE:
                 if (length == 8)
-                    columnDouble(column->name, decodeDouble(data));
+                    columnDouble(column, column->name, decodeDouble(data));
                 else
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 break;
 
             case SysCol::TYPE_TIMESTAMP_WITH_TZ:
                 if (length != 9 && length != 13) {
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 } else {
                     int64_t year;
                     int64_t month = data[2] - 1;    // 0..11
@@ -386,21 +401,21 @@ namespace OpenLogReplicator {
                     }
 
                     if (second < 0 || second > 59 || minute < 0 || minute > 59 || hour < 0 || hour > 23 || day < 0 || day > 30 || month < 0 || month > 11) {
-                        columnUnknown(column->name, data, length);
+                        columnUnknown(column, column->name, data, length);
                     } else {
                         time_t timestamp = ctx->valuesToEpoch(year, month, day, hour, minute, second, 0);
                         if (year < 0 && fraction > 0) {
                             fraction = 1000000000 - fraction;
                             --timestamp;
                         }
-                        columnTimestampTz(column->name, timestamp, fraction, tz);
+                        columnTimestampTz(column, column->name, timestamp, fraction, tz);
                     }
                 }
                 break;
 
             case SysCol::TYPE_INTERVAL_YEAR_TO_MONTH:
                 if (length != 5 || data[4] < 49 || data[4] > 71)
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 else {
                     bool minus = false;
                     uint64_t year;
@@ -412,7 +427,7 @@ namespace OpenLogReplicator {
                     }
 
                     if (year > 999999999)
-                        columnUnknown(column->name, data, length);
+                        columnUnknown(column, column->name, data, length);
                     else {
                         uint64_t month;
                         if (data[4] >= 60)
@@ -443,9 +458,9 @@ namespace OpenLogReplicator {
                             }
 
                             if (intervalYtmFormat == INTERVAL_YTM_FORMAT_MONTHS)
-                                columnNumber(column->name, 17, 0);
+                                columnNumber(column, column->name, 17, 0);
                             else
-                                columnString(column->name);
+                                columnString(column, column->name);
                         } else {
                             uint64_t val = year;
                             if (val == 0) {
@@ -472,7 +487,7 @@ namespace OpenLogReplicator {
                             } else
                                 valueBuffer[valueLength++] = Ctx::map10(month);
 
-                            columnString(column->name);
+                            columnString(column, column->name);
                         }
                     }
                 }
@@ -480,7 +495,7 @@ namespace OpenLogReplicator {
 
             case SysCol::TYPE_INTERVAL_DAY_TO_SECOND:
                 if (length != 11 || data[4] < 37 || data[4] > 83 || data[5] < 1 || data[5] > 119 || data[6] < 1 || data[6] > 119)
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 else {
                     bool minus = false;
                     uint64_t day;
@@ -500,7 +515,7 @@ namespace OpenLogReplicator {
                     }
 
                     if (day > 999999999 || us > 999999999)
-                        columnUnknown(column->name, data, length);
+                        columnUnknown(column, column->name, data, length);
                     else {
                         int64_t hour;
                         if (data[4] >= 60)
@@ -572,7 +587,7 @@ namespace OpenLogReplicator {
                             }
                             valueLength += 9;
 
-                            columnString(column->name);
+                            columnString(column, column->name);
                         } else {
                             switch (intervalDtsFormat) {
                                 case INTERVAL_DTS_FORMAT_UNIX_NANO:
@@ -611,14 +626,14 @@ namespace OpenLogReplicator {
                                 case INTERVAL_DTS_FORMAT_UNIX_MICRO:
                                 case INTERVAL_DTS_FORMAT_UNIX_MILLI:
                                 case INTERVAL_DTS_FORMAT_UNIX:
-                                    columnNumber(column->name, 17, 0);
+                                    columnNumber(column, column->name, 17, 0);
                                     break;
 
                                 case INTERVAL_DTS_FORMAT_UNIX_NANO_STRING:
                                 case INTERVAL_DTS_FORMAT_UNIX_MICRO_STRING:
                                 case INTERVAL_DTS_FORMAT_UNIX_MILLI_STRING:
                                 case INTERVAL_DTS_FORMAT_UNIX_STRING:
-                                    columnString(column->name);
+                                    columnString(column, column->name);
                             }
                         }
                     }
@@ -629,9 +644,9 @@ namespace OpenLogReplicator {
                 if (length == 1 && data[0] <= 1) {
                     valueLength = 0;
                     valueBuffer[valueLength++] = Ctx::map10(data[0]);
-                    columnNumber(column->name, column->precision, column->scale);
+                    columnNumber(column, column->name, column->precision, column->scale);
                 } else {
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 }
                 break;
 
@@ -639,15 +654,15 @@ namespace OpenLogReplicator {
                 if (length == 13 && data[0] == 0x01) {
                     typeRowId rowId;
                     rowId.decodeFromHex(data + 1);
-                    columnRowId(column->name, rowId);
+                    columnRowId(column, column->name, rowId);
                 } else {
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
                 }
                 break;
 
             default:
                 if (unknownType == UNKNOWN_TYPE_SHOW)
-                    columnUnknown(column->name, data, length);
+                    columnUnknown(column, column->name, data, length);
         }
     }
 
@@ -723,6 +738,8 @@ namespace OpenLogReplicator {
 
     void Builder::setMaxMessageMb(uint64_t maxMessageMb_) {
         maxMessageMb = maxMessageMb_;
+        if (pool != nullptr)
+            pool->setMaxMessageMb(maxMessageMb_);
     }
 
     void Builder::processBegin(typeXid xid, typeScn scn, typeScn newLwnScn, const std::unordered_map<std::string, std::string>* newAttributes) {
@@ -809,18 +826,18 @@ namespace OpenLogReplicator {
                               redoLogRecord1->dataOffset);
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsInsertOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsInsertOut(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsInsertOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsInsertOut(1, table);
                     else
                         ctx->metrics->emitDmlOpsInsertOut(1);
                 }
             } else {
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsInsertSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsInsertSkip(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsInsertSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsInsertSkip(1, table);
                     else
                         ctx->metrics->emitDmlOpsInsertSkip(1);
                 }
@@ -901,18 +918,18 @@ namespace OpenLogReplicator {
                               redoLogRecord1->dataOffset);
                 if (ctx->metrics) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsDeleteOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsDeleteOut(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsDeleteOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsDeleteOut(1, table);
                     else
                         ctx->metrics->emitDmlOpsDeleteOut(1);
                 }
             } else {
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsDeleteSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsDeleteSkip(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsDeleteSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsDeleteSkip(1, table);
                     else
                         ctx->metrics->emitDmlOpsDeleteSkip(1);
                 }
@@ -1537,18 +1554,18 @@ namespace OpenLogReplicator {
                 processUpdate(scn, sequence, timestamp, lobCtx, xmlCtx, table, obj, dataObj, bdba, slot, redoLogRecord1->xid, redoLogRecord1->dataOffset);
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsUpdateOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsUpdateOut(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsUpdateOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsUpdateOut(1, table);
                     else
                         ctx->metrics->emitDmlOpsUpdateOut(1);
                 }
             } else {
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsUpdateSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsUpdateSkip(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsUpdateSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsUpdateSkip(1, table);
                     else
                         ctx->metrics->emitDmlOpsUpdateSkip(1);
                 }
@@ -1618,18 +1635,18 @@ namespace OpenLogReplicator {
                 processInsert(scn, sequence, timestamp, lobCtx, xmlCtx, table, obj, dataObj, bdba, slot, redoLogRecord1->xid, redoLogRecord1->dataOffset);
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsInsertOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsInsertOut(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsInsertOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsInsertOut(1, table);
                     else
                         ctx->metrics->emitDmlOpsInsertOut(1);
                 }
             } else {
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsInsertSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsInsertSkip(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsInsertSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsInsertSkip(1, table);
                     else
                         ctx->metrics->emitDmlOpsInsertSkip(1);
                 }
@@ -1695,18 +1712,18 @@ namespace OpenLogReplicator {
                 processDelete(scn, sequence, timestamp, lobCtx, xmlCtx, table, obj, dataObj, bdba, slot, redoLogRecord1->xid, redoLogRecord1->dataOffset);
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsDeleteOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsDeleteOut(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsDeleteOut(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsDeleteOut(1, table);
                     else
                         ctx->metrics->emitDmlOpsDeleteOut(1);
                 }
             } else {
                 if (ctx->metrics != nullptr) {
                     if (ctx->metrics->isTagNamesFilter() && table != nullptr && (table->options & (OPTIONS_SYSTEM_TABLE | OPTIONS_DEBUG_TABLE)) == 0)
-                        ctx->metrics->emitDmlOpsDeleteSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsDeleteSkip(1, table);
                     else if (ctx->metrics->isTagNamesSys() && table != nullptr && (table->options & OPTIONS_SYSTEM_TABLE) != 0)
-                        ctx->metrics->emitDmlOpsDeleteSkip(1, table->owner, table->name);
+                        ctx->metrics->emitDmlOpsDeleteSkip(1, table);
                     else
                         ctx->metrics->emitDmlOpsDeleteSkip(1);
                 }
@@ -1721,7 +1738,7 @@ namespace OpenLogReplicator {
         uint64_t fieldPos = 0;
         typeField fieldNum = 0;
         uint16_t fieldLength = 0;
-        const OracleTable* table = metadata->schema->checkTableDict(redoLogRecord1->obj);
+        OracleTable* table = metadata->schema->checkTableDict(redoLogRecord1->obj);
         if ((scnFormat & SCN_ALL_COMMIT_VALUE) != 0)
             scn = commitScn;
 
@@ -2311,10 +2328,24 @@ namespace OpenLogReplicator {
         return true;
     }
 
-    void Builder::releaseBuffers(uint64_t maxId) {
+    uint64_t Builder::registerWriter() {
+        std::unique_lock<std::mutex> lck(mtx);
+        writersQueueId.push_back(0);
+        return writersQueueId.size() - 1;
+    }
+
+    void Builder::releaseBuffers(uint64_t writer, uint64_t maxId) {
         BuilderQueue* builderQueue;
         {
             std::unique_lock<std::mutex> lck(mtx);
+            if (writersQueueId[writer] < maxId)
+                writersQueueId[writer] = maxId;
+
+            // Release only the buffers confirmed by all writers
+            for (uint64_t queueId: writersQueueId)
+                if (queueId < maxId)
+                    maxId = queueId;
+
             builderQueue = firstBuilderQueue;
             while (firstBuilderQueue->id < maxId) {
                 firstBuilderQueue = firstBuilderQueue->next;
@@ -2331,6 +2362,107 @@ namespace OpenLogReplicator {
         }
     }
 
+    void Builder::mergeQueue(Builder* source) {
+        // Copy all complete messages of the source queue to the end of this queue, renumbering them in the order of appearance
+        BuilderQueue* sourceQueue = source->firstBuilderQueue;
+        uint64_t sourcePos = 0;
+
+        while (sourceQueue != nullptr) {
+            if (sourcePos >= sourceQueue->length) {
+                sourceQueue = sourceQueue->next;
+                sourcePos = 0;
+                continue;
+            }
+
+            auto sourceMsg = reinterpret_cast<BuilderMsg*>(sourceQueue->data + sourcePos);
+            if (sourceMsg->length == 0)
+                break;
+            sourcePos += sizeof(struct BuilderMsg);
+
+            messageLength = 0;
+            messagePosition = 0;
+            if (lastBuilderQueue->length + sizeof(struct BuilderMsg) >= OUTPUT_BUFFER_DATA_SIZE)
+                builderRotate(true);
+
+            if (lwnScn != sourceMsg->lwnScn) {
+                lwnScn = sourceMsg->lwnScn;
+                lwnIdx = 0;
+            }
+
+            msg = reinterpret_cast<BuilderMsg*>(lastBuilderQueue->data + lastBuilderQueue->length);
+            builderShiftFast(sizeof(struct BuilderMsg));
+            msg->scn = sourceMsg->scn;
+            msg->lwnScn = lwnScn;
+            msg->lwnIdx = lwnIdx++;
+            msg->sequence = sourceMsg->sequence;
+            msg->length = 0;
+            msg->id = id++;
+            msg->obj = sourceMsg->obj;
+            msg->pos = sourceMsg->pos;
+            msg->flags = sourceMsg->flags;
+            msg->data = lastBuilderQueue->data + lastBuilderQueue->length + sizeof(struct BuilderMsg);
+
+            uint64_t left = sourceMsg->length;
+            while (left > 0) {
+                // The message might be split between many source buffers
+                uint64_t length = sourceQueue->length - sourcePos;
+                if (length > left)
+                    length = left;
+                const uint8_t* data = sourceQueue->data + sourcePos;
+                left -= length;
+                if (left > 0) {
+                    sourceQueue = sourceQueue->next;
+                    sourcePos = 0;
+                } else
+                    sourcePos += (length + 7) & 0xFFFFFFFFFFFFFFF8;
+
+                while (length > 0) {
+                    uint64_t free = OUTPUT_BUFFER_DATA_SIZE - lastBuilderQueue->length - messagePosition;
+                    if (length < free) {
+                        memcpy(reinterpret_cast<void*>(lastBuilderQueue->data + lastBuilderQueue->length + messagePosition),
+                               reinterpret_cast<const void*>(data), length);
+                        messagePosition += length;
+                        break;
+                    }
+
+                    memcpy(reinterpret_cast<void*>(lastBuilderQueue->data + lastBuilderQueue->length + messagePosition),
+                           reinterpret_cast<const void*>(data), free);
+                    messagePosition += free;
+                    data += free;
+                    length -= free;
+                    builderRotate(true);
+                }
+            }
+
+            builderCommit(false);
+        }
+    }
+
+    void Builder::resetQueue() {
+        // Drop the content of the queue, keeping just the first buffer
+        std::unique_lock<std::mutex> lck(mtx);
+        BuilderQueue* builderQueue = firstBuilderQueue->next;
+        while (builderQueue != nullptr) {
+            BuilderQueue* nextBuffer = builderQueue->next;
+            ctx->freeMemoryChunk(Ctx::MEMORY_MODULE_BUILDER, reinterpret_cast<uint8_t*>(builderQueue), true);
+            builderQueue = nextBuffer;
+            --buffersAllocated;
+        }
+        firstBuilderQueue->next = nullptr;
+
+        firstBuilderQueue->length = 0;
+        firstBuilderQueue->start = 0;
+        lastBuilderQueue = firstBuilderQueue;
+        msg = nullptr;
+        messageLength = 0;
+        messagePosition = 0;
+        unconfirmedLength = 0;
+    }
+
+    void Builder::workerHandOver() {
+        workerPool->handOver(this, workerTicket);
+    }
+
     void Builder::sleepForWriterWork(uint64_t queueSize, uint64_t nanoseconds) {
         if (ctx->trace & Ctx::TRACE_SLEEP)
             ctx->logTrace(Ctx::TRACE_SLEEP, "Builder:sleepForWriterWork");
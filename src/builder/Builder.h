@@ -24,11 +24,13 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "../common/Ctx.h"
 #include "../common/LobCtx.h"
 #include "../common/LobData.h"
 #include "../common/LobKey.h"
+#include "../common/LobPool.h"
 #include "../common/RedoLogRecord.h"
 #include "../common/types.h"
 #include "../common/typeLobId.h"
@@ -65,8 +67,10 @@ namespace OpenLogReplicator {
     class Ctx;
     class CharacterSet;
     class Locales;
+    class OracleColumn;
     class OracleTable;
     class Builder;
+    class BuilderPool;
     class Metadata;
     class SystemTransaction;
     class XmlCtx;
@@ -94,6 +98,15 @@ namespace OpenLogReplicator {
         uint16_t flags;
     };
 
+    // Part of LOB value found by parseLob(), decoded later when the value is streamed to output
+    struct BuilderLobSegment {
+        const uint8_t* data;
+        uint64_t length;
+        bool appendData;
+        bool hasPrev;
+        bool hasNext;
+    };
+
     class Builder {
     protected:
         Ctx* ctx;
@@ -118,6 +131,7 @@ namespace OpenLogReplicator {
         uint64_t schemaFormat;
         uint64_t columnFormat;
         uint64_t unknownType;
+        uint64_t lobFormat;
         uint64_t unconfirmedLength;
         uint64_t messageLength;
         uint64_t messagePosition;
@@ -147,10 +161,14 @@ namespace OpenLogReplicator {
         bool compressedAfter;
         uint8_t prevChars[MAX_CHARACTER_LENGTH * 2];
         uint64_t prevCharsSize;
+        std::vector<BuilderLobSegment> lobSegments;
+        bool lobCollect;
         const std::unordered_map<std::string, std::string>* attributes;
 
         std::mutex mtx;
         std::condition_variable condNoWriterWork;
+        // Queue id confirmed by every writer consuming this builder
+        std::vector<uint64_t> writersQueueId;
 
         double decodeFloat(const uint8_t* data);
         long double decodeDouble(const uint8_t* data);
@@ -315,6 +333,10 @@ namespace OpenLogReplicator {
                 unconfirmedLength = 0;
             }
             msg = nullptr;
+
+            // Builder pool thread, pass the finished messages on when possible
+            if (workerPool != nullptr)
+                workerHandOver();
         };
 
         void append(char character) {
@@ -346,10 +368,10 @@ namespace OpenLogReplicator {
             }
         };
 
-        inline void columnUnknown(const std::string& columnName, const uint8_t* data, uint64_t length) {
+        inline void columnUnknown(const OracleColumn* column, const std::string& columnName, const uint8_t* data, uint64_t length) {
             valueBuffer[0] = '?';
             valueLength = 1;
-            columnString(columnName);
+            columnString(column, columnName);
             if (unknownFormat == UNKNOWN_FORMAT_DUMP) {
                 std::ostringstream ss;
                 for (uint64_t j = 0; j < length; ++j)
@@ -520,6 +542,11 @@ namespace OpenLogReplicator {
 
         inline void addLobToOutput(const uint8_t* data, uint64_t length, uint64_t charsetId, uint64_t offset, bool appendData, bool isClob, bool hasPrev,
                             bool hasNext, bool isSystem) {
+            if (lobCollect) {
+                lobSegments.push_back({data, length, appendData, hasPrev, hasNext});
+                return;
+            }
+
             if (isClob) {
                 parseString(data, length, charsetId, offset, appendData, hasPrev, hasNext, isSystem);
             } else {
@@ -554,20 +581,21 @@ namespace OpenLogReplicator {
                     return true;
                 }
                 LobData* lobData = lobsIt->second;
-                valueBufferCheck(static_cast<uint64_t>(lobData->pageSize) * static_cast<uint64_t>(lobData->sizePages) + lobData->sizeRest, offset);
+                if (!lobCollect)
+                    valueBufferCheck(static_cast<uint64_t>(lobData->pageSize) * static_cast<uint64_t>(lobData->sizePages) + lobData->sizeRest, offset);
 
                 uint32_t pageNo = 0;
-                for (auto indexMapIt: lobData->indexMap) {
-                    uint32_t pageNoLob = indexMapIt.first;
-                    typeDba page = indexMapIt.second;
+                for (auto indexIt: lobData->indexList) {
+                    uint32_t pageNoLob = indexIt.first;
+                    typeDba page = indexIt.second;
                     if (pageNo != pageNoLob) {
                         ctx->warning(60003, "incorrect LOB for xid: " + lastXid.toString() + ", data:" + dumpLob(data, length) + ", location: 2");
                         pageNo = pageNoLob;
                     }
 
                     LobDataElement element(page, 0);
-                    auto dataMapIt = lobData->dataMap.find(element);
-                    if (dataMapIt == lobData->dataMap.end()) {
+                    auto dataIt = lobData->dataFind(element);
+                    if (dataIt == lobData->dataList.end()) {
                         if (ctx->trace & Ctx::TRACE_LOB_DATA)
                             ctx->logTrace(Ctx::TRACE_LOB_DATA, "missing LOB (in-index) for xid: " + lastXid.toString() + " LOB: " +
                                                                lobId.lower() + " page: " + std::to_string(page) + " obj: " + std::to_string(obj));
@@ -583,8 +611,7 @@ namespace OpenLogReplicator {
                         hasNext = false;
                     }
 
-                    RedoLogRecord* redoLogRecordLob = reinterpret_cast<RedoLogRecord*>(dataMapIt->second + sizeof(uint64_t));
-                    redoLogRecordLob->data = reinterpret_cast<uint8_t*>(dataMapIt->second + sizeof(uint64_t) + sizeof(RedoLogRecord));
+                    const RedoLogRecord* redoLogRecordLob = LobPool::getRedoLogRecord(dataIt->second);
 
                     valueBufferCheck(chunkLength * 4, offset);
                     addLobToOutput(redoLogRecordLob->data + redoLogRecordLob->lobData, chunkLength, charsetId, offset, appendData, isClob,
@@ -652,18 +679,18 @@ namespace OpenLogReplicator {
                             page = ctx->read32Big(data + dataOffset);
                         } else {
                             // Rest of data in LOB index
-                            auto indexMapIt = lobData->indexMap.find(j);
-                            if (indexMapIt == lobData->indexMap.end()) {
+                            auto indexIt = lobData->indexFind(j);
+                            if (indexIt == lobData->indexList.end()) {
                                 ctx->warning(60004, "can't find page " + std::to_string(j) + " for xid: " + lastXid.toString() + ", LOB: " +
                                                     lobId.lower() + ", obj: " + std::to_string(obj));
                                 break;
                             }
-                            page = indexMapIt->second;
+                            page = indexIt->second;
                         }
 
                         LobDataElement element(page, 0);
-                        auto dataMapIt = lobData->dataMap.find(element);
-                        if (dataMapIt == lobData->dataMap.end()) {
+                        auto dataIt = lobData->dataFind(element);
+                        if (dataIt == lobData->dataList.end()) {
                             if (ctx->trace & Ctx::TRACE_LOB_DATA) {
                                 ctx->logTrace(Ctx::TRACE_LOB_DATA, "missing LOB index (in-index) for xid: " + lastXid.toString() + " LOB: " +
                                                                    lobId.lower() + " page: " + std::to_string(page) + " obj: " + std::to_string(obj));
@@ -672,9 +699,8 @@ namespace OpenLogReplicator {
                             return false;
                         }
 
-                        while (dataMapIt != lobData->dataMap.end() && dataMapIt->first.dba == page) {
-                            RedoLogRecord* redoLogRecordLob = reinterpret_cast<RedoLogRecord*>(dataMapIt->second + sizeof(uint64_t));
-                            redoLogRecordLob->data = reinterpret_cast<uint8_t*>(dataMapIt->second + sizeof(uint64_t) + sizeof(RedoLogRecord));
+                        while (dataIt != lobData->dataList.end() && dataIt->first.dba == page) {
+                            const RedoLogRecord* redoLogRecordLob = LobPool::getRedoLogRecord(dataIt->second);
                             if (j < pageCnt)
                                 chunkLength = redoLogRecordLob->lobDataLength;
                             else
@@ -688,7 +714,7 @@ namespace OpenLogReplicator {
                             appendData = true;
                             hasPrev = true;
                             totalLobLength -= chunkLength;
-                            ++dataMapIt;
+                            ++dataIt;
                         }
 
                         ++page;
@@ -842,8 +868,8 @@ namespace OpenLogReplicator {
 
                                 for (uint64_t j = 0; j < pageCnt; ++j) {
                                     LobDataElement element(page, 0);
-                                    auto dataMapIt = lobData->dataMap.find(element);
-                                    if (dataMapIt == lobData->dataMap.end()) {
+                                    auto dataIt = lobData->dataFind(element);
+                                    if (dataIt == lobData->dataList.end()) {
                                         if (ctx->trace & Ctx::TRACE_LOB_DATA) {
                                             ctx->logTrace(Ctx::TRACE_LOB_DATA, "missing LOB data (new in-value) for xid: " + lastXid.toString() +
                                                                                " LOB: " + lobId.lower() + " page: " + std::to_string(page) + " obj: " +
@@ -853,9 +879,8 @@ namespace OpenLogReplicator {
                                         return false;
                                     }
 
-                                    while (dataMapIt != lobData->dataMap.end() && dataMapIt->first.dba == page) {
-                                        RedoLogRecord* redoLogRecordLob = reinterpret_cast<RedoLogRecord*>(dataMapIt->second + sizeof(uint64_t));
-                                        redoLogRecordLob->data = reinterpret_cast<uint8_t*>(dataMapIt->second + sizeof(uint64_t) + sizeof(RedoLogRecord));
+                                    while (dataIt != lobData->dataList.end() && dataIt->first.dba == page) {
+                                        const RedoLogRecord* redoLogRecordLob = LobPool::getRedoLogRecord(dataIt->second);
                                         chunkLength = redoLogRecordLob->lobDataLength;
                                         if (i == static_cast<uint64_t>(lobPages - 1) && j == static_cast<uint64_t>(pageCnt - 1))
                                             hasNext = false;
@@ -866,7 +891,7 @@ namespace OpenLogReplicator {
                                         appendData = true;
                                         hasPrev = true;
                                         totalLobLength -= chunkLength;
-                                        ++dataMapIt;
+                                        ++dataIt;
                                     }
                                     ++page;
                                 }
@@ -899,8 +924,8 @@ namespace OpenLogReplicator {
 
                                     for (uint64_t j = 0; j < pageCnt; ++j) {
                                         LobDataElement element(page, 0);
-                                        auto dataMapIt = lobData->dataMap.find(element);
-                                        if (dataMapIt == lobData->dataMap.end()) {
+                                        auto dataIt = lobData->dataFind(element);
+                                        if (dataIt == lobData->dataList.end()) {
                                             if (ctx->trace & Ctx::TRACE_LOB_DATA) {
                                                 ctx->logTrace(Ctx::TRACE_LOB_DATA, "missing LOB data (new in-value 12+) for xid: " +
                                                                                    lastXid.toString() + " LOB: " + lobId.lower() + " page: " + std::to_string(page) +
@@ -911,8 +936,7 @@ namespace OpenLogReplicator {
                                             return false;
                                         }
 
-                                        RedoLogRecord* redoLogRecordLob = reinterpret_cast<RedoLogRecord*>(dataMapIt->second + sizeof(uint64_t));
-                                        redoLogRecordLob->data = reinterpret_cast<uint8_t*>(dataMapIt->second + sizeof(uint64_t) + sizeof(RedoLogRecord));
+                                        const RedoLogRecord* redoLogRecordLob = LobPool::getRedoLogRecord(dataIt->second);
                                         chunkLength = redoLogRecordLob->lobDataLength;
                                         if (listPage == 0 && i == static_cast<uint64_t>(aSiz - 1) && j == static_cast<uint64_t>(pageCnt - 1))
                                             hasNext = false;
@@ -984,16 +1008,15 @@ namespace OpenLogReplicator {
 
                             for (uint64_t j = 0; j < pageCnt; ++j) {
                                 LobDataElement element(page, 0);
-                                auto dataMapIt = lobData->dataMap.find(element);
-                                if (dataMapIt == lobData->dataMap.end()) {
+                                auto dataIt = lobData->dataFind(element);
+                                if (dataIt == lobData->dataList.end()) {
                                     ctx->warning(60005, "missing LOB data (new in-value) for xid: " + lastXid.toString() + ", LOB: " +
                                                         lobId.lower() + ", page: " + std::to_string(page) + ", obj: " + std::to_string(obj));
                                     ctx->warning(60006, "dump LOB: " + lobId.lower() + " data: " + dumpLob(data, length));
                                     return false;
                                 }
 
-                                RedoLogRecord* redoLogRecordLob = reinterpret_cast<RedoLogRecord*>(dataMapIt->second + sizeof(uint64_t));
-                                redoLogRecordLob->data = reinterpret_cast<uint8_t*>(dataMapIt->second + sizeof(uint64_t) + sizeof(RedoLogRecord));
+                                const RedoLogRecord* redoLogRecordLob = LobPool::getRedoLogRecord(dataIt->second);
                                 chunkLength = redoLogRecordLob->lobDataLength;
                                 if (i == static_cast<uint64_t>(lobPages - 1) && j == static_cast<uint64_t>(pageCnt - 1))
                                     hasNext = false;
@@ -1021,6 +1044,31 @@ namespace OpenLogReplicator {
             return true;
         }
 
+        // Output LOB value in parts, the value is decoded page by page, so valueBuffer doesn't grow to the size of the LOB
+        inline void parseLobStream(LobCtx* lobCtx, const uint8_t* data, uint64_t length, uint64_t charsetId, typeObj obj, uint64_t offset, bool isClob,
+                                   bool isSystem, const OracleColumn* column, const std::string& columnName) {
+            // Find all pages first, once the output is started the value can't be withdrawn
+            lobSegments.clear();
+            lobCollect = true;
+            bool found = parseLob(lobCtx, data, length, charsetId, obj, offset, isClob, isSystem);
+            lobCollect = false;
+            if (!found)
+                return;
+
+            columnLobBegin(column, columnName, isClob);
+            valueBufferPurge();
+            for (const auto& segment: lobSegments) {
+                valueBufferCheck(segment.length * 4, offset);
+                addLobToOutput(segment.data, segment.length, charsetId, offset, segment.appendData, isClob, segment.hasPrev, segment.hasNext, isSystem);
+                if (valueLength > 0) {
+                    columnLobAppend(isClob);
+                    valueLength = 0;
+                }
+            }
+            columnLobEnd(isClob);
+            lobSegments.clear();
+        }
+
         inline void parseRaw(const uint8_t* data, uint64_t length, uint64_t offset) {
             valueBufferPurge();
             valueBufferCheck(length * 2, offset);
@@ -1075,6 +1123,14 @@ namespace OpenLogReplicator {
                     overlap = 0;
                 }
 
+                // Convert as much as possible in one pass, decode() is left for multibyte tails and bad characters
+                if (overlap == 0 && (charFormat & CHAR_FORMAT_NOMAPPING) == 0 && ((charFormat & CHAR_FORMAT_HEX) == 0 || isSystem)) {
+                    uint64_t parsedLength = parseLength;
+                    valueLength += characterSet->decodeBulk(parseData, parseLength, reinterpret_cast<uint8_t*>(valueBuffer + valueLength));
+                    if (parseLength != parsedLength)
+                        continue;
+                }
+
                 typeUnicode unicodeCharacter;
 
                 if ((charFormat & CHAR_FORMAT_NOMAPPING) == 0) {
@@ -1175,14 +1231,18 @@ namespace OpenLogReplicator {
             valueBufferLength = VALUE_BUFFER_MIN;
         };
 
-        virtual void columnFloat(const std::string& columnName, double value) = 0;
-        virtual void columnDouble(const std::string& columnName, long double value) = 0;
-        virtual void columnString(const std::string& columnName) = 0;
-        virtual void columnNumber(const std::string& columnName, uint64_t precision, uint64_t scale) = 0;
-        virtual void columnRaw(const std::string& columnName, const uint8_t* data, uint64_t length) = 0;
-        virtual void columnRowId(const std::string& columnName, typeRowId rowId) = 0;
-        virtual void columnTimestamp(const std::string& columnName, time_t timestamp, uint64_t fraction) = 0;
-        virtual void columnTimestampTz(const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) = 0;
+        virtual void columnFloat(const OracleColumn* column, const std::string& columnName, double value) = 0;
+        virtual void columnDouble(const OracleColumn* column, const std::string& columnName, long double value) = 0;
+        virtual void columnString(const OracleColumn* column, const std::string& columnName) = 0;
+        virtual void columnNumber(const OracleColumn* column, const std::string& columnName, uint64_t precision, uint64_t scale) = 0;
+        virtual void columnRaw(const OracleColumn* column, const std::string& columnName, const uint8_t* data, uint64_t length) = 0;
+        // LOB value streamed in parts: CLOB as string, BLOB as raw data, every part is in valueBuffer
+        virtual void columnLobBegin(const OracleColumn* column, const std::string& columnName, bool isClob) = 0;
+        virtual void columnLobAppend(bool isClob) = 0;
+        virtual void columnLobEnd(bool isClob) = 0;
+        virtual void columnRowId(const OracleColumn* column, const std::string& columnName, typeRowId rowId) = 0;
+        virtual void columnTimestamp(const OracleColumn* column, const std::string& columnName, time_t timestamp, uint64_t fraction) = 0;
+        virtual void columnTimestampTz(const OracleColumn* column, const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) = 0;
         virtual void processInsert(typeScn scn, typeSeq sequence, time_t timestamp, LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, typeObj obj,
                                    typeDataObj dataObj, typeDba bdba, typeSlot slot, typeXid xid, uint64_t offset) = 0;
         virtual void processUpdate(typeScn scn, typeSeq sequence, time_t timestamp, LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, typeObj obj,
@@ -1233,6 +1293,9 @@ namespace OpenLogReplicator {
         static constexpr uint64_t INTERVAL_YTM_FORMAT_STRING_YM_COMMA = 3;
         static constexpr uint64_t INTERVAL_YTM_FORMAT_STRING_YM_DASH = 4;
 
+        static constexpr uint64_t LOB_FORMAT_VALUE = 0;
+        static constexpr uint64_t LOB_FORMAT_STREAM = 1;
+
         static constexpr uint64_t MESSAGE_FORMAT_DEFAULT = 0;
         static constexpr uint64_t MESSAGE_FORMAT_FULL = 1;
         static constexpr uint64_t MESSAGE_FORMAT_ADD_SEQUENCES = 2;
@@ -1309,6 +1372,10 @@ namespace OpenLogReplicator {
         static constexpr uint64_t XID_FORMAT_NUMERIC = 2;
 
         SystemTransaction* systemTransaction;
+        BuilderPool* pool;
+        // Set only for builders of the builder pool threads
+        BuilderPool* workerPool;
+        uint64_t workerTicket;
         uint64_t buffersAllocated;
         BuilderQueue* firstBuilderQueue;
         BuilderQueue* lastBuilderQueue;
@@ -1318,7 +1385,8 @@ namespace OpenLogReplicator {
         Builder(Ctx* newCtx, Locales* newLocales, Metadata* newMetadata, uint64_t newDbFormat, uint64_t newAttributesFormat, uint64_t newIntervalDtsFormat,
                 uint64_t newIntervalYtmFormat, uint64_t newMessageFormat, uint64_t newRidFormat, uint64_t newXidFormat, uint64_t newTimestampFormat,
                 uint64_t newTimestampTzFormat, uint64_t newTimestampAll, uint64_t newCharFormat, uint64_t newScnFormat, uint64_t newScnAll,
-                uint64_t newUnknownFormat, uint64_t newSchemaFormat, uint64_t newColumnFormat, uint64_t newUnknownType, uint64_t newFlushBuffer);
+                uint64_t newUnknownFormat, uint64_t newSchemaFormat, uint64_t newColumnFormat, uint64_t newUnknownType, uint64_t newLobFormat,
+                uint64_t newFlushBuffer);
         virtual ~Builder();
 
         [[nodiscard]] uint64_t builderSize() const;
@@ -1335,7 +1403,11 @@ namespace OpenLogReplicator {
         virtual void initialize();
         virtual void processCommit(typeScn scn, typeSeq sequence, time_t timestamp) = 0;
         virtual void processCheckpoint(typeScn scn, typeSeq sequence, time_t timestamp, uint64_t offset, bool redo) = 0;
-        void releaseBuffers(uint64_t maxId);
+        [[nodiscard]] uint64_t registerWriter();
+        void releaseBuffers(uint64_t writer, uint64_t maxId);
+        void mergeQueue(Builder* source);
+        void resetQueue();
+        void workerHandOver();
         void sleepForWriterWork(uint64_t queueSize, uint64_t nanoseconds);
         void wakeUp();
 
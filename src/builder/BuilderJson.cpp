@@ -28,108 +28,120 @@ namespace OpenLogReplicator {
                              uint64_t newIntervalDtsFormat, uint64_t newIntervalYtmFormat, uint64_t newMessageFormat, uint64_t newRidFormat,
                              uint64_t newXidFormat, uint64_t newTimestampFormat, uint64_t newTimestampTzFormat, uint64_t newTimestampAll,
                              uint64_t newCharFormat, uint64_t newScnFormat, uint64_t newScnAll, uint64_t newUnknownFormat, uint64_t newSchemaFormat,
-                             uint64_t newColumnFormat, uint64_t newUnknownType, uint64_t newFlushBuffer) :
+                             uint64_t newColumnFormat, uint64_t newUnknownType, uint64_t newLobFormat, uint64_t newFlushBuffer) :
             Builder(newCtx, newLocales, newMetadata, newDbFormat, newAttributesFormat, newIntervalDtsFormat, newIntervalYtmFormat, newMessageFormat,
                     newRidFormat, newXidFormat, newTimestampFormat, newTimestampTzFormat, newTimestampAll, newCharFormat, newScnFormat, newScnAll,
-                    newUnknownFormat, newSchemaFormat, newColumnFormat, newUnknownType, newFlushBuffer),
+                    newUnknownFormat, newSchemaFormat, newColumnFormat, newUnknownType, newLobFormat, newFlushBuffer),
             hasPreviousValue(false),
             hasPreviousRedo(false),
             hasPreviousColumn(false) {
     }
 
-    void BuilderJson::columnFloat(const std::string& columnName, double value) {
+    void BuilderJson::columnFloat(const OracleColumn* column, const std::string& columnName, double value) {
         if (hasPreviousColumn)
             append(',');
         else
             hasPreviousColumn = true;
 
-        append('"');
-        appendEscape(columnName);
-        append(R"(":)", sizeof(R"(":)") - 1);
+        appendColumnName(column, columnName);
 
         std::ostringstream ss;
         ss << value;
         append(ss.str());
     }
 
-    void BuilderJson::columnDouble(const std::string& columnName, long double value) {
+    void BuilderJson::columnDouble(const OracleColumn* column, const std::string& columnName, long double value) {
         if (hasPreviousColumn)
             append(',');
         else
             hasPreviousColumn = true;
 
-        append('"');
-        appendEscape(columnName);
-        append(R"(":)", sizeof(R"(":)") - 1);
+        appendColumnName(column, columnName);
 
         std::ostringstream ss;
         ss << value;
         append(ss.str());
     }
 
-    void BuilderJson::columnString(const std::string& columnName) {
+    void BuilderJson::columnString(const OracleColumn* column, const std::string& columnName) {
         if (hasPreviousColumn)
             append(',');
         else
             hasPreviousColumn = true;
 
+        appendColumnName(column, columnName);
         append('"');
-        appendEscape(columnName);
-        append(R"(":")", sizeof(R"(":")") - 1);
         appendEscape(valueBuffer, valueLength);
         append('"');
     }
 
-    void BuilderJson::columnNumber(const std::string& columnName, uint64_t precision __attribute__((unused)), uint64_t scale __attribute__((unused))) {
+    void BuilderJson::columnNumber(const OracleColumn* column, const std::string& columnName, uint64_t precision __attribute__((unused)), uint64_t scale __attribute__((unused))) {
         if (hasPreviousColumn)
             append(',');
         else
             hasPreviousColumn = true;
 
-        append('"');
-        appendEscape(columnName);
-        append(R"(":)", sizeof(R"(":)") - 1);
+        appendColumnName(column, columnName);
         append(valueBuffer, valueLength);
     }
 
-    void BuilderJson::columnRowId(const std::string& columnName, typeRowId rowId) {
+    void BuilderJson::columnRowId(const OracleColumn* column, const std::string& columnName, typeRowId rowId) {
         if (hasPreviousColumn)
             append(',');
         else
             hasPreviousColumn = true;
 
+        appendColumnName(column, columnName);
         append('"');
-        appendEscape(columnName);
-        append(R"(":")", sizeof(R"(":")") - 1);
         char str[19];
         rowId.toHex(str);
         append(str, 18);
         append('"');
     }
 
-    void BuilderJson::columnRaw(const std::string& columnName, const uint8_t* data, uint64_t length) {
+    void BuilderJson::columnRaw(const OracleColumn* column, const std::string& columnName, const uint8_t* data, uint64_t length) {
         if (hasPreviousColumn)
             append(',');
         else
             hasPreviousColumn = true;
 
+        appendColumnName(column, columnName);
         append('"');
-        appendEscape(columnName);
-        append(R"(":")", sizeof(R"(":")") - 1);
         for (uint64_t j = 0; j < length; ++j)
             appendHex2(*(data + j));
         append('"');
     }
 
-    void BuilderJson::columnTimestamp(const std::string& columnName, time_t timestamp, uint64_t fraction) {
+    void BuilderJson::columnLobBegin(const OracleColumn* column, const std::string& columnName, bool isClob __attribute__((unused))) {
         if (hasPreviousColumn)
             append(',');
         else
             hasPreviousColumn = true;
 
+        appendColumnName(column, columnName);
+        append('"');
+    }
+
+    void BuilderJson::columnLobAppend(bool isClob) {
+        if (isClob) {
+            appendEscape(valueBuffer, valueLength);
+        } else {
+            for (uint64_t j = 0; j < valueLength; ++j)
+                appendHex2(static_cast<uint8_t>(valueBuffer[j]));
+        }
+    }
+
+    void BuilderJson::columnLobEnd(bool isClob __attribute__((unused))) {
         append('"');
-        appendEscape(columnName);
-        append(R"(":)", sizeof(R"(":)") - 1);
+    }
+
+    void BuilderJson::columnTimestamp(const OracleColumn* column, const std::string& columnName, time_t timestamp, uint64_t fraction) {
+        if (hasPreviousColumn)
+            append(',');
+        else
+            hasPreviousColumn = true;
+
+        appendColumnName(column, columnName);
         char buffer[22];
 
         switch (timestampFormat) {
@@ -302,15 +314,13 @@ namespace OpenLogReplicator {
         }
     }
 
-    void BuilderJson::columnTimestampTz(const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) {
+    void BuilderJson::columnTimestampTz(const OracleColumn* column, const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) {
         if (hasPreviousColumn)
             append(',');
         else
             hasPreviousColumn = true;
 
-        append('"');
-        appendEscape(columnName);
-        append(R"(":)", sizeof(R"(":)") - 1);
+        appendColumnName(column, columnName);
         char buffer[22];
 
         switch (timestampTzFormat) {
@@ -17,6 +17,13 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #include "Builder.h"
 #include "../common/OracleColumn.h"
 #include "../common/OracleTable.h"
@@ -71,14 +78,13 @@ namespace OpenLogReplicator {
             else
                 hasPreviousColumn = true;
 
-            append('"');
             if (table != nullptr)
-                appendEscape(table->columns[col]->name);
+                append(table->columns[col]->nameJson);
             else {
-                std::string columnName("COL_" + std::to_string(col));
+                std::string columnName("\"COL_" + std::to_string(col) + "\":");
                 append(columnName);
             }
-            append(R"(":null)", sizeof(R"(":null)") - 1);
+            append("null", sizeof("null") - 1);
         }
 
         inline void appendRowid(typeDataObj dataObj, typeDba bdba, typeSlot slot) {
@@ -323,11 +329,7 @@ namespace OpenLogReplicator {
                 return;
             }
 
-            append(R"("schema":{"owner":")", sizeof(R"("schema":{"owner":")") - 1);
-            appendEscape(table->owner);
-            append(R"(","table":")", sizeof(R"(","table":")") - 1);
-            appendEscape(table->name);
-            append('"');
+            append(table->schemaJson);
 
             if ((schemaFormat & SCHEMA_FORMAT_OBJ) != 0) {
                 append(R"(,"obj":)", sizeof(R"(,"obj":)") - 1);
@@ -584,29 +586,33 @@ namespace OpenLogReplicator {
 
         inline void appendEscape(const char* str, uint64_t length) {
             while (length > 0) {
-                if (*str == '\t') {
-                    append("\\t", sizeof("\\t") - 1);
-                } else if (*str == '\r') {
-                    append("\\r", sizeof("\\r") - 1);
-                } else if (*str == '\n') {
-                    append("\\n", sizeof("\\n") - 1);
-                } else if (*str == '\f') {
-                    append("\\f", sizeof("\\f") - 1);
-                } else if (*str == '\b') {
-                    append("\\b", sizeof("\\b") - 1);
-                } else if (static_cast<unsigned char>(*str) < 32) {
-                    append("\\u00", sizeof("\\u00") - 1);
-                    appendDec(*str, 2);
-                } else {
-                    if (*str == '"' || *str == '\\' || *str == '/')
-                        append('\\');
-                    append(*str);
-                }
+                // Copy the part which needs no escaping at once
+                uint64_t clean = jsonCleanLength(str, length);
+                append(str, clean);
+                str += clean;
+                length -= clean;
+                if (length == 0)
+                    break;
+
+                char buffer[6];
+                append(buffer, jsonEscapeChar(*str, buffer));
                 ++str;
                 --length;
             }
         }
 
+        // Column name as JSON key: "NAME":, pre-escaped for table columns
+        inline void appendColumnName(const OracleColumn* column, const std::string& columnName) {
+            if (column != nullptr) {
+                append(column->nameJson);
+                return;
+            }
+
+            append('"');
+            appendEscape(columnName);
+            append(R"(":)", sizeof(R"(":)") - 1);
+        }
+
         inline void appendAfter(LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, uint64_t offset) {
             append(R"(,"after":{)", sizeof(R"(,"after":{)") - 1);
 
@@ -682,14 +688,17 @@ namespace OpenLogReplicator {
         }
 
 
-        virtual void columnFloat(const std::string& columnName, double value) override;
-        virtual void columnDouble(const std::string& columnName, long double value) override;
-        virtual void columnString(const std::string& columnName) override;
-        virtual void columnNumber(const std::string& columnName, uint64_t precision, uint64_t scale) override;
-        virtual void columnRaw(const std::string& columnName, const uint8_t* data, uint64_t length) override;
-        virtual void columnRowId(const std::string& columnName, typeRowId rowId) override;
-        virtual void columnTimestamp(const std::string& columnName, time_t timestamp, uint64_t fraction) override;
-        virtual void columnTimestampTz(const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) override;
+        virtual void columnFloat(const OracleColumn* column, const std::string& columnName, double value) override;
+        virtual void columnDouble(const OracleColumn* column, const std::string& columnName, long double value) override;
+        virtual void columnString(const OracleColumn* column, const std::string& columnName) override;
+        virtual void columnNumber(const OracleColumn* column, const std::string& columnName, uint64_t precision, uint64_t scale) override;
+        virtual void columnRaw(const OracleColumn* column, const std::string& columnName, const uint8_t* data, uint64_t length) override;
+        virtual void columnLobBegin(const OracleColumn* column, const std::string& columnName, bool isClob) override;
+        virtual void columnLobAppend(bool isClob) override;
+        virtual void columnLobEnd(bool isClob) override;
+        virtual void columnRowId(const OracleColumn* column, const std::string& columnName, typeRowId rowId) override;
+        virtual void columnTimestamp(const OracleColumn* column, const std::string& columnName, time_t timestamp, uint64_t fraction) override;
+        virtual void columnTimestampTz(const OracleColumn* column, const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) override;
         virtual void processInsert(typeScn scn, typeSeq sequence, time_t timestamp, LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, typeObj obj,
                                    typeDataObj dataObj, typeDba bdba, typeSlot slot, typeXid xid, uint64_t offset) override;
         virtual void processUpdate(typeScn scn, typeSeq sequence, time_t timestamp, LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, typeObj obj,
@@ -704,10 +713,109 @@ namespace OpenLogReplicator {
         BuilderJson(Ctx* newCtx, Locales* newLocales, Metadata* newMetadata, uint64_t newDbFormat, uint64_t newAttributesFormat, uint64_t newIntervalDtsFormat,
                     uint64_t newIntervalYtmFormat, uint64_t newMessageFormat, uint64_t newRidFormat, uint64_t newXidFormat, uint64_t newTimestampFormat,
                     uint64_t newTimestampTzFormat, uint64_t newTimestampAll, uint64_t newCharFormat, uint64_t newScnFormat, uint64_t newScnAll,
-                    uint64_t newUnknownFormat, uint64_t newSchemaFormat, uint64_t newColumnFormat, uint64_t newUnknownType, uint64_t newFlushBuffer);
+                    uint64_t newUnknownFormat, uint64_t newSchemaFormat, uint64_t newColumnFormat, uint64_t newUnknownType, uint64_t newLobFormat,
+                    uint64_t newFlushBuffer);
 
         virtual void processCommit(typeScn scn, typeSeq sequence, time_t timestamp) override;
         virtual void processCheckpoint(typeScn scn, typeSeq sequence, time_t timestamp, uint64_t offset, bool redo) override;
+
+        // Length of the leading part of the string which can be put in JSON output without escaping
+        [[nodiscard]] static inline uint64_t jsonCleanLength(const char* str, uint64_t length) {
+            uint64_t pos = 0;
+
+#if defined(__x86_64__)
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i slash = _mm_set1_epi8('/');
+            const __m128i control = _mm_set1_epi8(0x1F);
+            for (; pos + 16 <= length; pos += 16) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+                __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                               _mm_or_si128(_mm_cmpeq_epi8(chunk, slash), _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk)));
+                int mask = _mm_movemask_epi8(special);
+                if (mask != 0)
+                    return pos + static_cast<uint64_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+            }
+#endif
+#if defined(__aarch64__)
+            for (; pos + 16 <= length; pos += 16) {
+                uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(str + pos));
+                uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('"')), vceqq_u8(chunk, vdupq_n_u8('\\'))),
+                                              vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('/')), vcltq_u8(chunk, vdupq_n_u8(0x20))));
+                if (vmaxvq_u8(special) != 0)
+                    break;
+            }
+#endif
+
+            for (; pos < length; ++pos) {
+                auto character = static_cast<unsigned char>(str[pos]);
+                if (character < 0x20 || character == '"' || character == '\\' || character == '/')
+                    break;
+            }
+            return pos;
+        }
+
+        // Escape sequence (up to 6 characters) for one character which can't be put in JSON output directly
+        static inline uint64_t jsonEscapeChar(char character, char* out) {
+            out[0] = '\\';
+            switch (character) {
+                case '\t':
+                    out[1] = 't';
+                    return 2;
+
+                case '\r':
+                    out[1] = 'r';
+                    return 2;
+
+                case '\n':
+                    out[1] = 'n';
+                    return 2;
+
+                case '\f':
+                    out[1] = 'f';
+                    return 2;
+
+                case '\b':
+                    out[1] = 'b';
+                    return 2;
+
+                case '"':
+                case '\\':
+                case '/':
+                    out[1] = character;
+                    return 2;
+
+                default:
+                    out[1] = 'u';
+                    out[2] = '0';
+                    out[3] = '0';
+                    out[4] = Ctx::map16((static_cast<unsigned char>(character) >> 4) & 0x0F);
+                    out[5] = Ctx::map16(static_cast<unsigned char>(character) & 0x0F);
+                    return 6;
+            }
+        }
+
+        [[nodiscard]] static inline std::string jsonEscape(const std::string& str) {
+            std::string out;
+            out.reserve(str.length());
+            const char* data = str.c_str();
+            uint64_t length = str.length();
+
+            while (length > 0) {
+                uint64_t clean = jsonCleanLength(data, length);
+                out.append(data, clean);
+                data += clean;
+                length -= clean;
+                if (length == 0)
+                    break;
+
+                char buffer[6];
+                out.append(buffer, jsonEscapeChar(*data, buffer));
+                ++data;
+                --length;
+            }
+            return out;
+        }
     };
 }
 
@@ -0,0 +1,158 @@
+/* Pool of threads formatting committed transactions
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include "../common/Ctx.h"
+#include "../parser/Transaction.h"
+#include "Builder.h"
+#include "BuilderPool.h"
+#include "BuilderWorker.h"
+
+namespace OpenLogReplicator {
+    BuilderPool::BuilderPool(Ctx* newCtx, Builder* newBuilder, Metadata* newMetadata, TransactionBuffer* newTransactionBuffer) :
+            ctx(newCtx),
+            builder(newBuilder),
+            metadata(newMetadata),
+            transactionBuffer(newTransactionBuffer),
+            nextTicket(0),
+            publishTicket(0) {
+    }
+
+    BuilderPool::~BuilderPool() {
+        for (BuilderWorker* worker: workers)
+            delete worker;
+        workers.clear();
+
+        // Transactions left after hard shutdown
+        for (const BuilderJob& job: transactions) {
+            job.transaction->purge(transactionBuffer);
+            delete job.transaction;
+        }
+        transactions.clear();
+        checkpoints.clear();
+    }
+
+    void BuilderPool::addWorker(BuilderWorker* worker) {
+        workers.push_back(worker);
+    }
+
+    void BuilderPool::setMaxMessageMb(uint64_t maxMessageMb) {
+        for (BuilderWorker* worker: workers)
+            worker->builder->setMaxMessageMb(maxMessageMb);
+    }
+
+    void BuilderPool::flush(Transaction* transaction, typeScn lwnScn) {
+        std::unique_lock<std::mutex> lck(mtx);
+        while (transactions.size() >= workers.size() * JOBS_PER_WORKER && !ctx->hardShutdown) {
+            if (ctx->trace & Ctx::TRACE_SLEEP)
+                ctx->logTrace(Ctx::TRACE_SLEEP, "BuilderPool:flush");
+            condPublish.wait_for(lck, std::chrono::milliseconds(100));
+        }
+
+        transactions.push_back(BuilderJob{nextTicket++, transaction, lwnScn, 0, 0, 0, false});
+        condJob.notify_one();
+    }
+
+    void BuilderPool::processCheckpoint(typeScn scn, typeSeq sequence, time_t timestamp, uint64_t offset, bool redo) {
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            // Some transactions are still formatted, the checkpoint must follow them
+            if (publishTicket != nextTicket) {
+                checkpoints.push_back(BuilderJob{nextTicket++, nullptr, scn, sequence, timestamp, offset, redo});
+                return;
+            }
+        }
+
+        builder->processCheckpoint(scn, sequence, timestamp, offset, redo);
+    }
+
+    void BuilderPool::drain() {
+        std::unique_lock<std::mutex> lck(mtx);
+        while (publishTicket != nextTicket && !ctx->hardShutdown) {
+            if (ctx->trace & Ctx::TRACE_SLEEP)
+                ctx->logTrace(Ctx::TRACE_SLEEP, "BuilderPool:drain");
+            condPublish.wait_for(lck, std::chrono::milliseconds(100));
+        }
+    }
+
+    bool BuilderPool::getJob(BuilderJob& job) {
+        std::unique_lock<std::mutex> lck(mtx);
+        while (!ctx->hardShutdown) {
+            if (!transactions.empty()) {
+                job = transactions.front();
+                transactions.pop_front();
+                condPublish.notify_all();
+                return true;
+            }
+
+            if (ctx->softShutdown && ctx->replicatorFinished)
+                break;
+            condJob.wait_for(lck, std::chrono::milliseconds(100));
+        }
+        return false;
+    }
+
+    void BuilderPool::publish(const BuilderJob& job, Builder* workerBuilder) {
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            while (publishTicket != job.ticket) {
+                if (ctx->hardShutdown)
+                    return;
+                condPublish.wait_for(lck, std::chrono::milliseconds(100));
+            }
+        }
+
+        // Only the owner of the current ticket appends to the output queue
+        builder->mergeQueue(workerBuilder);
+        workerBuilder->resetQueue();
+
+        std::unique_lock<std::mutex> lck(mtx);
+        ++publishTicket;
+        while (!checkpoints.empty() && checkpoints.front().ticket == publishTicket) {
+            const BuilderJob& checkpoint = checkpoints.front();
+            builder->processCheckpoint(checkpoint.scn, checkpoint.sequence, checkpoint.timestamp, checkpoint.offset, checkpoint.redo);
+            checkpoints.pop_front();
+            ++publishTicket;
+        }
+        condPublish.notify_all();
+    }
+
+    void BuilderPool::handOver(Builder* workerBuilder, uint64_t ticket) {
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            // Too much output is waiting, stop formatting until it's the turn of this transaction
+            while (publishTicket != ticket) {
+                if (workerBuilder->buffersAllocated <= WORKER_BUFFERS_MAX || ctx->hardShutdown)
+                    return;
+                if (ctx->trace & Ctx::TRACE_SLEEP)
+                    ctx->logTrace(Ctx::TRACE_SLEEP, "BuilderPool:handOver");
+                condPublish.wait_for(lck, std::chrono::milliseconds(100));
+            }
+        }
+
+        // The transaction owns the current ticket, the messages can go directly to the output queue
+        builder->mergeQueue(workerBuilder);
+        workerBuilder->resetQueue();
+    }
+
+    void BuilderPool::wakeUp() {
+        std::unique_lock<std::mutex> lck(mtx);
+        condJob.notify_all();
+        condPublish.notify_all();
+    }
+}
@@ -0,0 +1,87 @@
+/* Header for BuilderPool class
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "../common/types.h"
+
+#ifndef BUILDER_POOL_H_
+#define BUILDER_POOL_H_
+
+namespace OpenLogReplicator {
+    class Builder;
+    class BuilderWorker;
+    class Ctx;
+    class Metadata;
+    class Transaction;
+    class TransactionBuffer;
+
+    struct BuilderJob {
+        uint64_t ticket;
+        Transaction* transaction;
+        typeScn scn;
+        typeSeq sequence;
+        time_t timestamp;
+        uint64_t offset;
+        bool redo;
+    };
+
+    class BuilderPool final {
+    protected:
+        Ctx* ctx;
+        Builder* builder;
+        Metadata* metadata;
+        TransactionBuffer* transactionBuffer;
+        std::vector<BuilderWorker*> workers;
+        std::deque<BuilderJob> transactions;
+        std::deque<BuilderJob> checkpoints;
+        uint64_t nextTicket;
+        uint64_t publishTicket;
+
+        std::mutex mtx;
+        std::condition_variable condJob;
+        std::condition_variable condPublish;
+
+        [[nodiscard]] bool getJob(BuilderJob& job);
+        void publish(const BuilderJob& job, Builder* workerBuilder);
+        void handOver(Builder* workerBuilder, uint64_t ticket);
+
+    public:
+        static constexpr uint64_t JOBS_PER_WORKER = 4;
+        static constexpr uint64_t WORKER_BUFFERS_MAX = 16;
+
+        BuilderPool(Ctx* newCtx, Builder* newBuilder, Metadata* newMetadata, TransactionBuffer* newTransactionBuffer);
+        virtual ~BuilderPool();
+
+        void addWorker(BuilderWorker* worker);
+        void setMaxMessageMb(uint64_t maxMessageMb);
+        void flush(Transaction* transaction, typeScn lwnScn);
+        void processCheckpoint(typeScn scn, typeSeq sequence, time_t timestamp, uint64_t offset, bool redo);
+        void drain();
+        void wakeUp();
+
+        friend class Builder;
+        friend class BuilderWorker;
+    };
+}
+
+#endif
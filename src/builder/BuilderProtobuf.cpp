@@ -31,102 +31,349 @@ namespace OpenLogReplicator {
                                      uint64_t newIntervalDtsFormat, uint64_t newIntervalYtmFormat, uint64_t newMessageFormat, uint64_t newRidFormat,
                                      uint64_t newXidFormat, uint64_t newTimestampFormat, uint64_t newTimestampTzFormat, uint64_t newTimestampAll,
                                      uint64_t newCharFormat, uint64_t newScnFormat, uint64_t newScnAll, uint64_t newUnknownFormat, uint64_t newSchemaFormat,
-                                     uint64_t newColumnFormat, uint64_t newUnknownType, uint64_t newFlushBuffer) :
+                                     uint64_t newColumnFormat, uint64_t newUnknownType, uint64_t newLobFormat, uint64_t newFlushBuffer) :
             Builder(newCtx, newLocales, newMetadata, newDbFormat, newAttributesFormat, newIntervalDtsFormat, newIntervalYtmFormat, newMessageFormat,
                     newRidFormat, newXidFormat, newTimestampFormat, newTimestampTzFormat, newTimestampAll, newCharFormat, newScnFormat, newScnAll,
-                    newUnknownFormat, newSchemaFormat, newColumnFormat, newUnknownType, newFlushBuffer),
-            redoResponsePB(nullptr),
-            valuePB(nullptr),
-            payloadPB(nullptr),
-            schemaPB(nullptr) {
+                    newUnknownFormat, newSchemaFormat, newColumnFormat, newUnknownType, newLobFormat, newFlushBuffer),
+            payloadLength(),
+            schemaLength(),
+            lobValueLength(),
+            lobDataLength(),
+            valueField(FIELD_PAYLOAD_AFTER) {
     }
 
     BuilderProtobuf::~BuilderProtobuf() {
-        if (redoResponsePB != nullptr) {
-            delete redoResponsePB;
-            redoResponsePB = nullptr;
-        }
-        google::protobuf::ShutdownProtobufLibrary();
     }
 
-    void BuilderProtobuf::columnFloat(const std::string& columnName, double value) {
-        valuePB->set_name(columnName);
-        valuePB->set_value_double(value);
+    void BuilderProtobuf::columnFloat(const OracleColumn* column __attribute__((unused)), const std::string& columnName, double value) {
+        appendValueDouble(columnName, value);
     }
 
     // TODO: possible precision loss
-    void BuilderProtobuf::columnDouble(const std::string& columnName, long double value) {
-        valuePB->set_name(columnName);
-        valuePB->set_value_double(value);
+    void BuilderProtobuf::columnDouble(const OracleColumn* column __attribute__((unused)), const std::string& columnName, long double value) {
+        appendValueDouble(columnName, static_cast<double>(value));
     }
 
-    void BuilderProtobuf::columnString(const std::string& columnName) {
-        valuePB->set_name(columnName);
-        valuePB->set_value_string(valueBuffer, valueLength);
+    void BuilderProtobuf::columnString(const OracleColumn* column __attribute__((unused)), const std::string& columnName) {
+        appendValueString(columnName, FIELD_VALUE_STRING, valueBuffer, valueLength);
     }
 
-    void BuilderProtobuf::columnNumber(const std::string& columnName, uint64_t precision, uint64_t scale) {
-        valuePB->set_name(columnName);
+    void BuilderProtobuf::columnNumber(const OracleColumn* column __attribute__((unused)), const std::string& columnName, uint64_t precision, uint64_t scale) {
         valueBuffer[valueLength] = 0;
         char* retPtr;
 
         if (scale == 0 && precision <= 17) {
             int64_t value = strtol(valueBuffer, &retPtr, 10);
-            valuePB->set_value_int(value);
+            appendValueInt(columnName, value);
         } else if (precision <= 6 && scale < 38) {
             float value = strtof(valueBuffer, &retPtr);
-            valuePB->set_value_float(value);
+            appendValueFloat(columnName, value);
         } else if (precision <= 15 && scale <= 307) {
             double value = strtod(valueBuffer, &retPtr);
-            valuePB->set_value_double(value);
+            appendValueDouble(columnName, value);
         } else {
-            valuePB->set_value_string(valueBuffer, valueLength);
+            appendValueString(columnName, FIELD_VALUE_STRING, valueBuffer, valueLength);
         }
     }
 
-    void BuilderProtobuf::columnRowId(const std::string& columnName, typeRowId rowId) {
+    void BuilderProtobuf::columnRowId(const OracleColumn* column __attribute__((unused)), const std::string& columnName, typeRowId rowId) {
         char str[19];
         rowId.toHex(str);
-        valuePB->set_name(columnName);
-        valuePB->set_value_string(str, 18);
+        appendValueString(columnName, FIELD_VALUE_STRING, str, 18);
+    }
+
+    void BuilderProtobuf::columnRaw(const OracleColumn* column __attribute__((unused)), const std::string& columnName, const uint8_t* data, uint64_t length) {
+        appendValueString(columnName, FIELD_VALUE_BYTES, reinterpret_cast<const char*>(data), length);
+    }
+
+    void BuilderProtobuf::columnLobBegin(const OracleColumn* column __attribute__((unused)), const std::string& columnName, bool isClob) {
+        // Length of the value is not known in advance
+        appendTag(valueField, WIRE_LENGTH);
+        beginLength(lobValueLength);
+        appendFieldString(FIELD_VALUE_NAME, columnName);
+        appendTag(isClob ? FIELD_VALUE_STRING : FIELD_VALUE_BYTES, WIRE_LENGTH);
+        beginLength(lobDataLength);
     }
 
-    void BuilderProtobuf::columnRaw(const std::string& columnName, const uint8_t* data __attribute__((unused)), uint64_t length __attribute__((unused))) {
-        valuePB->set_name(columnName);
-        // TODO: implement
+    void BuilderProtobuf::columnLobAppend(bool isClob __attribute__((unused))) {
+        append(valueBuffer, valueLength);
     }
 
-    void BuilderProtobuf::columnTimestamp(const std::string& columnName, time_t tmstp __attribute__((unused)),
-                                          uint64_t fraction __attribute__((unused))) {
-        valuePB->set_name(columnName);
-        // TODO: implement
+    void BuilderProtobuf::columnLobEnd(bool isClob __attribute__((unused))) {
+        endLength(lobDataLength);
+        endLength(lobValueLength);
     }
 
-    void BuilderProtobuf::columnTimestampTz(const std::string& columnName, time_t tmstp __attribute__((unused)),
-                                            uint64_t fraction __attribute__((unused)), const char* tz __attribute__((unused))) {
-        valuePB->set_name(columnName);
-        // TODO: implement
+    void BuilderProtobuf::columnTimestamp(const OracleColumn* column __attribute__((unused)), const std::string& columnName, time_t timestamp, uint64_t fraction) {
+        char buffer[64];
+        uint64_t length = 0;
+
+        switch (timestampFormat) {
+            case TIMESTAMP_FORMAT_UNIX_NANO:
+                // 1712345678123456789
+                if (timestamp < 9000000000L && timestamp > -9000000000L) {
+                    appendValueInt(columnName, timestamp * 1000000000L + static_cast<int64_t>(fraction));
+                    return;
+                }
+                // Big number
+                length = formatNano(buffer, timestamp, fraction);
+                break;
+
+            case TIMESTAMP_FORMAT_UNIX_MICRO:
+                // 1712345678123457
+                appendValueInt(columnName, timestamp * 1000000L + static_cast<int64_t>((fraction + 500) / 1000));
+                return;
+
+            case TIMESTAMP_FORMAT_UNIX_MILLI:
+                // 1712345678123
+                appendValueInt(columnName, timestamp * 1000L + static_cast<int64_t>((fraction + 500000) / 1000000));
+                return;
+
+            case TIMESTAMP_FORMAT_UNIX:
+                // 1712345678
+                appendValueInt(columnName, timestamp + static_cast<int64_t>((fraction + 500000000) / 1000000000));
+                return;
+
+            case TIMESTAMP_FORMAT_UNIX_NANO_STRING:
+                // "1712345678123456789"
+                length = formatNano(buffer, timestamp, fraction);
+                break;
+
+            case TIMESTAMP_FORMAT_UNIX_MICRO_STRING:
+                // "1712345678123457"
+                length = formatSDec(buffer, timestamp * 1000000L + static_cast<int64_t>((fraction + 500) / 1000));
+                break;
+
+            case TIMESTAMP_FORMAT_UNIX_MILLI_STRING:
+                // "1712345678123"
+                length = formatSDec(buffer, timestamp * 1000L + static_cast<int64_t>((fraction + 500000) / 1000000));
+                break;
+
+            case TIMESTAMP_FORMAT_UNIX_STRING:
+                // "1712345678"
+                length = formatSDec(buffer, timestamp + static_cast<int64_t>((fraction + 500000000) / 1000000000));
+                break;
+
+            case TIMESTAMP_FORMAT_ISO8601_NANO_TZ:
+                // "2024-04-05T19:34:38.123456789Z"
+                length = ctx->epochToIso8601(timestamp, buffer, true, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 9);
+                buffer[length++] = 'Z';
+                break;
+
+            case TIMESTAMP_FORMAT_ISO8601_MICRO_TZ:
+                // "2024-04-05T19:34:38.123456Z"
+                fraction += 500;
+                fraction /= 1000;
+                if (fraction >= 1000000) {
+                    fraction -= 1000000;
+                    ++timestamp;
+                }
+                length = ctx->epochToIso8601(timestamp, buffer, true, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 6);
+                buffer[length++] = 'Z';
+                break;
+
+            case TIMESTAMP_FORMAT_ISO8601_MILLI_TZ:
+                // "2024-04-05T19:34:38.123Z"
+                fraction += 500000;
+                fraction /= 1000000;
+                if (fraction >= 1000) {
+                    fraction -= 1000;
+                    ++timestamp;
+                }
+                length = ctx->epochToIso8601(timestamp, buffer, true, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 3);
+                buffer[length++] = 'Z';
+                break;
+
+            case TIMESTAMP_FORMAT_ISO8601_TZ:
+                // "2024-04-05T19:34:38Z"
+                if (fraction >= 500000000)
+                    ++timestamp;
+                length = ctx->epochToIso8601(timestamp, buffer, true, false);
+                buffer[length++] = 'Z';
+                break;
+
+            case TIMESTAMP_FORMAT_ISO8601_NANO:
+                // "2024-04-05 19:34:38.123456789"
+                length = ctx->epochToIso8601(timestamp, buffer, false, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 9);
+                break;
+
+            case TIMESTAMP_FORMAT_ISO8601_MICRO:
+                // "2024-04-05 19:34:38.123456"
+                fraction += 500;
+                fraction /= 1000;
+                if (fraction >= 1000000) {
+                    fraction -= 1000000;
+                    ++timestamp;
+                }
+                length = ctx->epochToIso8601(timestamp, buffer, false, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 6);
+                break;
+
+            case TIMESTAMP_FORMAT_ISO8601_MILLI:
+                // "2024-04-05 19:34:38.123"
+                fraction += 500000;
+                fraction /= 1000000;
+                if (fraction >= 1000) {
+                    fraction -= 1000;
+                    ++timestamp;
+                }
+                length = ctx->epochToIso8601(timestamp, buffer, false, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 3);
+                break;
+
+            case TIMESTAMP_FORMAT_ISO8601:
+                // "2024-04-05 19:34:38"
+                if (fraction >= 500000000)
+                    ++timestamp;
+                length = ctx->epochToIso8601(timestamp, buffer, false, false);
+                break;
+        }
+
+        appendValueString(columnName, FIELD_VALUE_STRING, buffer, length);
+    }
+
+    void BuilderProtobuf::columnTimestampTz(const OracleColumn* column __attribute__((unused)), const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) {
+        char buffer[64];
+        uint64_t length = 0;
+
+        switch (timestampTzFormat) {
+            case TIMESTAMP_TZ_FORMAT_UNIX_NANO_STRING:
+                // "1700000000.123456789,Europe/Warsaw"
+                length = formatNano(buffer, timestamp, fraction);
+                buffer[length++] = ',';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_UNIX_MICRO_STRING:
+                // "1700000000.123456,Europe/Warsaw"
+                length = formatSDec(buffer, timestamp * 1000000L + static_cast<int64_t>((fraction + 500) / 1000));
+                buffer[length++] = ',';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_UNIX_MILLI_STRING:
+                // "1700000000.123,Europe/Warsaw"
+                length = formatSDec(buffer, timestamp * 1000L + static_cast<int64_t>((fraction + 500000) / 1000000));
+                buffer[length++] = ',';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_UNIX_STRING:
+                // "1700000000,Europe/Warsaw"
+                length = formatSDec(buffer, timestamp + static_cast<int64_t>((fraction + 500000000) / 1000000000));
+                buffer[length++] = ',';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_ISO8601_NANO_TZ:
+                // "2024-04-05T19:34:38.123456789Z Europe/Warsaw"
+                length = ctx->epochToIso8601(timestamp, buffer, true, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 9);
+                buffer[length++] = 'Z';
+                buffer[length++] = ' ';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_ISO8601_MICRO_TZ:
+                // "2024-04-05T19:34:38.123456Z Europe/Warsaw"
+                fraction += 500;
+                fraction /= 1000;
+                if (fraction >= 1000000) {
+                    fraction -= 1000000;
+                    ++timestamp;
+                }
+                length = ctx->epochToIso8601(timestamp, buffer, true, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 6);
+                buffer[length++] = 'Z';
+                buffer[length++] = ' ';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_ISO8601_MILLI_TZ:
+                // "2024-04-05T19:34:38.123Z Europe/Warsaw"
+                fraction += 500000;
+                fraction /= 1000000;
+                if (fraction >= 1000) {
+                    fraction -= 1000;
+                    ++timestamp;
+                }
+                length = ctx->epochToIso8601(timestamp, buffer, true, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 3);
+                buffer[length++] = 'Z';
+                buffer[length++] = ' ';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_ISO8601_TZ:
+                // "2024-04-05T19:34:38Z Europe/Warsaw"
+                if (fraction >= 500000000)
+                    ++timestamp;
+                length = ctx->epochToIso8601(timestamp, buffer, true, false);
+                buffer[length++] = 'Z';
+                buffer[length++] = ' ';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_ISO8601_NANO:
+                // "2024-04-05 19:34:38.123456789 Europe/Warsaw"
+                length = ctx->epochToIso8601(timestamp, buffer, false, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 9);
+                buffer[length++] = ' ';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_ISO8601_MICRO:
+                // "2024-04-05 19:34:38.123456 Europe/Warsaw"
+                fraction += 500;
+                fraction /= 1000;
+                if (fraction >= 1000000) {
+                    fraction -= 1000000;
+                    ++timestamp;
+                }
+                length = ctx->epochToIso8601(timestamp, buffer, false, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 6);
+                buffer[length++] = ' ';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_ISO8601_MILLI:
+                // "2024-04-05 19:34:38.123 Europe/Warsaw"
+                fraction += 500000;
+                fraction /= 1000000;
+                if (fraction >= 1000) {
+                    fraction -= 1000;
+                    ++timestamp;
+                }
+                length = ctx->epochToIso8601(timestamp, buffer, false, false);
+                buffer[length++] = '.';
+                length += formatDec(buffer + length, fraction, 3);
+                buffer[length++] = ' ';
+                break;
+
+            case TIMESTAMP_TZ_FORMAT_ISO8601:
+                // "2024-04-05 19:34:38 Europe/Warsaw"
+                if (fraction >= 500000000)
+                    ++timestamp;
+                length = ctx->epochToIso8601(timestamp, buffer, false, false);
+                buffer[length++] = ' ';
+                break;
+        }
+
+        appendValueString(columnName, FIELD_VALUE_STRING, buffer, length, tz, strlen(tz));
     }
 
     void BuilderProtobuf::processBeginMessage(typeScn scn, typeSeq sequence, time_t timestamp) {
         newTran = false;
         builderBegin(scn, sequence, 0, 0);
-        createResponse();
         appendHeader(scn, timestamp, true, (dbFormat & DB_FORMAT_ADD_DML) != 0, true);
 
         if ((messageFormat & MESSAGE_FORMAT_FULL) == 0) {
-            redoResponsePB->add_payload();
-            payloadPB = redoResponsePB->mutable_payload(redoResponsePB->payload_size() - 1);
-            payloadPB->set_op(pb::BEGIN);
-
-            std::string output;
-            bool ret = redoResponsePB->SerializeToString(&output);
-            delete redoResponsePB;
-            redoResponsePB = nullptr;
-
-            if (!ret)
-                throw RuntimeException(50017, "PB begin processing failed, error serializing to string");
-            append(output);
+            appendPayloadOp(pb::BEGIN);
             builderCommit(false);
         }
     }
@@ -137,34 +384,21 @@ namespace OpenLogReplicator {
             processBeginMessage(scn, sequence, timestamp);
 
         if ((messageFormat & MESSAGE_FORMAT_FULL) != 0) {
-            if (redoResponsePB == nullptr)
+            if (msg == nullptr)
                 throw RuntimeException(50018, "PB insert processing failed, a message is missing");
         } else {
             builderBegin(scn, sequence, obj, 0);
-            createResponse();
             appendHeader(scn, timestamp, true, (dbFormat & DB_FORMAT_ADD_DML) != 0, true);
         }
 
-        redoResponsePB->add_payload();
-        payloadPB = redoResponsePB->mutable_payload(redoResponsePB->payload_size() - 1);
-        payloadPB->set_op(pb::INSERT);
-
-        schemaPB = payloadPB->mutable_schema();
+        appendPayloadBegin(pb::INSERT);
         appendSchema(table, obj);
         appendRowid(dataObj, bdba, slot);
         appendAfter(lobCtx, xmlCtx, table, offset);
+        endLength(payloadLength);
 
-        if ((messageFormat & MESSAGE_FORMAT_FULL) == 0) {
-            std::string output;
-            bool ret = redoResponsePB->SerializeToString(&output);
-            delete redoResponsePB;
-            redoResponsePB = nullptr;
-
-            if (!ret)
-                throw RuntimeException(50017, "PB insert processing failed, error serializing to string");
-            append(output);
+        if ((messageFormat & MESSAGE_FORMAT_FULL) == 0)
             builderCommit(false);
-        }
         ++num;
     }
 
@@ -174,35 +408,22 @@ namespace OpenLogReplicator {
             processBeginMessage(scn, sequence, timestamp);
 
         if ((messageFormat & MESSAGE_FORMAT_FULL) != 0) {
-            if (redoResponsePB == nullptr)
+            if (msg == nullptr)
                 throw RuntimeException(50018, "PB update processing failed, a message is missing");
         } else {
             builderBegin(scn, sequence, obj, 0);
-            createResponse();
             appendHeader(scn, timestamp, true, (dbFormat & DB_FORMAT_ADD_DML) != 0, true);
         }
 
-        redoResponsePB->add_payload();
-        payloadPB = redoResponsePB->mutable_payload(redoResponsePB->payload_size() - 1);
-        payloadPB->set_op(pb::UPDATE);
-
-        schemaPB = payloadPB->mutable_schema();
+        appendPayloadBegin(pb::UPDATE);
         appendSchema(table, obj);
         appendRowid(dataObj, bdba, slot);
         appendBefore(lobCtx, xmlCtx, table, offset);
         appendAfter(lobCtx, xmlCtx, table, offset);
+        endLength(payloadLength);
 
-        if ((messageFormat & MESSAGE_FORMAT_FULL) == 0) {
-            std::string output;
-            bool ret = redoResponsePB->SerializeToString(&output);
-            delete redoResponsePB;
-            redoResponsePB = nullptr;
-
-            if (!ret)
-                throw RuntimeException(50017, "PB update processing failed, error serializing to string");
-            append(output);
+        if ((messageFormat & MESSAGE_FORMAT_FULL) == 0)
             builderCommit(false);
-        }
         ++num;
     }
 
@@ -212,78 +433,46 @@ namespace OpenLogReplicator {
             processBeginMessage(scn, sequence, timestamp);
 
         if ((messageFormat & MESSAGE_FORMAT_FULL) != 0) {
-            if (redoResponsePB == nullptr)
+            if (msg == nullptr)
                 throw RuntimeException(50018, "PB delete processing failed, a message is missing");
         } else {
             builderBegin(scn, sequence, obj, 0);
-            createResponse();
             appendHeader(scn, timestamp, true, (dbFormat & DB_FORMAT_ADD_DML) != 0, true);
         }
 
-        redoResponsePB->add_payload();
-        payloadPB = redoResponsePB->mutable_payload(redoResponsePB->payload_size() - 1);
-        payloadPB->set_op(pb::DELETE);
-
-        schemaPB = payloadPB->mutable_schema();
+        appendPayloadBegin(pb::DELETE);
         appendSchema(table, obj);
         appendRowid(dataObj, bdba, slot);
         appendBefore(lobCtx, xmlCtx, table, offset);
+        endLength(payloadLength);
 
-        if ((messageFormat & MESSAGE_FORMAT_FULL) == 0) {
-            std::string output;
-            bool ret = redoResponsePB->SerializeToString(&output);
-            delete redoResponsePB;
-            redoResponsePB = nullptr;
-
-            if (!ret)
-                throw RuntimeException(50017, "PB delete processing failed, error serializing to string");
-            append(output);
+        if ((messageFormat & MESSAGE_FORMAT_FULL) == 0)
             builderCommit(false);
-        }
         ++num;
     }
 
-    void BuilderProtobuf::processDdl(typeScn scn, typeSeq sequence, time_t timestamp, const OracleTable* table __attribute__((unused)), typeObj obj,
+    void BuilderProtobuf::processDdl(typeScn scn, typeSeq sequence, time_t timestamp, const OracleTable* table, typeObj obj,
                                      typeDataObj dataObj __attribute__((unused)), uint16_t type __attribute__((unused)), uint16_t seq __attribute__((unused)),
                                      const char* sql, uint64_t sqlLength) {
         if (newTran)
             processBeginMessage(scn, sequence, timestamp);
 
         if ((messageFormat & MESSAGE_FORMAT_FULL) != 0) {
-            if (redoResponsePB == nullptr)
+            if (msg == nullptr)
                 throw RuntimeException(50018, "PB commit processing failed, a message is missing");
         } else {
             builderBegin(scn, sequence, obj, 0);
-            createResponse();
             appendHeader(scn, timestamp, true, (dbFormat & DB_FORMAT_ADD_DDL) != 0, true);
 
-            redoResponsePB->add_payload();
-            payloadPB = redoResponsePB->mutable_payload(redoResponsePB->payload_size() - 1);
-            payloadPB->set_op(pb::DDL);
+            appendPayloadBegin(pb::DDL);
             appendSchema(table, obj);
-            payloadPB->set_ddl(sql, sqlLength);
-        }
-
-        if ((messageFormat & MESSAGE_FORMAT_FULL) == 0) {
-            std::string output;
-            bool ret = redoResponsePB->SerializeToString(&output);
-            delete redoResponsePB;
-            redoResponsePB = nullptr;
-
-            if (!ret)
-                throw RuntimeException(50017, "PB commit processing failed, error serializing to string");
-            append(output);
+            appendFieldString(FIELD_PAYLOAD_DDL, sql, sqlLength);
+            endLength(payloadLength);
             builderCommit(true);
         }
         ++num;
     }
 
-    void BuilderProtobuf::initialize() {
-        Builder::initialize();
-
-        GOOGLE_PROTOBUF_VERIFY_VERSION;
-    }
-
     void BuilderProtobuf::processCommit(typeScn scn, typeSeq sequence, time_t timestamp) {
         // Skip empty transaction
         if (newTran) {
@@ -292,28 +481,15 @@ namespace OpenLogReplicator {
         }
 
         if ((messageFormat & MESSAGE_FORMAT_FULL) != 0) {
-            if (redoResponsePB == nullptr)
+            if (msg == nullptr)
                 throw RuntimeException(50018, "PB commit processing failed, a message is missing");
         } else {
             builderBegin(scn, sequence, 0, 0);
-            createResponse();
             appendHeader(scn, timestamp, true, (dbFormat & DB_FORMAT_ADD_DML) != 0, true);
-
-            redoResponsePB->add_payload();
-            payloadPB = redoResponsePB->mutable_payload(redoResponsePB->payload_size() - 1);
-            payloadPB->set_op(pb::COMMIT);
+            appendPayloadOp(pb::COMMIT);
         }
 
-        std::string output;
-        bool ret = redoResponsePB->SerializeToString(&output);
-        delete redoResponsePB;
-        redoResponsePB = nullptr;
-
-        if (!ret)
-            throw RuntimeException(50017, "PB commit processing failed, error serializing to string");
-        append(output);
         builderCommit(true);
-
         num = 0;
     }
 
@@ -324,24 +500,13 @@ namespace OpenLogReplicator {
         }
 
         builderBegin(scn, sequence, 0, OUTPUT_BUFFER_MESSAGE_CHECKPOINT);
-        createResponse();
         appendHeader(scn, timestamp, true, false, false);
 
-        redoResponsePB->add_payload();
-        payloadPB = redoResponsePB->mutable_payload(redoResponsePB->payload_size() - 1);
-        payloadPB->set_op(pb::CHKPT);
-        payloadPB->set_seq(sequence);
-        payloadPB->set_offset(offset);
-        payloadPB->set_redo(redo);
-
-        std::string output;
-        bool ret = redoResponsePB->SerializeToString(&output);
-        delete redoResponsePB;
-        redoResponsePB = nullptr;
-
-        if (!ret)
-            throw RuntimeException(50017, "PB commit processing failed, error serializing to string");
-        append(output);
+        appendPayloadBegin(pb::CHKPT);
+        appendFieldVarint(FIELD_PAYLOAD_SEQ, sequence);
+        appendFieldVarint(FIELD_PAYLOAD_OFFSET, offset);
+        appendFieldVarint(FIELD_PAYLOAD_REDO, redo ? 1 : 0);
+        endLength(payloadLength);
         builderCommit(true);
     }
 }
@@ -17,6 +17,9 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <cstring>
+
+#include "../common/OracleColumn.h"
 #include "../common/OracleTable.h"
 #include "../common/OraProtoBuf.pb.h"
 #include "../metadata/Metadata.h"
@@ -27,12 +30,273 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #define BUILDER_PROTOBUF_H_
 
 namespace OpenLogReplicator {
+    // Messages are encoded in protobuf wire format directly into the output buffer, field numbers are taken from OraProtoBuf.proto.
+    // Every field number is lower than 16, so every tag is encoded in one byte.
     class BuilderProtobuf final : public Builder {
     protected:
-        pb::RedoResponse* redoResponsePB;
-        pb::Value* valuePB;
-        pb::Payload* payloadPB;
-        pb::Schema* schemaPB;
+        static constexpr uint64_t WIRE_VARINT = 0;
+        static constexpr uint64_t WIRE_FIXED64 = 1;
+        static constexpr uint64_t WIRE_LENGTH = 2;
+        static constexpr uint64_t WIRE_FIXED32 = 5;
+
+        // Length of a nested message which is not known in advance is reserved as padded varint and filled when the message ends
+        static constexpr uint64_t LENGTH_RESERVED = 5;
+
+        static constexpr uint64_t FIELD_VALUE_NAME = 1;
+        static constexpr uint64_t FIELD_VALUE_INT = 2;
+        static constexpr uint64_t FIELD_VALUE_FLOAT = 3;
+        static constexpr uint64_t FIELD_VALUE_DOUBLE = 4;
+        static constexpr uint64_t FIELD_VALUE_STRING = 5;
+        static constexpr uint64_t FIELD_VALUE_BYTES = 6;
+
+        static constexpr uint64_t FIELD_COLUMN_NAME = 1;
+        static constexpr uint64_t FIELD_COLUMN_TYPE = 2;
+        static constexpr uint64_t FIELD_COLUMN_LENGTH = 3;
+        static constexpr uint64_t FIELD_COLUMN_PRECISION = 4;
+        static constexpr uint64_t FIELD_COLUMN_SCALE = 5;
+        static constexpr uint64_t FIELD_COLUMN_NULLABLE = 6;
+
+        static constexpr uint64_t FIELD_SCHEMA_OWNER = 1;
+        static constexpr uint64_t FIELD_SCHEMA_NAME = 2;
+        static constexpr uint64_t FIELD_SCHEMA_OBJ = 3;
+        static constexpr uint64_t FIELD_SCHEMA_COLUMN = 6;
+
+        static constexpr uint64_t FIELD_PAYLOAD_OP = 1;
+        static constexpr uint64_t FIELD_PAYLOAD_SCHEMA = 2;
+        static constexpr uint64_t FIELD_PAYLOAD_RID = 3;
+        static constexpr uint64_t FIELD_PAYLOAD_BEFORE = 4;
+        static constexpr uint64_t FIELD_PAYLOAD_AFTER = 5;
+        static constexpr uint64_t FIELD_PAYLOAD_DDL = 6;
+        static constexpr uint64_t FIELD_PAYLOAD_SEQ = 7;
+        static constexpr uint64_t FIELD_PAYLOAD_OFFSET = 8;
+        static constexpr uint64_t FIELD_PAYLOAD_REDO = 9;
+        static constexpr uint64_t FIELD_PAYLOAD_NUM = 10;
+
+        static constexpr uint64_t FIELD_RESPONSE_CODE = 1;
+        static constexpr uint64_t FIELD_RESPONSE_SCN = 2;
+        static constexpr uint64_t FIELD_RESPONSE_SCNS = 3;
+        static constexpr uint64_t FIELD_RESPONSE_TM = 4;
+        static constexpr uint64_t FIELD_RESPONSE_TMS = 5;
+        static constexpr uint64_t FIELD_RESPONSE_XID = 6;
+        static constexpr uint64_t FIELD_RESPONSE_XIDN = 7;
+        static constexpr uint64_t FIELD_RESPONSE_DB = 8;
+        static constexpr uint64_t FIELD_RESPONSE_PAYLOAD = 9;
+        static constexpr uint64_t FIELD_RESPONSE_C_SCN = 10;
+        static constexpr uint64_t FIELD_RESPONSE_C_IDX = 11;
+
+        struct LengthReservation {
+            uint8_t* data[LENGTH_RESERVED];
+            BuilderMsg* msg[LENGTH_RESERVED];
+            uint64_t start;
+        };
+
+        LengthReservation payloadLength;
+        LengthReservation schemaLength;
+        LengthReservation lobValueLength;
+        LengthReservation lobDataLength;
+        uint64_t valueField;
+
+        static inline uint64_t varintLength(uint64_t value) {
+            uint64_t length = 1;
+            while (value >= 0x80) {
+                value >>= 7;
+                ++length;
+            }
+            return length;
+        }
+
+        // Fields with default value are not sent
+        static inline uint64_t fieldVarintLength(uint64_t value) {
+            if (value == 0)
+                return 0;
+            return 1 + varintLength(value);
+        }
+
+        static inline uint64_t fieldLength(uint64_t length) {
+            if (length == 0)
+                return 0;
+            return 1 + varintLength(length) + length;
+        }
+
+        static inline uint64_t formatDec(char* buffer, uint64_t value, uint64_t digits) {
+            char tmp[21];
+            uint64_t length = 0;
+            while (value > 0 || length < digits) {
+                tmp[length++] = Ctx::map10(value % 10);
+                value /= 10;
+            }
+            for (uint64_t i = 0; i < length; ++i)
+                buffer[i] = tmp[length - i - 1];
+            return length;
+        }
+
+        static inline uint64_t formatSDec(char* buffer, int64_t value) {
+            if (value < 0) {
+                buffer[0] = '-';
+                return 1 + formatDec(buffer + 1, -static_cast<uint64_t>(value), 1);
+            }
+            return formatDec(buffer, static_cast<uint64_t>(value), 1);
+        }
+
+        static inline uint64_t formatHex(char* buffer, uint64_t value, uint64_t digits) {
+            char tmp[17];
+            uint64_t length = 0;
+            while (value > 0 || length < digits) {
+                tmp[length++] = Ctx::map16(value & 0xF);
+                value >>= 4;
+            }
+            for (uint64_t i = 0; i < length; ++i)
+                buffer[i] = tmp[length - i - 1];
+            return length;
+        }
+
+        // Timestamp in nanoseconds which does not fit in 64 bits is formatted as text
+        static inline uint64_t formatNano(char* buffer, time_t timestamp, uint64_t fraction) {
+            if (timestamp < 1000000000 && timestamp > -1000000000)
+                return formatSDec(buffer, timestamp * 1000000000L + static_cast<int64_t>(fraction));
+
+            int64_t firstDigits = timestamp / 1000000000;
+            auto signedFraction = static_cast<int64_t>(fraction);
+            if (timestamp < 0) {
+                timestamp = -timestamp;
+                signedFraction = -signedFraction;
+            }
+            timestamp %= 1000000000;
+            uint64_t length = formatSDec(buffer, firstDigits);
+            return length + formatDec(buffer + length, static_cast<uint64_t>(timestamp * 1000000000L + signedFraction), 18);
+        }
+
+        inline void appendVarint(uint64_t value) {
+            if (lastBuilderQueue->length + messagePosition + 10 < OUTPUT_BUFFER_DATA_SIZE) {
+                uint8_t* ptr = lastBuilderQueue->data + lastBuilderQueue->length + messagePosition;
+                while (value >= 0x80) {
+                    *ptr++ = static_cast<uint8_t>(value | 0x80);
+                    value >>= 7;
+                }
+                *ptr++ = static_cast<uint8_t>(value);
+                messagePosition = static_cast<uint64_t>(ptr - lastBuilderQueue->data) - lastBuilderQueue->length;
+            } else {
+                while (value >= 0x80) {
+                    append(static_cast<char>(value | 0x80));
+                    value >>= 7;
+                }
+                append(static_cast<char>(value));
+            }
+        }
+
+        inline void appendFixed(uint64_t value, uint64_t bytes) {
+            if (lastBuilderQueue->length + messagePosition + bytes < OUTPUT_BUFFER_DATA_SIZE) {
+                uint8_t* ptr = lastBuilderQueue->data + lastBuilderQueue->length + messagePosition;
+                for (uint64_t i = 0; i < bytes; ++i) {
+                    ptr[i] = static_cast<uint8_t>(value);
+                    value >>= 8;
+                }
+                messagePosition += bytes;
+            } else {
+                for (uint64_t i = 0; i < bytes; ++i) {
+                    append(static_cast<char>(value));
+                    value >>= 8;
+                }
+            }
+        }
+
+        inline void appendTag(uint64_t field, uint64_t wireType) {
+            append(static_cast<char>((field << 3) | wireType));
+        }
+
+        inline void appendFieldVarint(uint64_t field, uint64_t value) {
+            if (value == 0)
+                return;
+            appendTag(field, WIRE_VARINT);
+            appendVarint(value);
+        }
+
+        inline void appendFieldString(uint64_t field, const char* str, uint64_t length) {
+            appendTag(field, WIRE_LENGTH);
+            appendVarint(length);
+            append(str, length);
+        }
+
+        inline void appendFieldString(uint64_t field, const std::string& str) {
+            if (str.empty())
+                return;
+            appendFieldString(field, str.c_str(), str.length());
+        }
+
+        inline void beginLength(LengthReservation& reservation) {
+            for (uint64_t i = 0; i < LENGTH_RESERVED; ++i) {
+                reservation.data[i] = lastBuilderQueue->data + lastBuilderQueue->length + messagePosition;
+                reservation.msg[i] = msg;
+                append(static_cast<char>(0));
+            }
+            reservation.start = messageLength + messagePosition;
+        }
+
+        inline void endLength(const LengthReservation& reservation) {
+            uint64_t length = messageLength + messagePosition - reservation.start;
+            for (uint64_t i = 0; i < LENGTH_RESERVED; ++i) {
+                uint8_t* ptr = reservation.data[i];
+                // The message has been moved to a new buffer after the byte was reserved
+                if (reservation.msg[i] != msg)
+                    ptr = reinterpret_cast<uint8_t*>(msg) + (ptr - reinterpret_cast<uint8_t*>(reservation.msg[i]));
+                if (i < LENGTH_RESERVED - 1)
+                    *ptr = static_cast<uint8_t>(length | 0x80);
+                else
+                    *ptr = static_cast<uint8_t>(length & 0x7F);
+                length >>= 7;
+            }
+        }
+
+        inline void appendPayloadBegin(uint64_t op) {
+            appendTag(FIELD_RESPONSE_PAYLOAD, WIRE_LENGTH);
+            beginLength(payloadLength);
+            appendFieldVarint(FIELD_PAYLOAD_OP, op);
+        }
+
+        inline void appendPayloadOp(uint64_t op) {
+            appendTag(FIELD_RESPONSE_PAYLOAD, WIRE_LENGTH);
+            appendVarint(fieldVarintLength(op));
+            appendFieldVarint(FIELD_PAYLOAD_OP, op);
+        }
+
+        inline void appendValueBegin(const std::string& columnName, uint64_t datumLength) {
+            appendTag(valueField, WIRE_LENGTH);
+            appendVarint(fieldLength(columnName.length()) + datumLength);
+            appendFieldString(FIELD_VALUE_NAME, columnName);
+        }
+
+        inline void appendValueInt(const std::string& columnName, int64_t value) {
+            auto data = static_cast<uint64_t>(value);
+            appendValueBegin(columnName, 1 + varintLength(data));
+            appendTag(FIELD_VALUE_INT, WIRE_VARINT);
+            appendVarint(data);
+        }
+
+        inline void appendValueFloat(const std::string& columnName, float value) {
+            uint32_t data;
+            memcpy(reinterpret_cast<void*>(&data), reinterpret_cast<const void*>(&value), sizeof(data));
+            appendValueBegin(columnName, 1 + sizeof(data));
+            appendTag(FIELD_VALUE_FLOAT, WIRE_FIXED32);
+            appendFixed(data, sizeof(data));
+        }
+
+        inline void appendValueDouble(const std::string& columnName, double value) {
+            uint64_t data;
+            memcpy(reinterpret_cast<void*>(&data), reinterpret_cast<const void*>(&value), sizeof(data));
+            appendValueBegin(columnName, 1 + sizeof(data));
+            appendTag(FIELD_VALUE_DOUBLE, WIRE_FIXED64);
+            appendFixed(data, sizeof(data));
+        }
+
+        inline void appendValueString(const std::string& columnName, uint64_t field, const char* str, uint64_t length, const char* suffix = nullptr,
+                                      uint64_t suffixLength = 0) {
+            appendValueBegin(columnName, 1 + varintLength(length + suffixLength) + length + suffixLength);
+            appendTag(field, WIRE_LENGTH);
+            appendVarint(length + suffixLength);
+            append(str, length);
+            if (suffixLength > 0)
+                append(suffix, suffixLength);
+        }
 
         inline void columnNull(const OracleTable* table, typeCol col, bool after) {
             if (table != nullptr && unknownType == UNKNOWN_TYPE_HIDE) {
@@ -70,16 +334,16 @@ namespace OpenLogReplicator {
 
             if (table == nullptr || ctx->flagsSet(Ctx::REDO_FLAGS_RAW_COLUMN_DATA)) {
                 std::string columnName("COL_" + std::to_string(col));
-                valuePB->set_name(columnName);
+                appendValueBegin(columnName, 0);
                 return;
             }
 
-            valuePB->set_name(table->columns[col]->name);
+            appendValueBegin(table->columns[col]->name, 0);
         }
 
         inline void appendRowid(typeDataObj dataObj, typeDba bdba, typeSlot slot) {
             if ((messageFormat & MESSAGE_FORMAT_ADD_SEQUENCES) != 0)
-                payloadPB->set_num(num);
+                appendFieldVarint(FIELD_PAYLOAD_NUM, num);
 
             if (ridFormat == RID_FORMAT_SKIP)
                 return;
@@ -87,246 +351,259 @@ namespace OpenLogReplicator {
                 typeRowId rowId(dataObj, bdba, slot);
                 char str[19];
                 rowId.toString(str);
-                payloadPB->set_rid(str, 18);
+                appendFieldString(FIELD_PAYLOAD_RID, str, 18);
             }
         }
 
         inline void appendHeader(typeScn scn, time_t timestamp, bool first, bool showDb, bool showXid) {
-            redoResponsePB->set_code(pb::ResponseCode::PAYLOAD);
+            appendFieldVarint(FIELD_RESPONSE_CODE, pb::ResponseCode::PAYLOAD);
             if (first || (scnAll & SCN_ALL_PAYLOADS) != 0) {
                 if ((scnFormat & SCN_FORMAT_TEXT_HEX) != 0) {
                     char buf[17];
                     numToString(scn, buf, 16);
-                    redoResponsePB->set_scns(buf);
+                    appendFieldString(FIELD_RESPONSE_SCNS, buf, 16);
                 } else {
-                    redoResponsePB->set_scn(scn);
+                    appendTag(FIELD_RESPONSE_SCN, WIRE_VARINT);
+                    appendVarint(scn);
                 }
             }
 
             if (first || (timestampAll & TIMESTAMP_ALL_PAYLOADS) != 0) {
-                std::string str;
+                char buffer[22];
                 switch (timestampFormat) {
                     case TIMESTAMP_FORMAT_UNIX_NANO:
-                        redoResponsePB->set_tm(timestamp * 1000000000L);
+                        appendTag(FIELD_RESPONSE_TM, WIRE_VARINT);
+                        appendVarint(static_cast<uint64_t>(timestamp * 1000000000L));
                         break;
 
                     case TIMESTAMP_FORMAT_UNIX_MICRO:
-                        redoResponsePB->set_tm(timestamp * 1000000L);
+                        appendTag(FIELD_RESPONSE_TM, WIRE_VARINT);
+                        appendVarint(static_cast<uint64_t>(timestamp * 1000000L));
                         break;
 
                     case TIMESTAMP_FORMAT_UNIX_MILLI:
-                        redoResponsePB->set_tm(timestamp * 1000L);
+                        appendTag(FIELD_RESPONSE_TM, WIRE_VARINT);
+                        appendVarint(static_cast<uint64_t>(timestamp * 1000L));
                         break;
 
                     case TIMESTAMP_FORMAT_UNIX:
-                        redoResponsePB->set_tm(timestamp);
+                        appendTag(FIELD_RESPONSE_TM, WIRE_VARINT);
+                        appendVarint(static_cast<uint64_t>(timestamp));
                         break;
 
                     case TIMESTAMP_FORMAT_UNIX_NANO_STRING:
-                        str = std::to_string(timestamp * 1000000000L);
-                        redoResponsePB->set_tms(str);
+                        appendFieldString(FIELD_RESPONSE_TMS, buffer, formatSDec(buffer, timestamp * 1000000000L));
                         break;
 
                     case TIMESTAMP_FORMAT_UNIX_MICRO_STRING:
-                        str = std::to_string(timestamp * 1000000L);
-                        redoResponsePB->set_tms(str);
+                        appendFieldString(FIELD_RESPONSE_TMS, buffer, formatSDec(buffer, timestamp * 1000000L));
                         break;
 
                     case TIMESTAMP_FORMAT_UNIX_MILLI_STRING:
-                        str = std::to_string(timestamp * 1000L);
-                        redoResponsePB->set_tms(str);
+                        appendFieldString(FIELD_RESPONSE_TMS, buffer, formatSDec(buffer, timestamp * 1000L));
                         break;
 
                     case TIMESTAMP_FORMAT_UNIX_STRING:
-                        str = std::to_string(timestamp);
-                        redoResponsePB->set_tms(str);
+                        appendFieldString(FIELD_RESPONSE_TMS, buffer, formatSDec(buffer, timestamp));
                         break;
 
                     case TIMESTAMP_FORMAT_ISO8601:
-                        char buffer[22];
-                        str.assign(buffer, ctx->epochToIso8601(timestamp, buffer, true, true));
-                        redoResponsePB->set_tms(str);
+                        appendFieldString(FIELD_RESPONSE_TMS, buffer, ctx->epochToIso8601(timestamp, buffer, true, true));
                         break;
                 }
             }
 
-            redoResponsePB->set_c_scn(lwnScn);
-            redoResponsePB->set_c_idx(lwnIdx);
+            appendFieldVarint(FIELD_RESPONSE_C_SCN, lwnScn);
+            appendFieldVarint(FIELD_RESPONSE_C_IDX, lwnIdx);
 
             if (showXid) {
                 if (xidFormat == XID_FORMAT_TEXT_HEX) {
-                    std::ostringstream ss;
-                    ss << "0x";
-                    ss << std::setfill('0') << std::setw(4) << std::hex << static_cast<uint64_t>(lastXid.usn());
-                    ss << '.';
-                    ss << std::setfill('0') << std::setw(3) << std::hex << static_cast<uint64_t>(lastXid.slt());
-                    ss << '.';
-                    ss << std::setfill('0') << std::setw(8) << std::hex << static_cast<uint64_t>(lastXid.sqn());
-                    redoResponsePB->set_xid(ss.str());
+                    // 0x0001.002.00000003
+                    char buffer[32];
+                    uint64_t length = 2;
+                    buffer[0] = '0';
+                    buffer[1] = 'x';
+                    length += formatHex(buffer + length, lastXid.usn(), 4);
+                    buffer[length++] = '.';
+                    length += formatHex(buffer + length, lastXid.slt(), 3);
+                    buffer[length++] = '.';
+                    length += formatHex(buffer + length, lastXid.sqn(), 8);
+                    appendFieldString(FIELD_RESPONSE_XID, buffer, length);
                 } else if (xidFormat == XID_FORMAT_TEXT_DEC) {
-                    std::ostringstream ss;
-                    ss << static_cast<uint64_t>(lastXid.usn());
-                    ss << '.';
-                    ss << static_cast<uint64_t>(lastXid.slt());
-                    ss << '.';
-                    ss << static_cast<uint64_t>(lastXid.sqn());
-                    redoResponsePB->set_xid(ss.str());
+                    // 1.2.3
+                    char buffer[32];
+                    uint64_t length = formatDec(buffer, lastXid.usn(), 1);
+                    buffer[length++] = '.';
+                    length += formatDec(buffer + length, lastXid.slt(), 1);
+                    buffer[length++] = '.';
+                    length += formatDec(buffer + length, lastXid.sqn(), 1);
+                    appendFieldString(FIELD_RESPONSE_XID, buffer, length);
                 } else if (xidFormat == XID_FORMAT_NUMERIC) {
-                    redoResponsePB->set_xidn(lastXid.getData());
+                    appendTag(FIELD_RESPONSE_XIDN, WIRE_VARINT);
+                    appendVarint(lastXid.getData());
                 }
             }
 
             if (showDb)
-                redoResponsePB->set_db(metadata->conName);
+                appendFieldString(FIELD_RESPONSE_DB, metadata->conName);
+        }
+
+        inline void appendColumn(const OracleColumn* column) {
+            uint64_t type;
+            int64_t length = 0;
+            int64_t precision = 0;
+            int64_t scale = 0;
+
+            switch (column->type) {
+                case SysCol::TYPE_VARCHAR:
+                    type = pb::VARCHAR2;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                case SysCol::TYPE_NUMBER:
+                    type = pb::NUMBER;
+                    precision = static_cast<int32_t>(column->precision);
+                    scale = static_cast<int32_t>(column->scale);
+                    break;
+
+                case SysCol::TYPE_LONG:
+                    // Long, not supported
+                    type = pb::LONG;
+                    break;
+
+                case SysCol::TYPE_DATE:
+                    type = pb::DATE;
+                    break;
+
+                case SysCol::TYPE_RAW:
+                    type = pb::RAW;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                case SysCol::TYPE_LONG_RAW: // Not supported
+                    type = pb::LONG_RAW;
+                    break;
+
+                case SysCol::TYPE_CHAR:
+                    type = pb::CHAR;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                case SysCol::TYPE_FLOAT:
+                    type = pb::BINARY_FLOAT;
+                    break;
+
+                case SysCol::TYPE_DOUBLE:
+                    type = pb::BINARY_DOUBLE;
+                    break;
+
+                case SysCol::TYPE_CLOB:
+                    type = pb::CLOB;
+                    break;
+
+                case SysCol::TYPE_BLOB:
+                    type = pb::BLOB;
+                    break;
+
+                case SysCol::TYPE_TIMESTAMP:
+                    type = pb::TIMESTAMP;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                case SysCol::TYPE_TIMESTAMP_WITH_TZ:
+                    type = pb::TIMESTAMP_WITH_TZ;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                case SysCol::TYPE_INTERVAL_YEAR_TO_MONTH:
+                    type = pb::INTERVAL_YEAR_TO_MONTH;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                case SysCol::TYPE_INTERVAL_DAY_TO_SECOND:
+                    type = pb::INTERVAL_DAY_TO_SECOND;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                case SysCol::TYPE_UROWID:
+                    type = pb::UROWID;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                case SysCol::TYPE_TIMESTAMP_WITH_LOCAL_TZ:
+                    type = pb::TIMESTAMP_WITH_LOCAL_TZ;
+                    length = static_cast<int32_t>(column->length);
+                    break;
+
+                default:
+                    type = pb::UNKNOWN;
+                    break;
+            }
+
+            // Negative int32 values are sign extended to 64 bits
+            appendTag(FIELD_SCHEMA_COLUMN, WIRE_LENGTH);
+            appendVarint(fieldLength(column->name.length()) + fieldVarintLength(type) + fieldVarintLength(static_cast<uint64_t>(length)) +
+                         fieldVarintLength(static_cast<uint64_t>(precision)) + fieldVarintLength(static_cast<uint64_t>(scale)) +
+                         fieldVarintLength(column->nullable ? 1 : 0));
+            appendFieldString(FIELD_COLUMN_NAME, column->name);
+            appendFieldVarint(FIELD_COLUMN_TYPE, type);
+            appendFieldVarint(FIELD_COLUMN_LENGTH, static_cast<uint64_t>(length));
+            appendFieldVarint(FIELD_COLUMN_PRECISION, static_cast<uint64_t>(precision));
+            appendFieldVarint(FIELD_COLUMN_SCALE, static_cast<uint64_t>(scale));
+            appendFieldVarint(FIELD_COLUMN_NULLABLE, column->nullable ? 1 : 0);
         }
 
         inline void appendSchema(const OracleTable* table, typeObj obj) {
+            appendTag(FIELD_PAYLOAD_SCHEMA, WIRE_LENGTH);
+            beginLength(schemaLength);
+
             if (table == nullptr) {
                 std::string ownerName;
                 std::string tableName;
                 // try to read object name from ongoing uncommitted transaction data
                 if (metadata->schema->checkTableDictUncommitted(obj, ownerName, tableName)) {
-                    schemaPB->set_owner(ownerName);
-                    schemaPB->set_name(tableName);
+                    appendFieldString(FIELD_SCHEMA_OWNER, ownerName);
+                    appendFieldString(FIELD_SCHEMA_NAME, tableName);
                 } else {
                     tableName = "OBJ_" + std::to_string(obj);
-                    schemaPB->set_name(tableName);
+                    appendFieldString(FIELD_SCHEMA_NAME, tableName);
                 }
 
                 if ((schemaFormat & SCHEMA_FORMAT_OBJ) != 0)
-                    schemaPB->set_obj(obj);
+                    appendFieldVarint(FIELD_SCHEMA_OBJ, obj);
 
+                endLength(schemaLength);
                 return;
             }
 
-            schemaPB->set_owner(table->owner);
-            schemaPB->set_name(table->name);
+            appendFieldString(FIELD_SCHEMA_OWNER, table->owner);
+            appendFieldString(FIELD_SCHEMA_NAME, table->name);
 
             if ((schemaFormat & SCHEMA_FORMAT_OBJ) != 0)
-                schemaPB->set_obj(obj);
-
-            if ((schemaFormat & SCHEMA_FORMAT_FULL) != 0) {
-                if ((schemaFormat & SCHEMA_FORMAT_REPEATED) == 0) {
-                    if (tables.count(table) > 0)
-                        return;
-                    else
-                        tables.insert(table);
-                }
-
-                schemaPB->add_column();
-                pb::Column* columnPB = schemaPB->mutable_column(schemaPB->column_size() - 1);
+                appendFieldVarint(FIELD_SCHEMA_OBJ, obj);
 
+            if ((schemaFormat & SCHEMA_FORMAT_FULL) != 0 && ((schemaFormat & SCHEMA_FORMAT_REPEATED) != 0 || tables.insert(table).second)) {
                 for (typeCol column = 0; column < static_cast<typeCol>(table->columns.size()); ++column) {
                     if (table->columns[column] == nullptr)
                         continue;
 
-                    columnPB->set_name(table->columns[column]->name);
-
-                    switch (table->columns[column]->type) {
-                        case SysCol::TYPE_VARCHAR:
-                            columnPB->set_type(pb::VARCHAR2);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        case SysCol::TYPE_NUMBER:
-                            columnPB->set_type(pb::NUMBER);
-                            columnPB->set_precision(static_cast<int32_t>(table->columns[column]->precision));
-                            columnPB->set_scale(static_cast<int32_t>(table->columns[column]->scale));
-                            break;
-
-                        case SysCol::TYPE_LONG:
-                            // Long, not supported
-                            columnPB->set_type(pb::LONG);
-                            break;
-
-                        case SysCol::TYPE_DATE:
-                            columnPB->set_type(pb::DATE);
-                            break;
-
-                        case SysCol::TYPE_RAW:
-                            columnPB->set_type(pb::RAW);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        case SysCol::TYPE_LONG_RAW: // Not supported
-                            columnPB->set_type(pb::LONG_RAW);
-                            break;
-
-                        case SysCol::TYPE_CHAR:
-                            columnPB->set_type(pb::CHAR);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        case SysCol::TYPE_FLOAT:
-                            columnPB->set_type(pb::BINARY_FLOAT);
-                            break;
-
-                        case SysCol::TYPE_DOUBLE:
-                            columnPB->set_type(pb::BINARY_DOUBLE);
-                            break;
-
-                        case SysCol::TYPE_CLOB:
-                            columnPB->set_type(pb::CLOB);
-                            break;
-
-                        case SysCol::TYPE_BLOB:
-                            columnPB->set_type(pb::BLOB);
-                            break;
-
-                        case SysCol::TYPE_TIMESTAMP:
-                            columnPB->set_type(pb::TIMESTAMP);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        case SysCol::TYPE_TIMESTAMP_WITH_TZ:
-                            columnPB->set_type(pb::TIMESTAMP_WITH_TZ);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        case SysCol::TYPE_INTERVAL_YEAR_TO_MONTH:
-                            columnPB->set_type(pb::INTERVAL_YEAR_TO_MONTH);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        case SysCol::TYPE_INTERVAL_DAY_TO_SECOND:
-                            columnPB->set_type(pb::INTERVAL_DAY_TO_SECOND);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        case SysCol::TYPE_UROWID:
-                            columnPB->set_type(pb::UROWID);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        case SysCol::TYPE_TIMESTAMP_WITH_LOCAL_TZ:
-                            columnPB->set_type(pb::TIMESTAMP_WITH_LOCAL_TZ);
-                            columnPB->set_length(static_cast<int32_t>(table->columns[column]->length));
-                            break;
-
-                        default:
-                            columnPB->set_type(pb::UNKNOWN);
-                            break;
-                    }
-
-                    columnPB->set_nullable(table->columns[column]->nullable);
+                    appendColumn(table->columns[column]);
                 }
             }
+
+            endLength(schemaLength);
         }
 
         inline void appendAfter(LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, uint64_t offset) {
+            valueField = FIELD_PAYLOAD_AFTER;
             if (columnFormat > 0 && table != nullptr) {
                 for (typeCol column = 0; column < table->maxSegCol; ++column) {
                     if (values[column][VALUE_AFTER] != nullptr) {
-                        if (lengths[column][VALUE_AFTER] > 0) {
-                            payloadPB->add_after();
-                            valuePB = payloadPB->mutable_after(payloadPB->after_size() - 1);
+                        if (lengths[column][VALUE_AFTER] > 0)
                             processValue(lobCtx, xmlCtx, table, column, values[column][VALUE_AFTER], lengths[column][VALUE_AFTER], offset,
                                          true, compressedAfter);
-                        } else {
-                            payloadPB->add_after();
-                            valuePB = payloadPB->mutable_after(payloadPB->after_size() - 1);
+                        else
                             columnNull(table, column, true);
-                        }
                     }
                 }
             } else {
@@ -340,16 +617,11 @@ namespace OpenLogReplicator {
                             continue;
 
                         if (values[column][VALUE_AFTER] != nullptr) {
-                            if (lengths[column][VALUE_AFTER] > 0) {
-                                payloadPB->add_after();
-                                valuePB = payloadPB->mutable_after(payloadPB->after_size() - 1);
+                            if (lengths[column][VALUE_AFTER] > 0)
                                 processValue(lobCtx, xmlCtx, table, column, values[column][VALUE_AFTER], lengths[column][VALUE_AFTER], offset,
                                              true, compressedAfter);
-                            } else {
-                                payloadPB->add_after();
-                                valuePB = payloadPB->mutable_after(payloadPB->after_size() - 1);
+                            else
                                 columnNull(table, column, true);
-                            }
                         }
                     }
                 }
@@ -357,19 +629,15 @@ namespace OpenLogReplicator {
         }
 
         inline void appendBefore(LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, uint64_t offset) {
+            valueField = FIELD_PAYLOAD_BEFORE;
             if (columnFormat > 0 && table != nullptr) {
                 for (typeCol column = 0; column < table->maxSegCol; ++column) {
                     if (values[column][VALUE_BEFORE] != nullptr) {
-                        if (lengths[column][VALUE_BEFORE] > 0) {
-                            payloadPB->add_before();
-                            valuePB = payloadPB->mutable_before(payloadPB->before_size() - 1);
+                        if (lengths[column][VALUE_BEFORE] > 0)
                             processValue(lobCtx, xmlCtx, table, column, values[column][VALUE_BEFORE], lengths[column][VALUE_BEFORE], offset,
                                          false, compressedBefore);
-                        } else {
-                            payloadPB->add_before();
-                            valuePB = payloadPB->mutable_before(payloadPB->before_size() - 1);
+                        else
                             columnNull(table, column, false);
-                        }
                     }
                 }
             } else {
@@ -383,28 +651,17 @@ namespace OpenLogReplicator {
                             continue;
 
                         if (values[column][VALUE_BEFORE] != nullptr) {
-                            if (lengths[column][VALUE_BEFORE] > 0) {
-                                payloadPB->add_before();
-                                valuePB = payloadPB->mutable_before(payloadPB->before_size() - 1);
+                            if (lengths[column][VALUE_BEFORE] > 0)
                                 processValue(lobCtx, xmlCtx, table, column, values[column][VALUE_BEFORE], lengths[column][VALUE_BEFORE], offset,
                                              false, compressedBefore);
-                            } else {
-                                payloadPB->add_before();
-                                valuePB = payloadPB->mutable_before(payloadPB->before_size() - 1);
+                            else
                                 columnNull(table, column, false);
-                            }
                         }
                     }
                 }
             }
         }
 
-        inline void createResponse() {
-            if (redoResponsePB != nullptr)
-                throw RuntimeException(50016, "PB commit processing failed, message already exists");
-            redoResponsePB = new pb::RedoResponse;
-        }
-
         void numToString(uint64_t value, char* buf, uint64_t length) {
             uint64_t j = (length - 1) * 4;
             for (uint64_t i = 0; i < length; ++i) {
@@ -414,14 +671,17 @@ namespace OpenLogReplicator {
             buf[length] = 0;
         }
 
-        virtual void columnFloat(const std::string& columnName, double value) override;
-        virtual void columnDouble(const std::string& columnName, long double value) override;
-        virtual void columnString(const std::string& columnName) override;
-        virtual void columnNumber(const std::string& columnName, uint64_t precision, uint64_t scale) override;
-        virtual void columnRaw(const std::string& columnName, const uint8_t* data, uint64_t length) override;
-        virtual void columnRowId(const std::string& columnName, typeRowId rowId) override;
-        virtual void columnTimestamp(const std::string& columnName, time_t timestamp, uint64_t fraction) override;
-        virtual void columnTimestampTz(const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) override;
+        virtual void columnFloat(const OracleColumn* column, const std::string& columnName, double value) override;
+        virtual void columnDouble(const OracleColumn* column, const std::string& columnName, long double value) override;
+        virtual void columnString(const OracleColumn* column, const std::string& columnName) override;
+        virtual void columnNumber(const OracleColumn* column, const std::string& columnName, uint64_t precision, uint64_t scale) override;
+        virtual void columnRaw(const OracleColumn* column, const std::string& columnName, const uint8_t* data, uint64_t length) override;
+        virtual void columnLobBegin(const OracleColumn* column, const std::string& columnName, bool isClob) override;
+        virtual void columnLobAppend(bool isClob) override;
+        virtual void columnLobEnd(bool isClob) override;
+        virtual void columnRowId(const OracleColumn* column, const std::string& columnName, typeRowId rowId) override;
+        virtual void columnTimestamp(const OracleColumn* column, const std::string& columnName, time_t timestamp, uint64_t fraction) override;
+        virtual void columnTimestampTz(const OracleColumn* column, const std::string& columnName, time_t timestamp, uint64_t fraction, const char* tz) override;
         virtual void processInsert(typeScn scn, typeSeq sequence, time_t timestamp, LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, typeObj obj,
                                    typeDataObj dataObj, typeDba bdba, typeSlot slot, typeXid xid, uint64_t offset) override;
         virtual void processUpdate(typeScn scn, typeSeq sequence, time_t timestamp, LobCtx* lobCtx, const XmlCtx* xmlCtx, const OracleTable* table, typeObj obj,
@@ -437,10 +697,9 @@ namespace OpenLogReplicator {
                         uint64_t newIntervalDtsFormat, uint64_t newIntervalYtmFormat, uint64_t newMessageFormat, uint64_t newRidFormat, uint64_t newXidFormat,
                         uint64_t newTimestampFormat, uint64_t newTimestampTzFormat, uint64_t newTimestampAll, uint64_t newCharFormat, uint64_t newScnFormat,
                         uint64_t newScnAll, uint64_t newUnknownFormat, uint64_t newSchemaFormat, uint64_t newColumnFormat, uint64_t newUnknownType,
-                        uint64_t newFlushBuffer);
+                        uint64_t newLobFormat, uint64_t newFlushBuffer);
         virtual ~BuilderProtobuf() override;
 
-        virtual void initialize() override;
         virtual void processCommit(typeScn scn, typeSeq sequence, time_t timestamp) override;
         virtual void processCheckpoint(typeScn scn, typeSeq sequence, time_t timestamp, uint64_t offset, bool redo) override;
     };
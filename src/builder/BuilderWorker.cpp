@@ -0,0 +1,103 @@
+/* Thread formatting committed transactions for the builder pool
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <thread>
+
+#include "../common/Ctx.h"
+#include "../common/exception/DataException.h"
+#include "../common/exception/RedoLogException.h"
+#include "../common/exception/RuntimeException.h"
+#include "../parser/Transaction.h"
+#include "Builder.h"
+#include "BuilderPool.h"
+#include "BuilderWorker.h"
+
+namespace OpenLogReplicator {
+    BuilderWorker::BuilderWorker(Ctx* newCtx, const std::string& newAlias, BuilderPool* newPool, Builder* newBuilder) :
+            Thread(newCtx, newAlias),
+            pool(newPool),
+            builder(newBuilder) {
+        builder->workerPool = pool;
+        builder->setMaxMessageMb(pool->builder->getMaxMessageMb());
+    }
+
+    BuilderWorker::~BuilderWorker() = default;
+
+    void BuilderWorker::wakeUp() {
+        pool->wakeUp();
+    }
+
+    void BuilderWorker::run() {
+        if (ctx->trace & Ctx::TRACE_THREADS) {
+            std::ostringstream ss;
+            ss << std::this_thread::get_id();
+            ctx->logTrace(Ctx::TRACE_THREADS, "builder (" + ss.str() + ") start");
+        }
+
+        BuilderJob job{0, nullptr, 0, 0, 0, 0, false};
+        try {
+            while (pool->getJob(job)) {
+                builder->workerTicket = job.ticket;
+                try {
+                    job.transaction->flush(pool->metadata, pool->transactionBuffer, builder, job.scn);
+                } catch (DataException& ex) {
+                    if (!ctx->flagsSet(Ctx::REDO_FLAGS_IGNORE_DATA_ERRORS))
+                        throw DataException(ex.code, "runtime error, aborting further redo log processing: " + ex.msg);
+                    ctx->error(ex.code, ex.msg);
+                    ctx->warning(60013, "forced to continue working in spite of error");
+                    builder->resetQueue();
+                } catch (RedoLogException& ex) {
+                    if (!ctx->flagsSet(Ctx::REDO_FLAGS_IGNORE_DATA_ERRORS))
+                        throw RedoLogException(ex.code, "runtime error, aborting further redo log processing: " + ex.msg);
+                    ctx->error(ex.code, ex.msg);
+                    ctx->warning(60013, "forced to continue working in spite of error");
+                    builder->resetQueue();
+                }
+
+                pool->publish(job, builder);
+                job.transaction->purge(pool->transactionBuffer);
+                delete job.transaction;
+                job.transaction = nullptr;
+            }
+        } catch (DataException& ex) {
+            ctx->error(ex.code, ex.msg);
+            ctx->stopHard();
+        } catch (RedoLogException& ex) {
+            ctx->error(ex.code, ex.msg);
+            ctx->stopHard();
+        } catch (RuntimeException& ex) {
+            ctx->error(ex.code, ex.msg);
+            ctx->stopHard();
+        } catch (std::bad_alloc& ex) {
+            ctx->error(10018, "memory allocation failed: " + std::string(ex.what()));
+            ctx->stopHard();
+        }
+
+        if (job.transaction != nullptr) {
+            job.transaction->purge(pool->transactionBuffer);
+            delete job.transaction;
+        }
+
+        if (ctx->trace & Ctx::TRACE_THREADS) {
+            std::ostringstream ss;
+            ss << std::this_thread::get_id();
+            ctx->logTrace(Ctx::TRACE_THREADS, "builder (" + ss.str() + ") stop");
+        }
+    }
+}
@@ -23,8 +23,11 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <csignal>
 #include <execinfo.h>
 #include <iostream>
+#include <cstring>
 #include <set>
 #include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include "ClockHW.h"
@@ -58,13 +61,16 @@ namespace OpenLogReplicator {
             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
-    const std::string Ctx::memoryModules[MEMORY_MODULES_NUM] = {"builder", "parser", "reader", "transaction"};
+    const std::string Ctx::memoryModules[MEMORY_MODULES_NUM] = {"builder", "lobs", "parser", "reader", "transaction"};
 
     const int64_t Ctx::cumDays[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
     const int64_t Ctx::cumDaysLeap[12] = {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335};
 
     typeIntX typeIntX::BASE10[typeIntX::DIGITS][10];
 
+    thread_local Ctx::MemoryMagazine* Ctx::memoryMagazine = nullptr;
+    thread_local MemoryQuota* Ctx::memoryQuota = nullptr;
+
     Ctx::Ctx() :
             bigEndian(false),
             memoryMinMb(0),
@@ -76,6 +82,12 @@ namespace OpenLogReplicator {
             memoryChunksMax(0),
             memoryChunksHWM(0),
             memoryChunksReusable(0),
+            memoryChunksCached(0),
+            memoryChunksWaiting(0),
+            memoryArenaMap(nullptr),
+            memoryArenaMapSize(0),
+            memoryArenaFree(nullptr),
+            memoryArenaFreeNum(0),
             mainThread(pthread_self()),
             metrics(nullptr),
             clock(nullptr),
@@ -93,14 +105,20 @@ namespace OpenLogReplicator {
             checkpointIntervalMb(500),
             checkpointKeep(100),
             schemaForceInterval(20),
+            schemaDeltaMax(10000),
             redoReadSleepUs(50000),
             redoVerifyDelayUs(0),
             archReadSleepUs(10000000),
             archReadTries(10),
+            archPrefetch(1),
+            redoReadQueueDepth(0),
             refreshIntervalUs(10000000),
             pollIntervalUs(100000),
             queueSize(65536),
             dumpPath("."),
+            swapMb(0),
+            memoryHugePages(MEMORY_HUGE_PAGES_NONE),
+            memoryNumaNode(-1),
             stopLogSwitches(0),
             stopCheckpoints(0),
             stopTransactions(0),
@@ -111,11 +129,13 @@ namespace OpenLogReplicator {
             disableChecks(0),
             hardShutdown(false),
             softShutdown(false),
-            replicatorFinished(false) {
+            replicatorFinished(false),
+            replicatorsRunning(0) {
         memoryModulesAllocated[0] = 0;
         memoryModulesAllocated[1] = 0;
         memoryModulesAllocated[2] = 0;
         memoryModulesAllocated[3] = 0;
+        memoryModulesAllocated[4] = 0;
         clock = new ClockHW();
         tzset();
         dbTimezone = BAD_TIMEZONE;
@@ -124,11 +144,18 @@ namespace OpenLogReplicator {
     }
 
     Ctx::~Ctx() {
-        lobIdToXidMap.clear();
+        memoryMagazinesReclaim();
+        for (MemoryMagazine* magazine: memoryMagazines)
+            delete magazine;
+        memoryMagazines.clear();
+
+        for (MemoryQuota* quota: memoryQuotas)
+            delete quota;
+        memoryQuotas.clear();
 
         while (memoryChunksAllocated > 0) {
             --memoryChunksAllocated;
-            free(memoryChunks[memoryChunksAllocated]);
+            memoryChunkDeallocate(memoryChunks[memoryChunksAllocated]);
             memoryChunks[memoryChunksAllocated] = nullptr;
         }
 
@@ -137,6 +164,16 @@ namespace OpenLogReplicator {
             memoryChunks = nullptr;
         }
 
+        if (memoryArenaMap != nullptr) {
+            munmap(memoryArenaMap, memoryArenaMapSize);
+            memoryArenaMap = nullptr;
+        }
+
+        if (memoryArenaFree != nullptr) {
+            delete[] memoryArenaFree;
+            memoryArenaFree = nullptr;
+        }
+
         if (metrics != nullptr) {
             metrics->shutdown();
             delete metrics;
@@ -603,11 +640,14 @@ namespace OpenLogReplicator {
         bufferSizeMax = readBufferMax * MEMORY_CHUNK_SIZE;
 
         memoryChunks = new uint8_t* [memoryMaxMb / MEMORY_CHUNK_SIZE_MB];
+        if (memoryHugePages != MEMORY_HUGE_PAGES_NONE)
+            memoryArenaCreate();
+
         for (uint64_t i = 0; i < memoryChunksMin; ++i) {
-            memoryChunks[i] = reinterpret_cast<uint8_t*>(aligned_alloc(MEMORY_ALIGNMENT, MEMORY_CHUNK_SIZE));
-            if (memoryChunks[i] == nullptr)
-                throw RuntimeException(10016, "couldn't allocate " + std::to_string(MEMORY_CHUNK_SIZE_MB) +
-                                              " bytes memory for: memory chunks#2");
+            memoryChunks[i] = memoryChunkAllocate("memory chunks#2");
+            // Pre-fault the reserved part of the pool, so that page faults don't happen during work
+            if (memoryArenaMap != nullptr)
+                memset(memoryChunks[i], 0, MEMORY_CHUNK_SIZE);
             ++memoryChunksAllocated;
             ++memoryChunksFree;
         }
@@ -629,7 +669,11 @@ namespace OpenLogReplicator {
     }
 
     uint64_t Ctx::getFreeMemory() {
-        return memoryChunksFree * MEMORY_CHUNK_SIZE_MB;
+        return (memoryChunksFree + memoryChunksCached) * MEMORY_CHUNK_SIZE_MB;
+    }
+
+    uint64_t Ctx::getUsedMemoryModule(uint64_t module) {
+        return memoryModulesAllocated[module] * MEMORY_CHUNK_SIZE_MB;
     }
 
     uint64_t Ctx::getAllocatedMemory() const {
@@ -637,17 +681,57 @@ namespace OpenLogReplicator {
     }
 
     uint8_t* Ctx::getMemoryChunk(uint64_t module, bool reusable) {
+        MemoryMagazine* magazine = memoryMagazine;
+        if (magazine != nullptr && magazine->ctx != this)
+            magazine = nullptr;
+
+        // The quota is checked without a lock, concurrent threads of the source may exceed it by a few chunks
+        MemoryQuota* quota = memoryQuota;
+        if (quota != nullptr) {
+            if (quota->chunks >= quota->chunksMax)
+                memoryQuotaWait(quota);
+            ++quota->chunks;
+            if (reusable)
+                ++quota->chunksReusable;
+        }
+
+        // Fast path: the magazine lock is only contended when some other thread runs out of memory
+        if (magazine != nullptr) {
+            std::unique_lock<std::mutex> lck(magazine->mtx);
+            if (magazine->size > 0) {
+                --magazine->size;
+                --memoryChunksCached;
+                if (reusable)
+                    ++memoryChunksReusable;
+                ++memoryModulesAllocated[module];
+                return magazine->chunks[magazine->size];
+            }
+        }
+
         std::unique_lock<std::mutex> lck(memoryMtx);
 
         if (memoryChunksFree == 0) {
-            while (memoryChunksAllocated == memoryChunksMax && !softShutdown) {
+            while (memoryChunksFree == 0 && memoryChunksAllocated == memoryChunksMax && !softShutdown) {
+                // Free chunks may be still cached by other threads
+                if (memoryMagazinesReclaim() > 0)
+                    break;
+
                 if (memoryChunksReusable > 1) {
                     warning(10067, "out of memory, but there are reusable memory chunks, trying to reuse some memory");
 
                     if (trace & TRACE_SLEEP)
                         logTrace(TRACE_SLEEP, "Ctx:getMemoryChunk");
-                    condOutOfMemory.wait(lck);
+                    // A chunk cached by the fast path before the counter was raised comes without a notification,
+                    // the magazines are reclaimed again after every wakeup
+                    ++memoryChunksWaiting;
+                    condOutOfMemory.wait_for(lck, std::chrono::milliseconds(100));
+                    --memoryChunksWaiting;
                 } else {
+                    if (quota != nullptr) {
+                        --quota->chunks;
+                        if (reusable)
+                            --quota->chunksReusable;
+                    }
                     hint("try to restart with higher value of 'memory-max-mb' parameter or if big transaction - add to 'skip-xid' list; "
                          "transaction would be skipped");
                     throw RuntimeException(10017, "out of memory");
@@ -655,16 +739,9 @@ namespace OpenLogReplicator {
             }
 
             if (memoryChunksFree == 0) {
-                memoryChunks[0] = reinterpret_cast<uint8_t*>(aligned_alloc(MEMORY_ALIGNMENT, MEMORY_CHUNK_SIZE));
-                if (memoryChunks[0] == nullptr) {
-                    throw RuntimeException(10016, "couldn't allocate " + std::to_string(MEMORY_CHUNK_SIZE_MB) +
-                                                  " bytes memory for: " + memoryModules[module]);
-                }
+                memoryChunks[0] = memoryChunkAllocate(memoryModules[module]);
                 ++memoryChunksFree;
                 ++memoryChunksAllocated;
-
-                if (metrics)
-                    metrics->emitMemoryAllocatedMb(memoryChunksAllocated);
             }
 
             if (memoryChunksAllocated > memoryChunksHWM)
@@ -672,79 +749,277 @@ namespace OpenLogReplicator {
         }
 
         --memoryChunksFree;
+        uint8_t* chunk = memoryChunks[memoryChunksFree];
         if (reusable)
             ++memoryChunksReusable;
         ++memoryModulesAllocated[module];
 
-        if (metrics) {
-            metrics->emitMemoryUsedTotalMb(memoryChunksAllocated - memoryChunksFree);
+        // Refill the magazine with chunks which are already allocated, never allocate new ones in advance
+        if (magazine != nullptr && memoryChunksWaiting == 0) {
+            std::unique_lock<std::mutex> lckMagazine(magazine->mtx);
+            while (memoryChunksFree > 0 && magazine->size < MEMORY_MAGAZINE_BATCH) {
+                --memoryChunksFree;
+                magazine->chunks[magazine->size] = memoryChunks[memoryChunksFree];
+                ++magazine->size;
+                ++memoryChunksCached;
+            }
+        }
 
-            switch (module) {
-                case MEMORY_MODULE_BUILDER:
-                    metrics->emitMemoryUsedMbBuilder(memoryModulesAllocated[module]);
-                    break;
+        memoryMetrics();
+        return chunk;
+    }
 
-                case MEMORY_MODULE_PARSER:
-                    metrics->emitMemoryUsedMbParser(memoryModulesAllocated[module]);
-                    break;
+    void Ctx::freeMemoryChunk(uint64_t module, uint8_t* chunk, bool reusable) {
+        MemoryMagazine* magazine = memoryMagazine;
+        if (magazine != nullptr && magazine->ctx != this)
+            magazine = nullptr;
+
+        MemoryQuota* quota = memoryQuota;
+        if (quota != nullptr) {
+            --quota->chunks;
+            if (reusable)
+                --quota->chunksReusable;
+        }
 
-                case MEMORY_MODULE_READER:
-                    metrics->emitMemoryUsedMbReader(memoryModulesAllocated[module]);
-                    break;
+        // Fast path: keep the chunk in the magazine unless some thread is waiting for memory
+        if (magazine != nullptr && memoryChunksWaiting == 0) {
+            std::unique_lock<std::mutex> lck(magazine->mtx);
+            if (magazine->size < MEMORY_MAGAZINE_SIZE) {
+                magazine->chunks[magazine->size] = chunk;
+                ++magazine->size;
+                ++memoryChunksCached;
+                if (reusable)
+                    --memoryChunksReusable;
+                --memoryModulesAllocated[module];
+                return;
+            }
+        }
+
+        std::unique_lock<std::mutex> lck(memoryMtx);
+
+        if (memoryChunksFree + memoryChunksCached == memoryChunksAllocated)
+            throw RuntimeException(50001, "trying to free unknown memory block for: " + memoryModules[module]);
 
-                case MEMORY_MODULE_TRANSACTIONS:
-                    metrics->emitMemoryUsedMbTransactions(memoryModulesAllocated[module]);
+        memoryChunkRelease(chunk);
+
+        // Return the excess of the magazine to the global pool
+        if (magazine != nullptr) {
+            std::unique_lock<std::mutex> lckMagazine(magazine->mtx);
+            while (magazine->size > MEMORY_MAGAZINE_BATCH) {
+                --magazine->size;
+                --memoryChunksCached;
+                memoryChunkRelease(magazine->chunks[magazine->size]);
             }
         }
 
-        return memoryChunks[memoryChunksFree];
+        if (reusable)
+            --memoryChunksReusable;
+        --memoryModulesAllocated[module];
+
+        condOutOfMemory.notify_all();
+        memoryMetrics();
     }
 
-    void Ctx::freeMemoryChunk(uint64_t module, uint8_t* chunk, bool reusable) {
-        std::unique_lock<std::mutex> lck(memoryMtx);
+    void Ctx::memoryArenaCreate() {
+        uint64_t pageSize = 2 * 1024 * 1024;
+        int mapFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+        switch (memoryHugePages) {
+            case MEMORY_HUGE_PAGES_TRANSPARENT:
+                // Huge pages are assigned on first touch, the address space is only reserved
+                mapFlags |= MAP_NORESERVE;
+                break;
 
-        if (memoryChunksFree == memoryChunksAllocated)
-            throw RuntimeException(50001, "trying to free unknown memory block for: " + memoryModules[module]);
+            case MEMORY_HUGE_PAGES_2MB:
+                mapFlags |= MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+                break;
+
+            case MEMORY_HUGE_PAGES_1GB:
+                pageSize = 1024 * 1024 * 1024;
+                mapFlags |= MAP_HUGETLB | (30 << MAP_HUGE_SHIFT);
+                break;
+        }
+
+        const uint64_t chunksNum = memoryChunksMax;
+        uint64_t arenaSize = ((chunksNum * MEMORY_CHUNK_SIZE + pageSize - 1) / pageSize) * pageSize;
+        // Transparent huge pages require the region to be aligned to the huge page size
+        if (memoryHugePages == MEMORY_HUGE_PAGES_TRANSPARENT)
+            memoryArenaMapSize = arenaSize + pageSize;
+        else
+            memoryArenaMapSize = arenaSize;
+
+        void* map = mmap(nullptr, memoryArenaMapSize, PROT_READ | PROT_WRITE, mapFlags, -1, 0);
+        if (map == MAP_FAILED) {
+            memoryArenaMapSize = 0;
+            throw RuntimeException(10072, "couldn't reserve " + std::to_string(arenaSize) + " bytes memory with huge pages - mmap returned: " +
+                                          strerror(errno));
+        }
+        memoryArenaMap = reinterpret_cast<uint8_t*>(map);
+
+        uint8_t* arena = memoryArenaMap;
+        if (memoryHugePages == MEMORY_HUGE_PAGES_TRANSPARENT) {
+            arena = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(arena) + pageSize - 1) & ~(pageSize - 1));
+            if (madvise(arena, arenaSize, MADV_HUGEPAGE) != 0)
+                warning(60039, "can't use transparent huge pages for memory pool - madvise returned: " + std::string(strerror(errno)));
+        }
+
+        if (memoryNumaNode >= 0) {
+            // Call mbind directly, not to depend on libnuma
+            static constexpr int MPOL_BIND_MODE = 2;
+            const unsigned long nodeMask = 1UL << memoryNumaNode;
+            if (syscall(SYS_mbind, arena, arenaSize, MPOL_BIND_MODE, &nodeMask, sizeof(nodeMask) * 8, 0) != 0)
+                warning(60040, "can't bind memory pool to NUMA node " + std::to_string(memoryNumaNode) + " - mbind returned: " +
+                               std::string(strerror(errno)));
+        }
 
+        // Chunks with lower addresses are used first
+        memoryArenaFree = new uint8_t* [chunksNum];
+        for (uint64_t i = 0; i < chunksNum; ++i)
+            memoryArenaFree[i] = arena + (chunksNum - 1 - i) * MEMORY_CHUNK_SIZE;
+        memoryArenaFreeNum = chunksNum;
+    }
+
+    uint8_t* Ctx::memoryChunkAllocate(const std::string& purpose) {
+        if (memoryArenaMap != nullptr) {
+            if (memoryArenaFreeNum == 0)
+                throw RuntimeException(10016, "couldn't allocate " + std::to_string(MEMORY_CHUNK_SIZE_MB) +
+                                              " bytes memory for: " + purpose);
+            --memoryArenaFreeNum;
+            return memoryArenaFree[memoryArenaFreeNum];
+        }
+
+        auto* chunk = reinterpret_cast<uint8_t*>(aligned_alloc(MEMORY_ALIGNMENT, MEMORY_CHUNK_SIZE));
+        if (chunk == nullptr)
+            throw RuntimeException(10016, "couldn't allocate " + std::to_string(MEMORY_CHUNK_SIZE_MB) +
+                                          " bytes memory for: " + purpose);
+        return chunk;
+    }
+
+    void Ctx::memoryChunkDeallocate(uint8_t* chunk) {
+        // Chunks of the huge page pool stay resident, they are just returned to the pool
+        if (memoryArenaMap != nullptr) {
+            memoryArenaFree[memoryArenaFreeNum] = chunk;
+            ++memoryArenaFreeNum;
+            return;
+        }
+
+        free(chunk);
+    }
+
+    void Ctx::memoryChunkRelease(uint8_t* chunk) {
         // Keep memoryChunksMin reserved
         if (memoryChunksFree >= memoryChunksMin) {
-            free(chunk);
+            memoryChunkDeallocate(chunk);
             --memoryChunksAllocated;
-            if (metrics)
-                metrics->emitMemoryAllocatedMb(memoryChunksAllocated);
         } else {
             memoryChunks[memoryChunksFree] = chunk;
             ++memoryChunksFree;
         }
-        if (reusable)
-            --memoryChunksReusable;
+    }
 
-        condOutOfMemory.notify_all();
+    uint64_t Ctx::memoryMagazinesReclaim() {
+        uint64_t reclaimed = 0;
 
-        --memoryModulesAllocated[module];
+        for (MemoryMagazine* magazine: memoryMagazines) {
+            std::unique_lock<std::mutex> lck(magazine->mtx);
+            while (magazine->size > 0) {
+                --magazine->size;
+                --memoryChunksCached;
+                memoryChunks[memoryChunksFree] = magazine->chunks[magazine->size];
+                ++memoryChunksFree;
+                ++reclaimed;
+            }
+        }
 
-        if (metrics) {
-            metrics->emitMemoryUsedTotalMb(memoryChunksAllocated - memoryChunksFree);
+        return reclaimed;
+    }
 
-            switch (module) {
-                case MEMORY_MODULE_BUILDER:
-                    metrics->emitMemoryUsedMbBuilder(memoryModulesAllocated[module]);
-                    break;
+    void Ctx::memoryMetrics() {
+        if (!metrics)
+            return;
 
-                case MEMORY_MODULE_PARSER:
-                    metrics->emitMemoryUsedMbParser(memoryModulesAllocated[module]);
-                    break;
+        metrics->emitMemoryAllocatedMb(memoryChunksAllocated);
+        metrics->emitMemoryUsedTotalMb(memoryChunksAllocated - memoryChunksFree - memoryChunksCached);
+        metrics->emitMemoryUsedMbBuilder(memoryModulesAllocated[MEMORY_MODULE_BUILDER]);
+        metrics->emitMemoryUsedMbLobs(memoryModulesAllocated[MEMORY_MODULE_LOBS]);
+        metrics->emitMemoryUsedMbParser(memoryModulesAllocated[MEMORY_MODULE_PARSER]);
+        metrics->emitMemoryUsedMbReader(memoryModulesAllocated[MEMORY_MODULE_READER]);
+        metrics->emitMemoryUsedMbTransactions(memoryModulesAllocated[MEMORY_MODULE_TRANSACTIONS]);
+    }
 
-                case MEMORY_MODULE_READER:
-                    metrics->emitMemoryUsedMbReader(memoryModulesAllocated[module]);
-                    break;
+    void Ctx::memoryQuotaWait(MemoryQuota* quota) {
+        std::unique_lock<std::mutex> lck(memoryMtx);
+        while (quota->chunks >= quota->chunksMax && !softShutdown) {
+            if (quota->chunksReusable > 1) {
+                warning(10067, "out of memory, but there are reusable memory chunks, trying to reuse some memory");
 
-                case MEMORY_MODULE_TRANSACTIONS:
-                    metrics->emitMemoryUsedMbTransactions(memoryModulesAllocated[module]);
+                if (trace & TRACE_SLEEP)
+                    logTrace(TRACE_SLEEP, "Ctx:memoryQuotaWait");
+                // Chunks are freed with the lock taken while some thread is waiting
+                ++memoryChunksWaiting;
+                condOutOfMemory.wait_for(lck, std::chrono::milliseconds(100));
+                --memoryChunksWaiting;
+            } else {
+                hint("try to restart with higher value of 'max-mb' parameter of the source or if big transaction - add to 'skip-xid' list; "
+                     "transaction would be skipped");
+                throw RuntimeException(10073, "out of memory quota of the source: " + std::to_string(quota->chunksMax * MEMORY_CHUNK_SIZE_MB) +
+                                              " MB");
             }
         }
     }
 
+    MemoryQuota* Ctx::memoryQuotaCreate(uint64_t maxMb) {
+        auto* quota = new MemoryQuota;
+        quota->chunks = 0;
+        quota->chunksReusable = 0;
+        quota->chunksMax = maxMb / MEMORY_CHUNK_SIZE_MB;
+
+        std::unique_lock<std::mutex> lck(memoryMtx);
+        memoryQuotas.push_back(quota);
+        return quota;
+    }
+
+    MemoryQuota* Ctx::memoryQuotaGet() {
+        return memoryQuota;
+    }
+
+    void Ctx::memoryQuotaSet(MemoryQuota* quota) {
+        memoryQuota = quota;
+    }
+
+    void Ctx::memoryMagazineAttach() {
+        auto* magazine = new MemoryMagazine;
+        magazine->ctx = this;
+        magazine->size = 0;
+
+        std::unique_lock<std::mutex> lck(memoryMtx);
+        memoryMagazines.insert(magazine);
+        memoryMagazine = magazine;
+    }
+
+    void Ctx::memoryMagazineDetach() {
+        MemoryMagazine* magazine = memoryMagazine;
+        if (magazine == nullptr || magazine->ctx != this)
+            return;
+
+        {
+            std::unique_lock<std::mutex> lck(memoryMtx);
+            {
+                std::unique_lock<std::mutex> lckMagazine(magazine->mtx);
+                while (magazine->size > 0) {
+                    --magazine->size;
+                    --memoryChunksCached;
+                    memoryChunkRelease(magazine->chunks[magazine->size]);
+                }
+            }
+            memoryMagazines.erase(magazine);
+            condOutOfMemory.notify_all();
+            memoryMetrics();
+        }
+
+        memoryMagazine = nullptr;
+        delete magazine;
+    }
+
     void Ctx::stopHard() {
         logTrace(TRACE_THREADS, "stop hard");
 
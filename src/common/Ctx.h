@@ -26,6 +26,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "typeLobId.h"
 #include "typeXid.h"
@@ -42,6 +43,13 @@ namespace OpenLogReplicator {
     class Metrics;
     class Thread;
 
+    // Limit of memory chunks held by the threads of one source, when many sources share the memory pool
+    struct MemoryQuota {
+        std::atomic<uint64_t> chunks;
+        std::atomic<uint64_t> chunksReusable;
+        uint64_t chunksMax;
+    };
+
     class Ctx final {
     public:
         static constexpr uint64_t BAD_TIMEZONE = 0x7FFFFFFFFFFFFFFF;
@@ -61,14 +69,22 @@ namespace OpenLogReplicator {
         static constexpr uint64_t LOG_LEVEL_DEBUG = 4;
 
         static constexpr uint64_t MEMORY_MODULE_BUILDER = 0;
-        static constexpr uint64_t MEMORY_MODULE_PARSER = 1;
-        static constexpr uint64_t MEMORY_MODULE_READER = 2;
-        static constexpr uint64_t MEMORY_MODULE_TRANSACTIONS = 3;
-        static constexpr uint64_t MEMORY_MODULES_NUM = 4;
+        static constexpr uint64_t MEMORY_MODULE_LOBS = 1;
+        static constexpr uint64_t MEMORY_MODULE_PARSER = 2;
+        static constexpr uint64_t MEMORY_MODULE_READER = 3;
+        static constexpr uint64_t MEMORY_MODULE_TRANSACTIONS = 4;
+        static constexpr uint64_t MEMORY_MODULES_NUM = 5;
 
         static constexpr uint64_t MEMORY_CHUNK_SIZE_MB = 1;
         static constexpr uint64_t MEMORY_CHUNK_SIZE = MEMORY_CHUNK_SIZE_MB * 1024 * 1024;
         static constexpr uint64_t MEMORY_CHUNK_MIN_MB = 16;
+        static constexpr uint64_t MEMORY_HUGE_PAGES_NONE = 0;
+        static constexpr uint64_t MEMORY_HUGE_PAGES_TRANSPARENT = 1;
+        static constexpr uint64_t MEMORY_HUGE_PAGES_2MB = 2;
+        static constexpr uint64_t MEMORY_HUGE_PAGES_1GB = 3;
+        static constexpr uint64_t MEMORY_NUMA_NODE_MAX = 63;
+        static constexpr uint64_t MEMORY_MAGAZINE_SIZE = 8;
+        static constexpr uint64_t MEMORY_MAGAZINE_BATCH = MEMORY_MAGAZINE_SIZE / 2;
 
         static constexpr uint64_t OLR_LOCALES_TIMESTAMP = 0;
         static constexpr uint64_t OLR_LOCALES_MOCK = 1;
@@ -119,6 +135,14 @@ namespace OpenLogReplicator {
         static constexpr time_t UNIX_AD9999_12_31 = 253402300799L;
 
     protected:
+        // Per-thread cache of free memory chunks, refilled and returned to the global pool in batches
+        struct MemoryMagazine {
+            Ctx* ctx;
+            std::mutex mtx;
+            uint64_t size;
+            uint8_t* chunks[MEMORY_MAGAZINE_SIZE];
+        };
+
         bool bigEndian;
         std::atomic<uint64_t> memoryMinMb;
         std::atomic<uint64_t> memoryMaxMb;
@@ -130,7 +154,17 @@ namespace OpenLogReplicator {
         std::atomic<uint64_t> memoryChunksMax;
         std::atomic<uint64_t> memoryChunksHWM;
         std::atomic<uint64_t> memoryChunksReusable;
-        uint64_t memoryModulesAllocated[MEMORY_MODULES_NUM];
+        std::atomic<uint64_t> memoryChunksCached;
+        std::atomic<uint64_t> memoryChunksWaiting;
+        uint8_t* memoryArenaMap;
+        uint64_t memoryArenaMapSize;
+        uint8_t** memoryArenaFree;
+        uint64_t memoryArenaFreeNum;
+        std::atomic<uint64_t> memoryModulesAllocated[MEMORY_MODULES_NUM];
+        std::set<MemoryMagazine*> memoryMagazines;
+        static thread_local MemoryMagazine* memoryMagazine;
+        std::vector<MemoryQuota*> memoryQuotas;
+        static thread_local MemoryQuota* memoryQuota;
 
         std::condition_variable condMainLoop;
         std::condition_variable condOutOfMemory;
@@ -139,6 +173,14 @@ namespace OpenLogReplicator {
         std::set<Thread*> threads;
         pthread_t mainThread;
 
+        void memoryArenaCreate();
+        [[nodiscard]] uint8_t* memoryChunkAllocate(const std::string& purpose);
+        void memoryChunkDeallocate(uint8_t* chunk);
+        void memoryChunkRelease(uint8_t* chunk);
+        uint64_t memoryMagazinesReclaim();
+        void memoryQuotaWait(MemoryQuota* quota);
+        void memoryMetrics();
+
         inline int64_t yearToDays(int64_t year, int64_t month) {
             int64_t result = year * 365 + year / 4 - year / 100 + year / 400;
             if ((year % 4) == 0 && ((year % 100) != 0 || (year % 400) == 0) && month < 2)
@@ -203,11 +245,14 @@ namespace OpenLogReplicator {
         uint64_t checkpointIntervalMb;
         uint64_t checkpointKeep;
         uint64_t schemaForceInterval;
+        uint64_t schemaDeltaMax;
         // Reader
         uint64_t redoReadSleepUs;
         uint64_t redoVerifyDelayUs;
         uint64_t archReadSleepUs;
         uint64_t archReadTries;
+        uint64_t archPrefetch;
+        uint64_t redoReadQueueDepth;
         uint64_t refreshIntervalUs;
         // Writer
         uint64_t pollIntervalUs;
@@ -215,6 +260,11 @@ namespace OpenLogReplicator {
         // Transaction buffer
         std::string dumpPath;
         std::string redoCopyPath;
+        std::string swapPath;
+        uint64_t swapMb;
+        // Memory pool
+        uint64_t memoryHugePages;
+        int64_t memoryNumaNode;
         uint64_t stopLogSwitches;
         uint64_t stopCheckpoints;
         uint64_t stopTransactions;
@@ -226,7 +276,7 @@ namespace OpenLogReplicator {
         std::atomic<bool> hardShutdown;
         std::atomic<bool> softShutdown;
         std::atomic<bool> replicatorFinished;
-        std::unordered_map<typeLobId, typeXid> lobIdToXidMap;
+        std::atomic<uint64_t> replicatorsRunning;
 
         Ctx();
         virtual ~Ctx();
@@ -571,8 +621,14 @@ namespace OpenLogReplicator {
         [[nodiscard]] uint64_t getMaxUsedMemory() const;
         [[nodiscard]] uint64_t getAllocatedMemory() const;
         [[nodiscard]] uint64_t getFreeMemory();
+        [[nodiscard]] uint64_t getUsedMemoryModule(uint64_t module);
         [[nodiscard]] uint8_t* getMemoryChunk(uint64_t module, bool reusable);
         void freeMemoryChunk(uint64_t module, uint8_t* chunk, bool reusable);
+        void memoryMagazineAttach();
+        void memoryMagazineDetach();
+        [[nodiscard]] MemoryQuota* memoryQuotaCreate(uint64_t maxMb);
+        static MemoryQuota* memoryQuotaGet();
+        static void memoryQuotaSet(MemoryQuota* quota);
         void stopHard();
         void stopSoft();
         void mainLoop();
@@ -19,6 +19,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 #include "LobCtx.h"
 #include "LobData.h"
+#include "LobPool.h"
 #include "RedoLogRecord.h"
 #include "exception/RedoLogException.h"
 
@@ -28,6 +29,7 @@ namespace OpenLogReplicator {
 
     void LobCtx::checkOrphanedLobs(Ctx* ctx, const typeLobId& lobId, typeXid xid, uint64_t offset) {
         LobKey lobKey(lobId, 0);
+        std::unique_lock<std::mutex> lck(*orphanedLobsMtx);
         for (auto orphanedLobsIt = orphanedLobs->upper_bound(lobKey);
              orphanedLobsIt != orphanedLobs->end() && orphanedLobsIt->first.lobId == lobId;) {
 
@@ -51,16 +53,14 @@ namespace OpenLogReplicator {
         }
 
         LobDataElement element(page, pageOffset);
-        auto dataMapIt = lobData->dataMap.find(element);
-        if (dataMapIt != lobData->dataMap.end()) {
+        uint8_t* oldData = lobData->dataSet(element, data);
+        if (oldData != nullptr) {
             if (ctx->trace & Ctx::TRACE_LOB)
                 ctx->logTrace(Ctx::TRACE_LOB, "id: " + lobId.lower() + " page: " + std::to_string(page) + " OVERWRITE");
-            delete[] dataMapIt->second;
+            lobPool->freePage(oldData);
         }
 
-        lobData->dataMap.insert_or_assign(element, data);
-
-        const RedoLogRecord* redoLogRecordLob = reinterpret_cast<const RedoLogRecord*>(data + sizeof(uint64_t));
+        const RedoLogRecord* redoLogRecordLob = LobPool::getRedoLogRecord(data);
         if (redoLogRecordLob->lobPageSize != 0) {
             if (lobData->pageSize == 0) {
                 lobData->pageSize = redoLogRecordLob->lobPageSize;
@@ -73,14 +73,14 @@ namespace OpenLogReplicator {
 
         uint32_t pageNo = redoLogRecordLob->lobPageNo;
         if (pageNo != RedoLogRecord::INVALID_LOB_PAGE_NO) {
-            auto indexMapIt = lobData->indexMap.find(page);
-            if (indexMapIt != lobData->indexMap.end()) {
-                if (indexMapIt->second != page)
+            auto indexIt = lobData->indexFind(page);
+            if (indexIt != lobData->indexList.end()) {
+                if (indexIt->second != page)
                     throw RedoLogException(50004, "duplicate index lobid: " + lobId.upper() + ", page: " + std::to_string(page) +
-                                                  ", already set to: " + std::to_string(indexMapIt->second) + ", xid: " + xid.toString() + ", offset: " +
+                                                  ", already set to: " + std::to_string(indexIt->second) + ", xid: " + xid.toString() + ", offset: " +
                                                   std::to_string(offset));
             } else {
-                lobData->indexMap.insert_or_assign(pageNo, page);
+                lobData->indexSet(pageNo, page);
             }
         }
     }
@@ -174,21 +174,23 @@ namespace OpenLogReplicator {
             lobs.insert_or_assign(lobId, lobData);
         }
 
-        auto indexMapIt = lobData->indexMap.find(page);
-        if (indexMapIt != lobData->indexMap.end()) {
-            if (indexMapIt->second != page)
+        auto indexIt = lobData->indexFind(page);
+        if (indexIt != lobData->indexList.end()) {
+            if (indexIt->second != page)
                 throw RedoLogException(50004, "duplicate index lobid: " + lobId.upper() + ", page: " + std::to_string(page) +
-                                              ", already set to: " + std::to_string(indexMapIt->second) + ", xid: " + xid.toString() + ", offset: " +
+                                              ", already set to: " + std::to_string(indexIt->second) + ", xid: " + xid.toString() + ", offset: " +
                                               std::to_string(offset));
             return;
         }
 
-        lobData->indexMap.insert_or_assign(pageNo, page);
+        lobData->indexSet(pageNo, page);
     }
 
     void LobCtx::purge() {
         for (const auto& lobsIt: lobs) {
             LobData* lobData = lobsIt.second;
+            for (const auto& dataIt: lobData->dataList)
+                lobPool->freePage(dataIt.second);
             delete lobData;
         }
         lobs.clear();
@@ -18,6 +18,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
 #include <map>
+#include <mutex>
 #include <unordered_map>
 
 #include "LobData.h"
@@ -30,6 +31,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     class Ctx;
+    class LobPool;
     class Schema;
 
     class LobCtx final {
@@ -37,7 +39,10 @@ namespace OpenLogReplicator {
         virtual ~LobCtx();
 
         std::unordered_map<typeLobId, LobData*> lobs;
+        // Shared by all transactions of the source, used also by the builder pool threads
         std::map<LobKey, uint8_t*>* orphanedLobs;
+        std::mutex* orphanedLobsMtx;
+        LobPool* lobPool;
         std::map<typeDba, uint8_t*> listMap;
 
         void checkOrphanedLobs(Ctx* ctx, const typeLobId& lobId, typeXid xid, uint64_t offset);
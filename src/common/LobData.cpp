@@ -17,6 +17,8 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <algorithm>
+
 #include "LobData.h"
 
 namespace OpenLogReplicator {
@@ -55,11 +57,56 @@ namespace OpenLogReplicator {
     }
 
     LobData::~LobData() {
-        for (const auto& dataMapIt: dataMap) {
-            uint8_t* ptr = dataMapIt.second;
-            delete[] ptr;
+        dataList.clear();
+        indexList.clear();
+    }
+
+    LobData::DataIt LobData::dataFind(const LobDataElement& element) {
+        auto dataIt = std::lower_bound(dataList.begin(), dataList.end(), element,
+                                       [](const std::pair<LobDataElement, uint8_t*>& item, const LobDataElement& key) { return item.first < key; });
+        if (dataIt == dataList.end() || element < dataIt->first)
+            return dataList.end();
+        return dataIt;
+    }
+
+    uint8_t* LobData::dataSet(const LobDataElement& element, uint8_t* data) {
+        // Pages mostly come in order, append without searching
+        if (dataList.empty() || dataList.back().first < element) {
+            dataList.emplace_back(element, data);
+            return nullptr;
+        }
+
+        auto dataIt = std::lower_bound(dataList.begin(), dataList.end(), element,
+                                       [](const std::pair<LobDataElement, uint8_t*>& item, const LobDataElement& key) { return item.first < key; });
+        if (!(element < dataIt->first)) {
+            uint8_t* oldData = dataIt->second;
+            dataIt->second = data;
+            return oldData;
         }
-        dataMap.clear();
-        indexMap.clear();
+
+        dataList.emplace(dataIt, element, data);
+        return nullptr;
+    }
+
+    LobData::IndexIt LobData::indexFind(uint32_t pageNo) {
+        auto indexIt = std::lower_bound(indexList.begin(), indexList.end(), pageNo,
+                                        [](const std::pair<uint32_t, typeDba>& item, uint32_t key) { return item.first < key; });
+        if (indexIt == indexList.end() || indexIt->first != pageNo)
+            return indexList.end();
+        return indexIt;
+    }
+
+    void LobData::indexSet(uint32_t pageNo, typeDba page) {
+        if (indexList.empty() || indexList.back().first < pageNo) {
+            indexList.emplace_back(pageNo, page);
+            return;
+        }
+
+        auto indexIt = std::lower_bound(indexList.begin(), indexList.end(), pageNo,
+                                        [](const std::pair<uint32_t, typeDba>& item, uint32_t key) { return item.first < key; });
+        if (indexIt->first == pageNo)
+            indexIt->second = page;
+        else
+            indexList.emplace(indexIt, pageNo, page);
     }
 }
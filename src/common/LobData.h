@@ -17,7 +17,8 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
-#include <map>
+#include <utility>
+#include <vector>
 
 #include "types.h"
 
@@ -39,11 +40,21 @@ namespace OpenLogReplicator {
 
     class LobData final {
     public:
+        typedef std::vector<std::pair<LobDataElement, uint8_t*>>::iterator DataIt;
+        typedef std::vector<std::pair<uint32_t, typeDba>>::iterator IndexIt;
+
         LobData();
         virtual ~LobData();
 
-        std::map<LobDataElement, uint8_t*> dataMap;
-        std::map<uint32_t, typeDba> indexMap;
+        [[nodiscard]] DataIt dataFind(const LobDataElement& element);
+        [[nodiscard]] uint8_t* dataSet(const LobDataElement& element, uint8_t* data);
+        [[nodiscard]] IndexIt indexFind(uint32_t pageNo);
+        void indexSet(uint32_t pageNo, typeDba page);
+
+        // Pages sorted by (dba, offset), owned by LobPool
+        std::vector<std::pair<LobDataElement, uint8_t*>> dataList;
+        // Page numbers sorted
+        std::vector<std::pair<uint32_t, typeDba>> indexList;
 
         uint32_t pageSize;
         uint32_t sizePages;
@@ -0,0 +1,106 @@
+/* Pooled memory for LOB pages
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <cstring>
+
+#include "Ctx.h"
+#include "LobPool.h"
+#include "RedoLogRecord.h"
+#include "exception/RedoLogException.h"
+
+namespace OpenLogReplicator {
+    LobPool::LobPool(Ctx* newCtx) :
+            ctx(newCtx),
+            chunk(nullptr) {
+    }
+
+    LobPool::~LobPool() {
+        if (chunk != nullptr) {
+            ctx->freeMemoryChunk(Ctx::MEMORY_MODULE_LOBS, chunk, false);
+            chunk = nullptr;
+        }
+    }
+
+    uint8_t* LobPool::allocateFromChunk(uint64_t length) {
+        if (chunk == nullptr)
+            return nullptr;
+
+        auto* used = reinterpret_cast<uint64_t*>(chunk);
+        auto* pages = reinterpret_cast<uint64_t*>(chunk + sizeof(uint64_t));
+        if (*used + length > Ctx::MEMORY_CHUNK_SIZE)
+            return nullptr;
+
+        uint8_t* page = chunk + *used;
+        *reinterpret_cast<uint32_t*>(page) = static_cast<uint32_t>(length);
+        *reinterpret_cast<uint32_t*>(page + sizeof(uint32_t)) = static_cast<uint32_t>(*used);
+        *used += length;
+        ++(*pages);
+        return page;
+    }
+
+    uint8_t* LobPool::allocatePage(const RedoLogRecord* redoLogRecord) {
+        uint64_t length = (PAGE_HEADER_SIZE + sizeof(RedoLogRecord) + redoLogRecord->length + PAGE_ALIGNMENT - 1) & ~(PAGE_ALIGNMENT - 1);
+        if (length > Ctx::MEMORY_CHUNK_SIZE - CHUNK_HEADER_SIZE)
+            throw RedoLogException(50071, "lob page too big, lobid: " + redoLogRecord->lobId.upper() + ", page: " +
+                                          std::to_string(redoLogRecord->dba) + ", length: " + std::to_string(redoLogRecord->length));
+
+        uint8_t* page;
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            page = allocateFromChunk(length);
+        }
+
+        if (page == nullptr) {
+            // The lock is not held while waiting for memory, so that pages can be freed meanwhile
+            uint8_t* newChunk = ctx->getMemoryChunk(Ctx::MEMORY_MODULE_LOBS, false);
+            *reinterpret_cast<uint64_t*>(newChunk) = CHUNK_HEADER_SIZE;
+            *reinterpret_cast<uint64_t*>(newChunk + sizeof(uint64_t)) = 0;
+
+            std::unique_lock<std::mutex> lck(mtx);
+            // The previous chunk is released by the last freed page, or now if it is already empty
+            if (chunk != nullptr && *reinterpret_cast<uint64_t*>(chunk + sizeof(uint64_t)) == 0)
+                ctx->freeMemoryChunk(Ctx::MEMORY_MODULE_LOBS, chunk, false);
+            chunk = newChunk;
+            page = allocateFromChunk(length);
+        }
+
+        auto* redoLogRecordLob = getRedoLogRecord(page);
+        memcpy(reinterpret_cast<void*>(redoLogRecordLob), reinterpret_cast<const void*>(redoLogRecord), sizeof(RedoLogRecord));
+        redoLogRecordLob->data = page + PAGE_HEADER_SIZE + sizeof(RedoLogRecord);
+        memcpy(reinterpret_cast<void*>(redoLogRecordLob->data), reinterpret_cast<const void*>(redoLogRecord->data), redoLogRecord->length);
+        return page;
+    }
+
+    void LobPool::freePage(uint8_t* page) {
+        uint8_t* pageChunk = page - *reinterpret_cast<const uint32_t*>(page + sizeof(uint32_t));
+        auto* pages = reinterpret_cast<uint64_t*>(pageChunk + sizeof(uint64_t));
+
+        std::unique_lock<std::mutex> lck(mtx);
+        if (--(*pages) > 0)
+            return;
+
+        if (pageChunk == chunk) {
+            // Empty current chunk is reused from the beginning
+            *reinterpret_cast<uint64_t*>(chunk) = CHUNK_HEADER_SIZE;
+            return;
+        }
+
+        ctx->freeMemoryChunk(Ctx::MEMORY_MODULE_LOBS, pageChunk, false);
+    }
+}
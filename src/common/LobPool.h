@@ -0,0 +1,62 @@
+/* Header for LobPool class
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <mutex>
+
+#include "types.h"
+
+#ifndef LOB_POOL_H_
+#define LOB_POOL_H_
+
+namespace OpenLogReplicator {
+    class Ctx;
+    class RedoLogRecord;
+
+    // LOB pages are packed into memory chunks of the shared pool, a chunk is released when all its pages are freed
+    class LobPool final {
+    public:
+        // Page: header (uint32_t length, uint32_t position in chunk), copy of RedoLogRecord, redo data
+        static constexpr uint64_t PAGE_HEADER_SIZE = sizeof(uint64_t);
+
+    protected:
+        // Chunk: header (uint64_t used bytes, uint64_t allocated pages), pages
+        static constexpr uint64_t CHUNK_HEADER_SIZE = 2 * sizeof(uint64_t);
+        static constexpr uint64_t PAGE_ALIGNMENT = 8;
+
+        Ctx* ctx;
+        // Pages are freed also by the builder pool threads
+        std::mutex mtx;
+        uint8_t* chunk;
+
+        [[nodiscard]] uint8_t* allocateFromChunk(uint64_t length);
+
+    public:
+        explicit LobPool(Ctx* newCtx);
+        virtual ~LobPool();
+
+        [[nodiscard]] uint8_t* allocatePage(const RedoLogRecord* redoLogRecord);
+        void freePage(uint8_t* page);
+
+        static RedoLogRecord* getRedoLogRecord(uint8_t* page) {
+            return reinterpret_cast<RedoLogRecord*>(page + PAGE_HEADER_SIZE);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,61 @@
+/* Definition of class ObjectFilter
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <atomic>
+
+#include "types.h"
+
+#ifndef OBJECT_FILTER_H_
+#define OBJECT_FILTER_H_
+
+namespace OpenLogReplicator {
+    // Bitmap of hashed object identifiers which may be replicated, read without locks by the parser.
+    // A set bit is only a hint (false positives are possible), a cleared bit means the object is not replicated for sure.
+    // Bits are never cleared, objects removed from the schema are kept until the schema is recreated.
+    class ObjectFilter final {
+    public:
+        static constexpr uint64_t BITS_SHIFT = 16;
+        static constexpr uint64_t WORDS = (1 << BITS_SHIFT) / 64;
+
+    protected:
+        std::atomic<uint64_t> words[WORDS];
+
+        static uint64_t hash(typeObj obj) {
+            return (static_cast<uint32_t>(obj * 0x9E3779B1U)) >> (32 - BITS_SHIFT);
+        }
+
+    public:
+        ObjectFilter() {
+            for (uint64_t i = 0; i < WORDS; ++i)
+                words[i].store(0, std::memory_order_relaxed);
+        }
+
+        void add(typeObj obj) {
+            uint64_t bit = hash(obj);
+            words[bit >> 6].fetch_or(1ULL << (bit & 63), std::memory_order_release);
+        }
+
+        [[nodiscard]] bool check(typeObj obj) const {
+            uint64_t bit = hash(obj);
+            return (words[bit >> 6].load(std::memory_order_acquire) & (1ULL << (bit & 63))) != 0;
+        }
+    };
+}
+
+#endif
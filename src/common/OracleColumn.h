@@ -45,6 +45,8 @@ namespace OpenLogReplicator {
         bool guard;
         bool xmlType;
         bool nullWarning;
+        // Pre-escaped JSON key for the column: "NAME":, set when the schema maps are built
+        std::string nameJson;
 
         OracleColumn(typeCol newCol, typeCol newGuardSeg, typeCol newSegCol, const std::string& newName, uint64_t newType, uint64_t newLength,
                      int64_t newPrecision, int64_t newScale, typeCol newNumPk, uint64_t newCharsetId, bool newNullable, bool newHidden,
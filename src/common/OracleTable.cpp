@@ -24,6 +24,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "exception/RuntimeException.h"
 #include "expression/BoolValue.h"
 #include "expression/Token.h"
+#include "metrics/Metrics.h"
 
 namespace OpenLogReplicator {
     OracleTable::OracleTable(typeObj newObj, typeDataObj newDataObj, typeUser newUser, typeCol newCluCols, typeOptions newOptions, const std::string& newOwner,
@@ -40,7 +41,8 @@ namespace OpenLogReplicator {
             owner(newOwner),
             name(newName),
             conditionStr(""),
-            condition(nullptr) {
+            condition(nullptr),
+            metricsTable(nullptr) {
 
         systemTable = 0;
         if (this->owner == "SYS") {
@@ -116,6 +118,10 @@ namespace OpenLogReplicator {
         if (condition != nullptr)
             delete condition;
         condition = nullptr;
+
+        if (metricsTable != nullptr)
+            delete metricsTable.load();
+        metricsTable = nullptr;
     }
 
     void OracleTable::addColumn(OracleColumn* column) {
@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 
@@ -30,6 +31,7 @@ namespace OpenLogReplicator {
     class BoolValue;
     class Ctx;
     class Expression;
+    class MetricsTable;
     class OracleColumn;
     class OracleLob;
     class Token;
@@ -68,6 +70,8 @@ namespace OpenLogReplicator {
         std::string owner;
         std::string name;
         std::string tokSuf;
+        // Pre-escaped JSON schema fragment: "schema":{"owner":"OWNER","table":"NAME", set when the schema maps are built
+        std::string schemaJson;
         std::string conditionStr;
         BoolValue* condition;
         std::vector<OracleColumn*> columns;
@@ -78,6 +82,7 @@ namespace OpenLogReplicator {
         std::vector<Expression*> stack;
         uint64_t systemTable;
         bool sys;
+        std::atomic<MetricsTable*> metricsTable;
 
         OracleTable(typeObj newObj, typeDataObj newDataObj, typeUser newUser, typeCol newCluCols, typeOptions newOptions, const std::string& newOwner,
                     const std::string& newName);
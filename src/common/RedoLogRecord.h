@@ -123,6 +123,7 @@ namespace OpenLogReplicator {
         uint64_t suppLogNumsDelta;
         uint64_t suppLogLenDelta;
         bool compressed;
+        bool rowDataSkipped;      // Undo decoded without row data, object is not replicated
 
         static bool nextFieldOpt(Ctx* ctx, const RedoLogRecord* redoLogRecord, typeField& fieldNum, uint64_t& fieldPos, uint16_t& fieldLength, uint32_t code) {
             if (fieldNum >= redoLogRecord->fieldCnt)
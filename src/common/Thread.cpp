@@ -26,7 +26,8 @@ namespace OpenLogReplicator {
             ctx(newCtx),
             pthread(0),
             alias(newAlias),
-            finished(false) {
+            finished(false),
+            memoryQuota(Ctx::memoryQuotaGet()) {
     }
 
     Thread::~Thread() = default;
@@ -41,7 +42,10 @@ namespace OpenLogReplicator {
 
     void* Thread::runStatic(void* voidThread) {
         Thread* thread = reinterpret_cast<Thread*>(voidThread);
+        Ctx::memoryQuotaSet(thread->memoryQuota);
+        thread->ctx->memoryMagazineAttach();
         thread->run();
+        thread->ctx->memoryMagazineDetach();
         thread->finished = true;
         return nullptr;
     }
@@ -26,6 +26,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     class Ctx;
+    struct MemoryQuota;
 
     class Thread {
     protected:
@@ -36,6 +37,8 @@ namespace OpenLogReplicator {
         pthread_t pthread;
         std::string alias;
         std::atomic<bool> finished;
+        // Memory quota of the source, inherited from the thread creating this one
+        MemoryQuota* memoryQuota;
 
         explicit Thread(Ctx* newCtx, const std::string& newAlias);
         virtual ~Thread();
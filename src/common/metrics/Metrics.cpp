@@ -24,6 +24,9 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "Metrics.h"
 
 namespace OpenLogReplicator {
+    MetricsTable::~MetricsTable() {
+    }
+
     Metrics::Metrics(uint64_t newTagNames) :
             tagNames(newTagNames) {
     }
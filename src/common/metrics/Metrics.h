@@ -24,6 +24,13 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     class Ctx;
+    class OracleTable;
+
+    // Metrics of one table, created on first use and kept by the table, so it is dropped together with the schema
+    class MetricsTable {
+    public:
+        virtual ~MetricsTable();
+    };
 
     class Metrics {
     protected:
@@ -77,12 +84,12 @@ namespace OpenLogReplicator {
         virtual void emitDmlOpsDeleteSkip(uint64_t counter) = 0;
         virtual void emitDmlOpsInsertSkip(uint64_t counter) = 0;
         virtual void emitDmlOpsUpdateSkip(uint64_t counter) = 0;
-        virtual void emitDmlOpsDeleteOut(uint64_t counter, const std::string& owner, const std::string& table) = 0;
-        virtual void emitDmlOpsInsertOut(uint64_t counter, const std::string& owner, const std::string& table) = 0;
-        virtual void emitDmlOpsUpdateOut(uint64_t counter, const std::string& owner, const std::string& table) = 0;
-        virtual void emitDmlOpsDeleteSkip(uint64_t counter, const std::string& owner, const std::string& table) = 0;
-        virtual void emitDmlOpsInsertSkip(uint64_t counter, const std::string& owner, const std::string& table) = 0;
-        virtual void emitDmlOpsUpdateSkip(uint64_t counter, const std::string& owner, const std::string& table) = 0;
+        virtual void emitDmlOpsDeleteOut(uint64_t counter, OracleTable* table) = 0;
+        virtual void emitDmlOpsInsertOut(uint64_t counter, OracleTable* table) = 0;
+        virtual void emitDmlOpsUpdateOut(uint64_t counter, OracleTable* table) = 0;
+        virtual void emitDmlOpsDeleteSkip(uint64_t counter, OracleTable* table) = 0;
+        virtual void emitDmlOpsInsertSkip(uint64_t counter, OracleTable* table) = 0;
+        virtual void emitDmlOpsUpdateSkip(uint64_t counter, OracleTable* table) = 0;
 
         // log_switches
         virtual void emitLogSwitchesArchived(uint64_t counter) = 0;
@@ -100,6 +107,7 @@ namespace OpenLogReplicator {
 
         // memory_used_mb
         virtual void emitMemoryUsedMbBuilder(int64_t gauge) = 0;
+        virtual void emitMemoryUsedMbLobs(int64_t gauge) = 0;
         virtual void emitMemoryUsedMbParser(int64_t gauge) = 0;
         virtual void emitMemoryUsedMbReader(int64_t gauge) = 0;
         virtual void emitMemoryUsedMbTransactions(int64_t gauge) = 0;
@@ -19,8 +19,21 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 #include "MetricsPrometheus.h"
 #include "../Ctx.h"
+#include "../OracleTable.h"
 
 namespace OpenLogReplicator {
+    MetricsPrometheusTable::MetricsPrometheusTable() :
+            dmlOpsDeleteOutCounter(nullptr),
+            dmlOpsInsertOutCounter(nullptr),
+            dmlOpsUpdateOutCounter(nullptr),
+            dmlOpsDeleteSkipCounter(nullptr),
+            dmlOpsInsertSkipCounter(nullptr),
+            dmlOpsUpdateSkipCounter(nullptr) {
+    }
+
+    MetricsPrometheusTable::~MetricsPrometheusTable() {
+    }
+
     MetricsPrometheus::MetricsPrometheus(uint64_t newTagNames, const char* newBind) :
             Metrics(newTagNames),
             bind(newBind),
@@ -64,6 +77,7 @@ namespace OpenLogReplicator {
             memoryUsedTotalMbGauge(nullptr),
             memoryUsedMb(nullptr),
             memoryUsedMbBuilderGauge(nullptr),
+            memoryUsedMbLobsGauge(nullptr),
             memoryUsedMbParserGauge(nullptr),
             memoryUsedMbReaderGauge(nullptr),
             memoryUsedMbTransactionsGauge(nullptr),
@@ -167,6 +181,7 @@ namespace OpenLogReplicator {
         // memory_used_mb
         memoryUsedMb = &prometheus::BuildGauge().Name("memory_used_mb").Help("Memory used by module: builder").Register(*registry);
         memoryUsedMbBuilderGauge = &memoryUsedMb->Add({{"type", "builder"}});
+        memoryUsedMbLobsGauge = &memoryUsedMb->Add({{"type", "lobs"}});
         memoryUsedMbParserGauge = &memoryUsedMb->Add({{"type", "parser"}});
         memoryUsedMbReaderGauge = &memoryUsedMb->Add({{"type", "reader"}});
         memoryUsedMbTransactionsGauge = &memoryUsedMb->Add({{"type", "transactions"}});
@@ -281,100 +296,54 @@ namespace OpenLogReplicator {
         dmlOpsUpdateSkipCounter->Increment(counter);
     }
 
-    void MetricsPrometheus::emitDmlOpsDeleteOut(uint64_t counter, const std::string& owner, const std::string& table) {
-        std::string key(owner + "." + table);
-        prometheus::Counter* cnt;
-        auto iter = dmlOpsDeleteOutCounterMap.find(key);
-
-        if (iter != dmlOpsDeleteOutCounterMap.end())
-            cnt = iter->second;
-        else
-            cnt = &dmlOps->Add({{"type",   "delete"},
-                                {"filter", "out"},
-                                {"owner",  owner},
-                                {"table",  table}});
-
-        cnt->Increment(counter);
+    prometheus::Counter* MetricsPrometheus::dmlOpsTableCounter(OracleTable* table, std::atomic<prometheus::Counter*> MetricsPrometheusTable::*counter,
+                                                               const char* type, const char* filter) {
+        // Builder threads may race here, only one of the objects is kept
+        MetricsTable* metricsTableNew = table->metricsTable.load();
+        if (metricsTableNew == nullptr) {
+            MetricsTable* metricsTableExpected = nullptr;
+            metricsTableNew = new MetricsPrometheusTable();
+            if (!table->metricsTable.compare_exchange_strong(metricsTableExpected, metricsTableNew)) {
+                delete metricsTableNew;
+                metricsTableNew = metricsTableExpected;
+            }
+        }
+        MetricsPrometheusTable* metricsTable = static_cast<MetricsPrometheusTable*>(metricsTableNew);
+
+        // Family::Add returns the same counter for the same labels
+        prometheus::Counter* cnt = (metricsTable->*counter).load();
+        if (cnt == nullptr) {
+            cnt = &dmlOps->Add({{"type",   type},
+                                {"filter", filter},
+                                {"owner",  table->owner},
+                                {"table",  table->name}});
+            (metricsTable->*counter).store(cnt);
+        }
+        return cnt;
     }
 
-    void MetricsPrometheus::emitDmlOpsInsertOut(uint64_t counter, const std::string& owner, const std::string& table) {
-        std::string key(owner + "." + table);
-        prometheus::Counter* cnt;
-        auto iter = dmlOpsInsertOutCounterMap.find(key);
-
-        if (iter != dmlOpsInsertOutCounterMap.end())
-            cnt = iter->second;
-        else
-            cnt = &dmlOps->Add({{"type",   "insert"},
-                                {"filter", "out"},
-                                {"owner",  owner},
-                                {"table",  table}});
-
-        cnt->Increment(counter);
+    void MetricsPrometheus::emitDmlOpsDeleteOut(uint64_t counter, OracleTable* table) {
+        dmlOpsTableCounter(table, &MetricsPrometheusTable::dmlOpsDeleteOutCounter, "delete", "out")->Increment(counter);
     }
 
-    void MetricsPrometheus::emitDmlOpsUpdateOut(uint64_t counter, const std::string& owner, const std::string& table) {
-        std::string key(owner + "." + table);
-        prometheus::Counter* cnt;
-        auto iter = dmlOpsUpdateOutCounterMap.find(key);
-
-        if (iter != dmlOpsUpdateOutCounterMap.end())
-            cnt = iter->second;
-        else
-            cnt = &dmlOps->Add({{"type",   "update"},
-                                {"filter", "out"},
-                                {"owner",  owner},
-                                {"table",  table}});
-
-        cnt->Increment(counter);
+    void MetricsPrometheus::emitDmlOpsInsertOut(uint64_t counter, OracleTable* table) {
+        dmlOpsTableCounter(table, &MetricsPrometheusTable::dmlOpsInsertOutCounter, "insert", "out")->Increment(counter);
     }
 
-    void MetricsPrometheus::emitDmlOpsDeleteSkip(uint64_t counter, const std::string& owner, const std::string& table) {
-        std::string key(owner + "." + table);
-        prometheus::Counter* cnt;
-        auto iter = dmlOpsDeleteSkipCounterMap.find(key);
-
-        if (iter != dmlOpsDeleteSkipCounterMap.end())
-            cnt = iter->second;
-        else
-            cnt = &dmlOps->Add({{"type",   "delete"},
-                                {"filter", "skip"},
-                                {"owner",  owner},
-                                {"table",  table}});
-
-        cnt->Increment(counter);
+    void MetricsPrometheus::emitDmlOpsUpdateOut(uint64_t counter, OracleTable* table) {
+        dmlOpsTableCounter(table, &MetricsPrometheusTable::dmlOpsUpdateOutCounter, "update", "out")->Increment(counter);
     }
 
-    void MetricsPrometheus::emitDmlOpsInsertSkip(uint64_t counter, const std::string& owner, const std::string& table) {
-        std::string key(owner + "." + table);
-        prometheus::Counter* cnt;
-        auto iter = dmlOpsInsertSkipCounterMap.find(key);
-
-        if (iter != dmlOpsInsertSkipCounterMap.end())
-            cnt = iter->second;
-        else
-            cnt = &dmlOps->Add({{"type",   "insert"},
-                                {"filter", "skip"},
-                                {"owner",  owner},
-                                {"table",  table}});
-
-        cnt->Increment(counter);
+    void MetricsPrometheus::emitDmlOpsDeleteSkip(uint64_t counter, OracleTable* table) {
+        dmlOpsTableCounter(table, &MetricsPrometheusTable::dmlOpsDeleteSkipCounter, "delete", "skip")->Increment(counter);
     }
 
-    void MetricsPrometheus::emitDmlOpsUpdateSkip(uint64_t counter, const std::string& owner, const std::string& table) {
-        std::string key(owner + "." + table);
-        prometheus::Counter* cnt;
-        auto iter = dmlOpsUpdateSkipCounterMap.find(key);
-
-        if (iter != dmlOpsUpdateSkipCounterMap.end())
-            cnt = iter->second;
-        else
-            cnt = &dmlOps->Add({{"type",   "update"},
-                                {"filter", "skip"},
-                                {"owner",  owner},
-                                {"table",  table}});
+    void MetricsPrometheus::emitDmlOpsInsertSkip(uint64_t counter, OracleTable* table) {
+        dmlOpsTableCounter(table, &MetricsPrometheusTable::dmlOpsInsertSkipCounter, "insert", "skip")->Increment(counter);
+    }
 
-        cnt->Increment(counter);
+    void MetricsPrometheus::emitDmlOpsUpdateSkip(uint64_t counter, OracleTable* table) {
+        dmlOpsTableCounter(table, &MetricsPrometheusTable::dmlOpsUpdateSkipCounter, "update", "skip")->Increment(counter);
     }
 
     // log_switches
@@ -410,6 +379,10 @@ namespace OpenLogReplicator {
         memoryUsedMbBuilderGauge->Set(gauge);
     }
 
+    void MetricsPrometheus::emitMemoryUsedMbLobs(int64_t gauge) {
+        memoryUsedMbLobsGauge->Set(gauge);
+    }
+
     void MetricsPrometheus::emitMemoryUsedMbParser(int64_t gauge) {
         memoryUsedMbParserGauge->Set(gauge);
     }
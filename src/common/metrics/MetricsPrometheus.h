@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <atomic>
 #include <map>
 #include <prometheus/counter.h>
 #include <prometheus/exposer.h>
@@ -28,6 +29,20 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #define METRICS_PROMETHEUS_H_
 
 namespace OpenLogReplicator {
+    class MetricsPrometheusTable final : public MetricsTable {
+    public:
+        // dml_ops, resolved on first use by any of the builder threads
+        std::atomic<prometheus::Counter*> dmlOpsDeleteOutCounter;
+        std::atomic<prometheus::Counter*> dmlOpsInsertOutCounter;
+        std::atomic<prometheus::Counter*> dmlOpsUpdateOutCounter;
+        std::atomic<prometheus::Counter*> dmlOpsDeleteSkipCounter;
+        std::atomic<prometheus::Counter*> dmlOpsInsertSkipCounter;
+        std::atomic<prometheus::Counter*> dmlOpsUpdateSkipCounter;
+
+        MetricsPrometheusTable();
+        ~MetricsPrometheusTable() override;
+    };
+
     class MetricsPrometheus final : public Metrics {
     protected:
         std::string bind;
@@ -76,12 +91,8 @@ namespace OpenLogReplicator {
         prometheus::Counter* dmlOpsDeleteSkipCounter;
         prometheus::Counter* dmlOpsInsertSkipCounter;
         prometheus::Counter* dmlOpsUpdateSkipCounter;
-        std::unordered_map<std::string, prometheus::Counter*> dmlOpsDeleteOutCounterMap;
-        std::unordered_map<std::string, prometheus::Counter*> dmlOpsInsertOutCounterMap;
-        std::unordered_map<std::string, prometheus::Counter*> dmlOpsUpdateOutCounterMap;
-        std::unordered_map<std::string, prometheus::Counter*> dmlOpsDeleteSkipCounterMap;
-        std::unordered_map<std::string, prometheus::Counter*> dmlOpsInsertSkipCounterMap;
-        std::unordered_map<std::string, prometheus::Counter*> dmlOpsUpdateSkipCounterMap;
+        prometheus::Counter* dmlOpsTableCounter(OracleTable* table, std::atomic<prometheus::Counter*> MetricsPrometheusTable::*counter, const char* type,
+                                                const char* filter);
 
         // log_switches
         prometheus::Family<prometheus::Counter>* logSwitches;
@@ -104,6 +115,7 @@ namespace OpenLogReplicator {
         // memory_used_mb
         prometheus::Family<prometheus::Gauge>* memoryUsedMb;
         prometheus::Gauge* memoryUsedMbBuilderGauge;
+        prometheus::Gauge* memoryUsedMbLobsGauge;
         prometheus::Gauge* memoryUsedMbParserGauge;
         prometheus::Gauge* memoryUsedMbReaderGauge;
         prometheus::Gauge* memoryUsedMbTransactionsGauge;
@@ -166,12 +178,12 @@ namespace OpenLogReplicator {
         virtual void emitDmlOpsDeleteSkip(uint64_t counter) override;
         virtual void emitDmlOpsInsertSkip(uint64_t counter) override;
         virtual void emitDmlOpsUpdateSkip(uint64_t counter) override;
-        virtual void emitDmlOpsDeleteOut(uint64_t counter, const std::string& owner, const std::string& table) override;
-        virtual void emitDmlOpsInsertOut(uint64_t counter, const std::string& owner, const std::string& table) override;
-        virtual void emitDmlOpsUpdateOut(uint64_t counter, const std::string& owner, const std::string& table) override;
-        virtual void emitDmlOpsDeleteSkip(uint64_t counter, const std::string& owner, const std::string& table) override;
-        virtual void emitDmlOpsInsertSkip(uint64_t counter, const std::string& owner, const std::string& table) override;
-        virtual void emitDmlOpsUpdateSkip(uint64_t counter, const std::string& owner, const std::string& table) override;
+        virtual void emitDmlOpsDeleteOut(uint64_t counter, OracleTable* table) override;
+        virtual void emitDmlOpsInsertOut(uint64_t counter, OracleTable* table) override;
+        virtual void emitDmlOpsUpdateOut(uint64_t counter, OracleTable* table) override;
+        virtual void emitDmlOpsDeleteSkip(uint64_t counter, OracleTable* table) override;
+        virtual void emitDmlOpsInsertSkip(uint64_t counter, OracleTable* table) override;
+        virtual void emitDmlOpsUpdateSkip(uint64_t counter, OracleTable* table) override;
 
         // log_switches
         virtual void emitLogSwitchesArchived(uint64_t counter) override;
@@ -189,6 +201,7 @@ namespace OpenLogReplicator {
 
         // memory_used_mb
         virtual void emitMemoryUsedMbBuilder(int64_t gauge) override;
+        virtual void emitMemoryUsedMbLobs(int64_t gauge) override;
         virtual void emitMemoryUsedMbParser(int64_t gauge) override;
         virtual void emitMemoryUsedMbReader(int64_t gauge) override;
         virtual void emitMemoryUsedMbTransactions(int64_t gauge) override;
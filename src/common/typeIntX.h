@@ -150,6 +150,10 @@ namespace OpenLogReplicator {
             return data[0];
         }
 
+        [[nodiscard]] uint64_t getData(uint64_t i) const {
+            return data[i];
+        }
+
         [[nodiscard]] bool isSet64(uint64_t mask) const {
             return data[0] & mask;
         }
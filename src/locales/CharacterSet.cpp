@@ -17,6 +17,14 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <cstring>
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #include "CharacterSet.h"
 #include "../common/Ctx.h"
 #include "../common/types.h"
@@ -66,4 +74,37 @@ namespace OpenLogReplicator {
                             ") using character set " + name + ", xid: " + xid.toString());
         return UNICODE_UNKNOWN_CHARACTER;
     }
+
+    uint64_t CharacterSet::asciiLength(const uint8_t* str, uint64_t length) {
+        uint64_t pos = 0;
+
+#if defined(__x86_64__)
+        for (; pos + 16 <= length; pos += 16) {
+            int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos)));
+            if (mask != 0)
+                return pos + static_cast<uint64_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+        }
+#endif
+#if defined(__aarch64__)
+        for (; pos + 16 <= length; pos += 16) {
+            if (vmaxvq_u8(vld1q_u8(str + pos)) >= 0x80)
+                break;
+        }
+#endif
+        for (; pos + 8 <= length; pos += 8) {
+            uint64_t word;
+            memcpy(reinterpret_cast<void*>(&word), reinterpret_cast<const void*>(str + pos), sizeof(word));
+            if ((word & 0x8080808080808080) != 0)
+                break;
+        }
+
+        while (pos < length && str[pos] < 0x80)
+            ++pos;
+        return pos;
+    }
+
+    uint64_t CharacterSet::decodeBulk(const uint8_t*& str __attribute__((unused)), uint64_t& length __attribute__((unused)),
+                                      uint8_t* out __attribute__((unused))) const {
+        return 0;
+    }
 }
@@ -38,6 +38,7 @@ namespace OpenLogReplicator {
         [[nodiscard]] uint64_t badChar(Ctx* ctx, typeXid xid, uint64_t byte1, uint64_t byte2, uint64_t byte3, uint64_t byte4, uint64_t byte5) const;
         [[nodiscard]] uint64_t badChar(Ctx* ctx, typeXid xid, uint64_t byte1, uint64_t byte2, uint64_t byte3, uint64_t byte4, uint64_t byte5,
                                        uint64_t byte6) const;
+        [[nodiscard]] static uint64_t asciiLength(const uint8_t* str, uint64_t length);
 
     public:
         const char* name;
@@ -46,6 +47,9 @@ namespace OpenLogReplicator {
         virtual ~CharacterSet();
 
         virtual typeUnicode decode(Ctx* ctx, typeXid xid, const uint8_t*& str, uint64_t& length) const = 0;
+        // Converts leading characters to UTF-8 in one pass and stops at the first character which needs decode(), returns number of bytes
+        // written; the output must have room for 4 bytes for every byte of input
+        virtual uint64_t decodeBulk(const uint8_t*& str, uint64_t& length, uint8_t* out) const;
     };
 }
 
@@ -17,12 +17,18 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <cstring>
+
 #include "CharacterSet7bit.h"
 
 namespace OpenLogReplicator {
     CharacterSet7bit::CharacterSet7bit(const char* newName, const typeUnicode16* newMap) :
             CharacterSet(newName),
-            map(newMap) {
+            map(newMap),
+            utf8Map(),
+            utf8Length(),
+            asciiIdentity(false) {
+        buildUtf8Map(0x7F);
     }
 
     CharacterSet7bit::~CharacterSet7bit() = default;
@@ -37,6 +43,60 @@ namespace OpenLogReplicator {
         return map[character];
     }
 
+    void CharacterSet7bit::buildUtf8Map(uint64_t mask) {
+        asciiIdentity = true;
+        for (uint64_t character = 0; character < 256; ++character) {
+            typeUnicode unicodeCharacter = readMap(character & mask);
+
+            if (unicodeCharacter <= 0x7F) {
+                // 0xxxxxxx
+                utf8Map[character][0] = static_cast<uint8_t>(unicodeCharacter);
+                utf8Length[character] = 1;
+            } else if (unicodeCharacter <= 0x7FF) {
+                // 110xxxxx 10xxxxxx
+                utf8Map[character][0] = 0xC0 | static_cast<uint8_t>(unicodeCharacter >> 6);
+                utf8Map[character][1] = 0x80 | static_cast<uint8_t>(unicodeCharacter & 0x3F);
+                utf8Length[character] = 2;
+            } else {
+                // 1110xxxx 10xxxxxx 10xxxxxx
+                utf8Map[character][0] = 0xE0 | static_cast<uint8_t>(unicodeCharacter >> 12);
+                utf8Map[character][1] = 0x80 | static_cast<uint8_t>((unicodeCharacter >> 6) & 0x3F);
+                utf8Map[character][2] = 0x80 | static_cast<uint8_t>(unicodeCharacter & 0x3F);
+                utf8Length[character] = 3;
+            }
+
+            if (character <= 0x7F && unicodeCharacter != character)
+                asciiIdentity = false;
+        }
+    }
+
+    uint64_t CharacterSet7bit::decodeBulk(const uint8_t*& str, uint64_t& length, uint8_t* out) const {
+        uint8_t* outPos = out;
+        uint64_t pos = 0;
+
+        while (pos < length) {
+            // Runs of ASCII characters are copied when the map does not change them
+            if (asciiIdentity) {
+                uint64_t ascii = asciiLength(str + pos, length - pos);
+                memcpy(reinterpret_cast<void*>(outPos), reinterpret_cast<const void*>(str + pos), ascii);
+                outPos += ascii;
+                pos += ascii;
+                if (pos == length)
+                    break;
+            }
+
+            do {
+                uint64_t character = str[pos++];
+                memcpy(reinterpret_cast<void*>(outPos), reinterpret_cast<const void*>(utf8Map[character]), 4);
+                outPos += utf8Length[character];
+            } while (pos < length && (!asciiIdentity || str[pos] >= 0x80));
+        }
+
+        str += length;
+        length = 0;
+        return static_cast<uint64_t>(outPos - out);
+    }
+
     // Conversion arrays for 7-bit character sets
     typeUnicode16 CharacterSet7bit::unicode_map_D7DEC[128] = {
             0x0000, 0x0001, 0x0002, 0x0003, 0x0004, 0x0005, 0x0006, 0x0007, 0x0008, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, 0x000F, 0x0010, 0x0011,
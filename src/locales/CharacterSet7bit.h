@@ -26,13 +26,20 @@ namespace OpenLogReplicator {
     class CharacterSet7bit : public CharacterSet {
     protected:
         const typeUnicode16* map;
+        // UTF-8 form of every byte value, used to convert whole strings without decoding every character
+        uint8_t utf8Map[256][4];
+        uint8_t utf8Length[256];
+        bool asciiIdentity;
+
         [[nodiscard]] virtual typeUnicode readMap(uint64_t character) const;
+        void buildUtf8Map(uint64_t mask);
 
     public:
         CharacterSet7bit(const char* newName, const typeUnicode16* newMap);
         ~CharacterSet7bit() override;
 
         virtual typeUnicode decode(Ctx* ctx, typeXid xid, const uint8_t*& str, uint64_t& length) const override;
+        virtual uint64_t decodeBulk(const uint8_t*& str, uint64_t& length, uint8_t* out) const override;
 
         // Conversion arrays for 7-bit character sets
         static typeUnicode16 unicode_map_D7DEC[128];
@@ -23,11 +23,13 @@ namespace OpenLogReplicator {
     CharacterSet8bit::CharacterSet8bit(const char* newName, const typeUnicode16* newMap) :
             CharacterSet7bit(newName, newMap),
             customAscii(false) {
+        buildUtf8Map(0xFF);
     }
 
     CharacterSet8bit::CharacterSet8bit(const char* newName, const typeUnicode16* newMap, bool newCustomAscii) :
             CharacterSet7bit(newName, newMap),
             customAscii(newCustomAscii) {
+        buildUtf8Map(0xFF);
     }
 
     CharacterSet8bit::~CharacterSet8bit() = default;
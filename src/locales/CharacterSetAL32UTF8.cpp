@@ -17,6 +17,8 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <cstring>
+
 #include "CharacterSetAL32UTF8.h"
 
 namespace OpenLogReplicator {
@@ -78,4 +80,45 @@ namespace OpenLogReplicator {
 
         return badChar(ctx, xid, byte1, byte2, byte3, byte4);
     }
+
+    uint64_t CharacterSetAL32UTF8::decodeBulk(const uint8_t*& str, uint64_t& length, uint8_t* out) const {
+        uint64_t pos = 0;
+
+        // Well-formed sequences are decoded and encoded back to the same bytes, so they are only validated and copied
+        while (pos < length) {
+            pos += asciiLength(str + pos, length - pos);
+            if (pos == length)
+                break;
+
+            uint64_t byte1 = str[pos];
+            uint64_t left = length - pos;
+
+            // 110xxxxx 10xxxxxx
+            if (byte1 >= 0xC2 && byte1 <= 0xDF) {
+                if (left < 2 || (str[pos + 1] & 0xC0) != 0x80)
+                    break;
+                pos += 2;
+
+            // 1110xxxx 10xxxxxx 10xxxxxx
+            } else if ((byte1 & 0xF0) == 0xE0) {
+                if (left < 3 || (str[pos + 1] & 0xC0) != 0x80 || (str[pos + 2] & 0xC0) != 0x80 || (byte1 == 0xE0 && str[pos + 1] < 0xA0))
+                    break;
+                pos += 3;
+
+            // 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+            } else if (byte1 >= 0xF0 && byte1 <= 0xF4) {
+                if (left < 4 || (str[pos + 1] & 0xC0) != 0x80 || (str[pos + 2] & 0xC0) != 0x80 || (str[pos + 3] & 0xC0) != 0x80 ||
+                        (byte1 == 0xF0 && str[pos + 1] < 0x90) || (byte1 == 0xF4 && str[pos + 1] >= 0x90))
+                    break;
+                pos += 4;
+
+            } else
+                break;
+        }
+
+        memcpy(reinterpret_cast<void*>(out), reinterpret_cast<const void*>(str), pos);
+        str += pos;
+        length -= pos;
+        return pos;
+    }
 }
@@ -17,6 +17,8 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <cstring>
+
 #include "CharacterSetUTF8.h"
 
 namespace OpenLogReplicator {
@@ -90,4 +92,40 @@ namespace OpenLogReplicator {
 
         return ((byte1 & 0x0F) << 12) | ((byte2 & 0x3F) << 6) | (byte3 & 0x3F);
     }
+
+    uint64_t CharacterSetUTF8::decodeBulk(const uint8_t*& str, uint64_t& length, uint8_t* out) const {
+        uint64_t pos = 0;
+
+        // Well-formed sequences are decoded and encoded back to the same bytes, so they are only validated and copied; surrogate pairs
+        // are left for decode()
+        while (pos < length) {
+            pos += asciiLength(str + pos, length - pos);
+            if (pos == length)
+                break;
+
+            uint64_t byte1 = str[pos];
+            uint64_t left = length - pos;
+
+            // 110xxxxx 10xxxxxx
+            if (byte1 >= 0xC2 && byte1 <= 0xDF) {
+                if (left < 2 || (str[pos + 1] & 0xC0) != 0x80)
+                    break;
+                pos += 2;
+
+            // 1110xxxx 10xxxxxx 10xxxxxx
+            } else if ((byte1 & 0xF0) == 0xE0) {
+                if (left < 3 || (str[pos + 1] & 0xC0) != 0x80 || (str[pos + 2] & 0xC0) != 0x80 || (byte1 == 0xE0 && str[pos + 1] < 0xA0) ||
+                        (byte1 == 0xED && (str[pos + 1] & 0xF0) == 0xA0))
+                    break;
+                pos += 3;
+
+            } else
+                break;
+        }
+
+        memcpy(reinterpret_cast<void*>(out), reinterpret_cast<const void*>(str), pos);
+        str += pos;
+        length -= pos;
+        return pos;
+    }
 }
@@ -29,6 +29,7 @@ namespace OpenLogReplicator {
         ~CharacterSetUTF8() override;
 
         virtual typeUnicode decode(Ctx* ctx, typeXid xid, const uint8_t*& str, uint64_t& length) const override;
+        virtual uint64_t decodeBulk(const uint8_t*& str, uint64_t& length, uint8_t* out) const override;
     };
 }
 
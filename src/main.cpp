@@ -63,6 +63,12 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #define HAS_PROMETHEUS ""
 #endif /* LINK_LIBRARY_PROMETHEUS */
 
+#ifdef LINK_LIBRARY_URING
+#define HAS_URING " io_uring"
+#else
+#define HAS_URING ""
+#endif /* LINK_LIBRARY_URING */
+
 #ifdef LINK_STATIC
 #define HAS_STATIC " static"
 #else
@@ -101,7 +107,7 @@ namespace OpenLogReplicator {
         mainCtx->welcome("arch: " + std::string(name.machine) + ", build-arch: " + OpenLogReplicator_CPU_ARCH + ", system: " + name.sysname +
                          ", release: " + name.release + ", build: " +
                          OpenLogReplicator_CMAKE_BUILD_TYPE + ", compiled: " + OpenLogReplicator_CMAKE_BUILD_TIMESTAMP + ", modules:"
-                         HAS_KAFKA HAS_OCI HAS_PROMETHEUS HAS_PROTOBUF HAS_ZEROMQ HAS_STATIC);
+                         HAS_KAFKA HAS_OCI HAS_PROMETHEUS HAS_PROTOBUF HAS_URING HAS_ZEROMQ HAS_STATIC);
 
         const char* fileName = "scripts/OpenLogReplicator.json";
         try {
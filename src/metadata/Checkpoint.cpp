@@ -104,7 +104,7 @@ namespace OpenLogReplicator {
 
         if (!metadata->ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
             static const char* documentNames[] = {"version", "dump-path", "dump-raw-data", "dump-redo-log", "log-level", "trace",
-                                                  "source", "target", nullptr};
+                                                  "source", "target", "memory", "parser-threads", nullptr};
             Ctx::checkJsonFields(configFileName, document, documentNames);
         }
 
@@ -115,19 +115,24 @@ namespace OpenLogReplicator {
 
         // Iterate through sources
         const rapidjson::Value& sourceArrayJson = Ctx::getJsonFieldA(configFileName, document, "source");
-        if (sourceArrayJson.Size() != 1) {
+        if (sourceArrayJson.Size() != 1 && !document.HasMember("memory")) {
             throw ConfigurationException(30001, "bad JSON, invalid 'source' value: " + std::to_string(sourceArrayJson.Size()) +
-                                                " elements, expected: 1 element");
+                                                " elements, expected: 1 element when 'memory' is not set");
         }
 
         for (rapidjson::SizeType j = 0; j < sourceArrayJson.Size(); ++j) {
             const rapidjson::Value& sourceJson = Ctx::getJsonFieldO(configFileName, sourceArrayJson, "source", j);
 
+            // Every source has its own checkpoint thread
+            const char* name = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, sourceJson, "name");
+            if (metadata->database != name)
+                continue;
+
             if (!metadata->ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
                 static const char* sourceNames[] = {"alias", "memory", "name", "reader", "flags", "state", "debug",
                                                     "transaction-max-mb", "metrics", "format", "redo-read-sleep-us", "arch-read-sleep-us",
                                                     "arch-read-tries", "redo-verify-delay-us", "refresh-interval-us", "arch",
-                                                    "filter", nullptr};
+                                                    "filter", "redo-read-queue-depth", "arch-prefetch", nullptr};
                 Ctx::checkJsonFields(configFileName, sourceJson, sourceNames);
             }
 
@@ -201,7 +206,7 @@ namespace OpenLogReplicator {
         ctx->info(0, "scanning objects which match the configuration file");
         // Suspend transaction processing for the schema update
         {
-            std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+            std::unique_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction);
             metadata->commitElements();
             metadata->schema->purgeMetadata();
 
@@ -215,8 +220,7 @@ namespace OpenLogReplicator {
                     msgs.push_back("- creating table schema for owner: " + element->owner + " table: " + element->table + " options: " +
                                    std::to_string(element->options));
 
-                metadata->schema->buildMaps(element->owner, element->table, element->keys, element->keysStr, element->conditionStr, element->options, msgs,
-                                            metadata->suppLogDbPrimary, metadata->suppLogDbAll, metadata->defaultCharacterMapId,
+                metadata->schema->buildMaps(element, msgs, metadata->suppLogDbPrimary, metadata->suppLogDbAll, metadata->defaultCharacterMapId,
                                             metadata->defaultCharacterNcharMapId);
             }
             for (const auto& msg: msgs) {
@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <regex>
 #include <vector>
 
 #include "../common/Ctx.h"
@@ -82,6 +83,8 @@ namespace OpenLogReplicator {
             nextScn(ZERO_SCN),
             clientScn(ZERO_SCN),
             clientIdx(0),
+            writers(0),
+            writersStarted(0),
             checkpoints(0),
             checkpointScn(ZERO_SCN),
             lastCheckpointScn(ZERO_SCN),
@@ -217,9 +220,9 @@ namespace OpenLogReplicator {
         return false;
     }
 
-    bool Metadata::stateWrite(const std::string& name, typeScn scn, const std::ostringstream& out) {
+    bool Metadata::stateWrite(const std::string& name, typeScn scn, const std::ostringstream& out, bool binary) {
         try {
-            state->write(name, scn, out);
+            state->write(name, scn, out, binary);
             return true;
         } catch (RuntimeException& ex) {
             ctx->error(ex.code, ex.msg);
@@ -244,7 +247,13 @@ namespace OpenLogReplicator {
         if (!Ctx::checkNameCase(table))
             throw ConfigurationException(30004, "table '" + std::string(table) +
                                                 "' contains lower case characters, value must be upper case");
-        auto element = new SchemaElement(owner, table, options);
+        SchemaElement* element;
+        try {
+            element = new SchemaElement(owner, table, options);
+        } catch (std::regex_error& ex) {
+            throw ConfigurationException(30011, "invalid regular expression for owner '" + std::string(owner) + "' or table '" +
+                                                std::string(table) + "': " + ex.what());
+        }
         newSchemaElements.push_back(element);
         return element;
     }
@@ -333,6 +342,41 @@ namespace OpenLogReplicator {
         condWriter.notify_all();
     }
 
+    void Metadata::registerWriter() {
+        std::unique_lock<std::mutex> lck(mtxCheckpoint);
+        ++writers;
+    }
+
+    void Metadata::startWriter(typeScn scn, typeIdx idx) {
+        std::unique_lock<std::mutex> lck(mtxCheckpoint);
+
+        // Replication starts from the earliest checkpoint of all writers
+        if (scn != ZERO_SCN && (clientScn == ZERO_SCN || scn < clientScn || (scn == clientScn && idx < clientIdx))) {
+            clientScn = scn;
+            clientIdx = idx;
+        }
+
+        if (++writersStarted < writers) {
+            while (writersStarted < writers && !ctx->hardShutdown) {
+                if (ctx->trace & Ctx::TRACE_SLEEP)
+                    ctx->logTrace(Ctx::TRACE_SLEEP, "Metadata:startWriter");
+                condWriter.wait_for(lck, std::chrono::microseconds(ctx->pollIntervalUs));
+            }
+            return;
+        }
+
+        condWriter.notify_all();
+        if (clientScn == ZERO_SCN)
+            return;
+
+        startScn = clientScn;
+        startSequence = ZERO_SEQ;
+        startTime.clear();
+        startTimeRel = 0;
+        status = METADATA_STATUS_REPLICATE;
+        condReplicator.notify_all();
+    }
+
     void Metadata::wakeUp() {
         std::unique_lock<std::mutex> lck(mtxCheckpoint);
 
@@ -371,18 +415,23 @@ namespace OpenLogReplicator {
                 (checkpointBytes - lastCheckpointBytes) / 1024 / 1024 < ctx->checkpointIntervalMb)
                 return;
 
-            // Schema did not change
-            bool storeSchema = true;
+            uint64_t schemaType = Serializer::SCHEMA_FULL;
             if (schema->refScn != ZERO_SCN && schema->refScn >= schema->scn) {
+                // Schema did not change
                 if (schemaInterval < ctx->schemaForceInterval) {
-                    storeSchema = false;
+                    schemaType = Serializer::SCHEMA_REF;
                     ++schemaInterval;
                 } else
                     schemaInterval = 0;
+            } else if (schema->deltaBaseScn != ZERO_SCN && !schema->deltaFull && schemaInterval < ctx->schemaForceInterval &&
+                       ctx->schemaDeltaMax > 0 && schema->deltaSize() <= ctx->schemaDeltaMax) {
+                // Only changes since the last checkpoint with full schema
+                schemaType = Serializer::SCHEMA_DELTA;
+                ++schemaInterval;
             } else
                 schemaInterval = 0;
 
-            serializer->serialize(this, ss, storeSchema);
+            serializer->serialize(this, ss, schemaType);
 
             lastCheckpointScn = checkpointScn;
             lastSequence = sequence;
@@ -391,7 +440,7 @@ namespace OpenLogReplicator {
             lastCheckpointBytes = checkpointBytes;
             ++checkpoints;
             checkpointScnList.insert(checkpointScn);
-            checkpointSchemaMap.insert_or_assign(checkpointScn, storeSchema);
+            checkpointSchemaMap.insert_or_assign(checkpointScn, schemaType == Serializer::SCHEMA_FULL);
         }
 
         std::string checkpointName = database + "-chkpt-" + std::to_string(lastCheckpointScn);
@@ -401,7 +450,7 @@ namespace OpenLogReplicator {
                                                  std::to_string(lastCheckpointTime.getVal()) + " seq: " + std::to_string(lastSequence) + " offset: " +
                                                  std::to_string(lastCheckpointOffset) + " name: " + checkpointName);
 
-        if (!stateWrite(checkpointName, lastCheckpointScn, ss))
+        if (!stateWrite(checkpointName, lastCheckpointScn, ss, serializer->isBinary()))
             ctx->warning(60018, "file: " + checkpointName + " - couldn't write checkpoint");
     }
 
@@ -458,6 +507,7 @@ namespace OpenLogReplicator {
         std::string ss;
 
         std::string name1(database + "-chkpt-" + std::to_string(scn));
+        schema->deltaLoadScn = ZERO_SCN;
         if (!stateRead(name1, CHECKPOINT_SCHEMA_FILE_MAX_SIZE, ss)) {
             if (ctx->trace & Ctx::TRACE_CHECKPOINT)
                 ctx->logTrace(Ctx::TRACE_CHECKPOINT, "no checkpoint file found, setting unknown sequence");
@@ -477,34 +527,58 @@ namespace OpenLogReplicator {
         }
         msgs.clear();
 
-        // Schema missing
-        if (schema->scn == ZERO_SCN) {
+        // Schema missing, referenced checkpoint file might also be a delta of another checkpoint file
+        typeScn schemaScn = scn;
+        for (uint64_t i = 0; i < 2 && schema->scn == ZERO_SCN; ++i) {
             if (schema->refScn == ZERO_SCN) {
                 ctx->warning(60019, "file: " + name1 + " - load checkpoint failed, reference SCN missing");
                 return;
             }
 
-            ss.clear();
-            std::string name2(database + "-chkpt-" + std::to_string(schema->refScn));
-            ctx->info(0, "reading schema for " + database + " for scn: " + std::to_string(schema->refScn));
-
-            if (!stateRead(name2, CHECKPOINT_SCHEMA_FILE_MAX_SIZE, ss))
+            schemaScn = schema->refScn;
+            if (!readCheckpointSchema(schemaScn))
                 return;
+        }
 
-            if (!serializer->deserialize(this, ss, name2, msgs, false, true)) {
-                for (const auto& msg: msgs) {
-                    ctx->info(0, msg);
-                }
+        if (schema->scn == ZERO_SCN) {
+            ctx->warning(60019, "file: " + name1 + " - load checkpoint failed, reference SCN missing");
+            return;
+        }
+
+        // Changes are tracked relative to the checkpoint file with full schema
+        if (schema->deltaBaseScn == ZERO_SCN)
+            schema->deltaBaseScn = schemaScn;
+
+        // Delta read before its base
+        if (schema->deltaLoadScn != ZERO_SCN) {
+            if (!readCheckpointSchema(schema->deltaLoadScn))
                 return;
-            }
+        }
+
+        if (schema->scn != ZERO_SCN)
+            firstSchemaScn = schema->scn;
+    }
 
+    bool Metadata::readCheckpointSchema(typeScn scn) {
+        std::vector<std::string> msgs;
+        std::string ss;
+        std::string name(database + "-chkpt-" + std::to_string(scn));
+        ctx->info(0, "reading schema for " + database + " for scn: " + std::to_string(scn));
+
+        if (!stateRead(name, CHECKPOINT_SCHEMA_FILE_MAX_SIZE, ss))
+            return false;
+
+        if (!serializer->deserialize(this, ss, name, msgs, false, true)) {
             for (const auto& msg: msgs) {
-                ctx->info(0, "- found: " + msg);
+                ctx->info(0, msg);
             }
+            return false;
         }
 
-        if (schema->scn != ZERO_SCN)
-            firstSchemaScn = schema->scn;
+        for (const auto& msg: msgs) {
+            ctx->info(0, "- found: " + msg);
+        }
+        return true;
     }
 
     void Metadata::deleteOldCheckpoints() {
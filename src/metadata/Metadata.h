@@ -24,6 +24,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <set>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -100,7 +101,7 @@ namespace OpenLogReplicator {
         std::set<RedoLog*> redoLogs;
 
         // Transaction schema consistency mutex
-        std::mutex mtxTransaction;
+        std::shared_mutex mtxTransaction;
 
         // Checkpoint information
         std::mutex mtxCheckpoint;
@@ -115,6 +116,8 @@ namespace OpenLogReplicator {
         typeScn nextScn;
         typeScn clientScn;
         typeIdx clientIdx;
+        uint64_t writers;
+        uint64_t writersStarted;
         uint64_t checkpoints;
         typeScn checkpointScn;
         typeScn lastCheckpointScn;
@@ -152,7 +155,7 @@ namespace OpenLogReplicator {
         void setNextSequence();
         [[nodiscard]] bool stateRead(const std::string& name, uint64_t maxSize, std::string& in);
         [[nodiscard]] bool stateDiskRead(const std::string& name, uint64_t maxSize, std::string& in);
-        [[nodiscard]] bool stateWrite(const std::string& name, typeScn scn, const std::ostringstream& out);
+        [[nodiscard]] bool stateWrite(const std::string& name, typeScn scn, const std::ostringstream& out, bool binary);
         [[nodiscard]] bool stateDrop(const std::string& name);
         SchemaElement* addElement(const char* owner, const char* table, typeOptions options);
         void resetElements();
@@ -163,12 +166,15 @@ namespace OpenLogReplicator {
         void setStatusReady();
         void setStatusStart();
         void setStatusReplicate();
+        void registerWriter();
+        void startWriter(typeScn scn, typeIdx idx);
         void wakeUp();
         void checkpoint(typeScn newCheckpointScn, typeTime newCheckpointTime, typeSeq newCheckpointSequence, uint64_t newCheckpointOffset,
                         uint64_t newCheckpointBytes, typeSeq newMinSequence, uint64_t newMinOffset, typeXid newMinXid);
         void writeCheckpoint(bool force);
         void readCheckpoints();
         void readCheckpoint(typeScn scn);
+        [[nodiscard]] bool readCheckpointSchema(typeScn scn);
         void deleteOldCheckpoints();
         void loadAdaptiveSchema();
         void allowCheckpoints();
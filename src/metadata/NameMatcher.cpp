@@ -0,0 +1,63 @@
+/* Compiled pattern for owner and table names
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include "NameMatcher.h"
+
+namespace OpenLogReplicator {
+    NameMatcher::NameMatcher(const std::string& pattern) :
+            type(TYPE_REGEX) {
+        if (pattern == ".*") {
+            type = TYPE_ANY;
+        } else if (isLiteral(pattern)) {
+            type = TYPE_LITERAL;
+            literal = pattern;
+        } else if (pattern.length() > 2 && pattern.compare(pattern.length() - 2, 2, ".*") == 0 &&
+                   isLiteral(pattern.substr(0, pattern.length() - 2))) {
+            type = TYPE_PREFIX;
+            literal = pattern.substr(0, pattern.length() - 2);
+        } else
+            // throws std::regex_error for invalid patterns
+            regex = std::regex(pattern);
+    }
+
+    bool NameMatcher::isLiteral(const std::string& str) {
+        for (char c: str) {
+            switch (c) {
+                case '\\':
+                case '^':
+                case '$':
+                case '.':
+                case '|':
+                case '?':
+                case '*':
+                case '+':
+                case '(':
+                case ')':
+                case '[':
+                case ']':
+                case '{':
+                case '}':
+                    return false;
+                default:
+                    break;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,67 @@
+/* Header for NameMatcher class
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <regex>
+
+#include "../common/types.h"
+
+#ifndef NAME_MATCHER_H_
+#define NAME_MATCHER_H_
+
+namespace OpenLogReplicator {
+    // Owner or table name pattern compiled once when the configuration is read.
+    // Patterns without regular expression metacharacters are compared as literals or prefixes (LITERAL.*),
+    // all other patterns are compiled to a std::regex which is reused for every match.
+    class NameMatcher final {
+    public:
+        static constexpr uint64_t TYPE_ANY = 0;
+        static constexpr uint64_t TYPE_LITERAL = 1;
+        static constexpr uint64_t TYPE_PREFIX = 2;
+        static constexpr uint64_t TYPE_REGEX = 3;
+
+    protected:
+        uint64_t type;
+        std::string literal;
+        std::regex regex;
+
+        static bool isLiteral(const std::string& str);
+
+    public:
+        explicit NameMatcher(const std::string& pattern);
+
+        [[nodiscard]] bool match(const std::string& name) const {
+            switch (type) {
+                case TYPE_ANY:
+                    return true;
+                case TYPE_LITERAL:
+                    return name == literal;
+                case TYPE_PREFIX:
+                    return name.compare(0, literal.length(), literal) == 0;
+                default:
+                    return std::regex_match(name, regex);
+            }
+        }
+
+        [[nodiscard]] uint64_t getType() const {
+            return type;
+        }
+    };
+}
+
+#endif
@@ -19,8 +19,8 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 #include <cstring>
 #include <vector>
-#include <regex>
 
+#include "../builder/BuilderJson.h"
 #include "../common/Ctx.h"
 #include "../common/OracleColumn.h"
 #include "../common/OracleLob.h"
@@ -62,7 +62,10 @@ namespace OpenLogReplicator {
             columnTmp(nullptr),
             lobTmp(nullptr),
             tableTmp(nullptr),
-            touched(false) {
+            touched(false),
+            deltaBaseScn(ZERO_SCN),
+            deltaLoadScn(ZERO_SCN),
+            deltaFull(false) {
     }
 
     Schema::~Schema() {
@@ -208,6 +211,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::purgeDicts() {
+        deltaReset(ZERO_SCN);
+
         // SYS.CCOL$
         while (!sysCColMapRowId.empty()) {
             auto sysCColMapRowIdIt = sysCColMapRowId.cbegin();
@@ -1141,6 +1146,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysCColAdd(SysCCol* sysCCol) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysCColSetChanged.insert(sysCCol->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.CCOL$ (ROWID: " + sysCCol->rowId.toString() +
                                              ", CON#: " + std::to_string(sysCCol->con) +
@@ -1162,6 +1170,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysCDefAdd(SysCDef* sysCDef) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysCDefSetChanged.insert(sysCDef->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.CDEF$ (ROWID: " + sysCDef->rowId.toString() +
                                              ", CON#: " + std::to_string(sysCDef->con) +
@@ -1187,6 +1198,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysColAdd(SysCol* sysCol) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysColSetChanged.insert(sysCol->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.COL$ (ROWID: " + sysCol->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysCol->obj) +
@@ -1217,6 +1231,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysDeferredStgAdd(SysDeferredStg* sysDeferredStg) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysDeferredStgSetChanged.insert(sysDeferredStg->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.DEFERRED_STG$ (ROWID: " + sysDeferredStg->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysDeferredStg->obj) +
@@ -1235,6 +1252,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysEColAdd(SysECol* sysECol) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysEColSetChanged.insert(sysECol->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.ECOL$ (ROWID: " + sysECol->rowId.toString() +
                                              ", TABOBJ#: " + std::to_string(sysECol->tabObj) +
@@ -1255,6 +1275,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysLobAdd(SysLob* sysLob) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysLobSetChanged.insert(sysLob->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.LOB$ (ROWID: " + sysLob->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysLob->obj) +
@@ -1282,6 +1305,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysLobCompPartAdd(SysLobCompPart* sysLobCompPart) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysLobCompPartSetChanged.insert(sysLobCompPart->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.LOBCOMPPART$ (ROWID: " + sysLobCompPart->rowId.toString() +
                                              ", PARTOBJ#: " + std::to_string(sysLobCompPart->partObj) +
@@ -1309,6 +1335,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysLobFragAdd(SysLobFrag* sysLobFrag) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysLobFragSetChanged.insert(sysLobFrag->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.LOBFRAG$ (ROWID: " + sysLobFrag->rowId.toString() +
                                              ", FRAGOBJ#: " + std::to_string(sysLobFrag->fragObj) +
@@ -1337,6 +1366,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysObjAdd(SysObj* sysObj) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysObjSetChanged.insert(sysObj->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.OBJ$ (ROWID: " + sysObj->rowId.toString() +
                                              ", OWNER#: " + std::to_string(sysObj->owner) +
@@ -1365,6 +1397,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTabAdd(SysTab* sysTab) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTabSetChanged.insert(sysTab->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.TAB$ (ROWID: " + sysTab->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysTab->obj) +
@@ -1385,6 +1420,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTabComPartAdd(SysTabComPart* sysTabComPart) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTabComPartSetChanged.insert(sysTabComPart->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.TABCOMPART$ (ROWID: " + sysTabComPart->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysTabComPart->obj) +
@@ -1410,6 +1448,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTabPartAdd(SysTabPart* sysTabPart) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTabPartSetChanged.insert(sysTabPart->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.TABPART$ (ROWID: " + sysTabPart->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysTabPart->obj) +
@@ -1430,6 +1471,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTabSubPartAdd(SysTabSubPart* sysTabSubPart) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTabSubPartSetChanged.insert(sysTabSubPart->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.TABSUBPART$ (ROWID: " + sysTabSubPart->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysTabSubPart->obj) +
@@ -1452,6 +1496,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTsAdd(SysTs* sysTs) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTsSetChanged.insert(sysTs->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.TS$ (ROWID: " + sysTs->rowId.toString() +
                                              ", TS#: " + std::to_string(sysTs->ts) +
@@ -1468,6 +1515,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysUserAdd(SysUser* sysUser) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysUserSetChanged.insert(sysUser->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert SYS.USER$ (ROWID: " + sysUser->rowId.toString() +
                                              ", USER#: " + std::to_string(sysUser->user) +
@@ -1485,6 +1535,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictXdbTtSetAdd(XdbTtSet* xdbTtSet) {
+        deltaFull = true;
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert XDB.XDB$TTSET (ROWID: " + xdbTtSet->rowId.toString() +
                                              ", GUID: '" + xdbTtSet->guid +
@@ -1502,6 +1554,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictXdbXNmAdd(const std::string& tokSuf, XdbXNm* xdbXNm) {
+        deltaFull = true;
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert XDB.X$NM" + tokSuf + " (ROWID: " + xdbXNm->rowId.toString() +
                                              ", NMSPCURI: '" + xdbXNm->nmSpcUri +
@@ -1515,6 +1569,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictXdbXPtAdd(const std::string& tokSuf, XdbXPt* xdbXPt) {
+        deltaFull = true;
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert XDB.X$PT" + tokSuf + " (ROWID: " + xdbXPt->rowId.toString() +
                                              ", PATH: '" + xdbXPt->path +
@@ -1528,6 +1584,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictXdbXQnAdd(const std::string& tokSuf, XdbXQn* xdbXQn) {
+        deltaFull = true;
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "insert XDB.X$QN" + tokSuf + " (ROWID: " + xdbXQn->rowId.toString() +
                                              ", NMSPCID: '" + xdbXQn->nmSpcId +
@@ -1543,6 +1601,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysCColDrop(SysCCol* sysCCol) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysCColSetChanged.insert(sysCCol->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.CCOL$ (ROWID: " + sysCCol->rowId.toString() +
                                              ", CON#: " + std::to_string(sysCCol->con) +
@@ -1567,6 +1628,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysCDefDrop(SysCDef* sysCDef) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysCDefSetChanged.insert(sysCDef->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.CDEF$ (ROWID: " + sysCDef->rowId.toString() +
                                              ", CON#: " + std::to_string(sysCDef->con) +
@@ -1596,6 +1660,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysColDrop(SysCol* sysCol) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysColSetChanged.insert(sysCol->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.COL$ (ROWID: " + sysCol->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysCol->obj) +
@@ -1629,6 +1696,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysDeferredStgDrop(SysDeferredStg* sysDeferredStg) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysDeferredStgSetChanged.insert(sysDeferredStg->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.DEFERRED_STG$ (ROWID: " + sysDeferredStg->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysDeferredStg->obj) +
@@ -1649,6 +1719,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysEColDrop(SysECol* sysECol) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysEColSetChanged.insert(sysECol->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.ECOL$ (ROWID: " + sysECol->rowId.toString() +
                                              ", TABOBJ#: " + std::to_string(sysECol->tabObj) +
@@ -1672,6 +1745,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysLobDrop(SysLob* sysLob) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysLobSetChanged.insert(sysLob->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.LOB$ (ROWID: " + sysLob->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysLob->obj) +
@@ -1703,6 +1779,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysLobCompPartDrop(SysLobCompPart* sysLobCompPart) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysLobCompPartSetChanged.insert(sysLobCompPart->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.LOBCOMPPART$ (ROWID: " + sysLobCompPart->rowId.toString() +
                                              ", PARTOBJ#: " + std::to_string(sysLobCompPart->partObj) +
@@ -1733,6 +1812,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysLobFragDrop(SysLobFrag* sysLobFrag) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysLobFragSetChanged.insert(sysLobFrag->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.LOBFRAG$ (ROWID: " + sysLobFrag->rowId.toString() +
                                              ", FRAGOBJ#: " + std::to_string(sysLobFrag->fragObj) +
@@ -1765,6 +1847,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysObjDrop(SysObj* sysObj) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysObjSetChanged.insert(sysObj->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.OBJ$ (ROWID: " + sysObj->rowId.toString() +
                                              ", OWNER#: " + std::to_string(sysObj->owner) +
@@ -1797,6 +1882,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTabDrop(SysTab* sysTab) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTabSetChanged.insert(sysTab->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.TAB$ (ROWID: " + sysTab->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysTab->obj) +
@@ -1820,6 +1908,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTabComPartDrop(SysTabComPart* sysTabComPart) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTabComPartSetChanged.insert(sysTabComPart->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.TABCOMPART$ (ROWID: " + sysTabComPart->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysTabComPart->obj) +
@@ -1849,6 +1940,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTabPartDrop(SysTabPart* sysTabPart) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTabPartSetChanged.insert(sysTabPart->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.TABPART$ (ROWID: " + sysTabPart->rowId.toString() +
                                              ", OBJ#: " + std::to_string(sysTabPart->obj) +
@@ -1872,6 +1966,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTabSubPartDrop(SysTabSubPart* sysTabSubPart) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTabSubPartSetChanged.insert(sysTabSubPart->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.TABSUBPART$ (ROWID: " + sysTabSubPart->rowId.toString() +
                                         ", OBJ#: " + std::to_string(sysTabSubPart->obj) +
@@ -1897,6 +1994,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysTsDrop(SysTs* sysTs) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysTsSetChanged.insert(sysTs->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.TS$ (ROWID: " + sysTs->rowId.toString() +
                                              ", TS#: " + std::to_string(sysTs->ts) +
@@ -1916,6 +2016,9 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictSysUserDrop(SysUser* sysUser) {
+        if (deltaBaseScn != ZERO_SCN)
+            sysUserSetChanged.insert(sysUser->rowId);
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete SYS.USER$ (ROWID: " + sysUser->rowId.toString() +
                                              ", USER#: " + std::to_string(sysUser->user) +
@@ -1935,6 +2038,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictXdbTtSetDrop(XdbTtSet* xdbTtSet) {
+        deltaFull = true;
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete XDB.XDB$TTSET (ROWID: " + xdbTtSet->rowId.toString() +
                                              ", GUID: '" + xdbTtSet->guid +
@@ -1955,6 +2060,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictXdbXNmDrop(const std::string& tokSuf, XdbXNm* xdbXNm) {
+        deltaFull = true;
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete XDB.X$NM" + tokSuf + " (ROWID: " + xdbXNm->rowId.toString() +
                                              ", NMSPCURI: '" + xdbXNm->nmSpcUri +
@@ -1968,6 +2075,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictXdbXPtDrop(const std::string& tokSuf, XdbXPt* xdbXPt) {
+        deltaFull = true;
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete XDB.X$PT" + tokSuf + " (ROWID: " + xdbXPt->rowId.toString() +
                                              ", PATH: '" + xdbXPt->path +
@@ -1981,6 +2090,8 @@ namespace OpenLogReplicator {
     }
 
     void Schema::dictXdbXQnDrop(const std::string& tokSuf, XdbXQn* xdbXQn) {
+        deltaFull = true;
+
         if (ctx->trace & Ctx::TRACE_SYSTEM)
             ctx->logTrace(Ctx::TRACE_SYSTEM, "delete XDB.X$QN" + tokSuf + " (ROWID: " + xdbXQn->rowId.toString() +
                                              ", NMSPCID '" + xdbXQn->nmSpcId +
@@ -2226,9 +2337,10 @@ namespace OpenLogReplicator {
             }
         }
 
-        if (tablePartitionMap.find(table->obj) == tablePartitionMap.end())
+        if (tablePartitionMap.find(table->obj) == tablePartitionMap.end()) {
             tablePartitionMap.insert_or_assign(table->obj, table);
-        else
+            tableFilter.add(table->obj);
+        } else
             throw DataException(50033, "can't add partition (obj: " + std::to_string(table->obj) + ", dataobj: " +
                                        std::to_string(table->dataObj) + ")");
 
@@ -2236,9 +2348,10 @@ namespace OpenLogReplicator {
             typeObj obj = objx >> 32;
             typeDataObj dataObj = objx & 0xFFFFFFFF;
 
-            if (tablePartitionMap.find(obj) == tablePartitionMap.end())
+            if (tablePartitionMap.find(obj) == tablePartitionMap.end()) {
                 tablePartitionMap.insert_or_assign(obj, table);
-            else
+                tableFilter.add(obj);
+            } else
                 throw DataException(50034, "can't add partition element (obj: " + std::to_string(obj) + ", dataobj: " +
                                            std::to_string(dataObj) + ")");
         }
@@ -2323,12 +2436,9 @@ namespace OpenLogReplicator {
                         continue;
 
                     // SYS or XDB user, check if matches list of system table
-                    for (SchemaElement* element: schemaElements) {
-                        std::regex regexOwner(element->owner);
-                        std::regex regexTable(element->table);
-
+                    for (const SchemaElement* element: schemaElements) {
                         // matches, keep it
-                        if (regex_match(sysUser->name, regexOwner) && regex_match(sysObj->name, regexTable))
+                        if (element->ownerMatcher.match(sysUser->name) && element->tableMatcher.match(sysObj->name))
                             continue;
                     }
                 }
@@ -2469,6 +2579,33 @@ namespace OpenLogReplicator {
         touched = false;
     }
 
+    void Schema::deltaReset(typeScn newDeltaBaseScn) {
+        deltaBaseScn = newDeltaBaseScn;
+        deltaFull = false;
+        sysCColSetChanged.clear();
+        sysCDefSetChanged.clear();
+        sysColSetChanged.clear();
+        sysDeferredStgSetChanged.clear();
+        sysEColSetChanged.clear();
+        sysLobSetChanged.clear();
+        sysLobCompPartSetChanged.clear();
+        sysLobFragSetChanged.clear();
+        sysObjSetChanged.clear();
+        sysTabSetChanged.clear();
+        sysTabComPartSetChanged.clear();
+        sysTabPartSetChanged.clear();
+        sysTabSubPartSetChanged.clear();
+        sysTsSetChanged.clear();
+        sysUserSetChanged.clear();
+    }
+
+    uint64_t Schema::deltaSize() const {
+        return sysCColSetChanged.size() + sysCDefSetChanged.size() + sysColSetChanged.size() + sysDeferredStgSetChanged.size() +
+               sysEColSetChanged.size() + sysLobSetChanged.size() + sysLobCompPartSetChanged.size() + sysLobFragSetChanged.size() +
+               sysObjSetChanged.size() + sysTabSetChanged.size() + sysTabComPartSetChanged.size() + sysTabPartSetChanged.size() +
+               sysTabSubPartSetChanged.size() + sysTsSetChanged.size() + sysUserSetChanged.size();
+    }
+
     void Schema::updateXmlCtx() {
         if (ctx->flagsSet(Ctx::REDO_FLAGS_EXPERIMENTAL_XMLTYPE)) {
             xmlCtxDefault = nullptr;
@@ -2485,11 +2622,11 @@ namespace OpenLogReplicator {
         }
     }
 
-    void Schema::buildMaps(const std::string& owner, const std::string& table, const std::vector<std::string>& keys, const std::string& keysStr,
-                           const std::string& conditionStr, typeOptions options, std::vector<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll,
+    void Schema::buildMaps(const SchemaElement* element, std::vector<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll,
                            uint64_t defaultCharacterMapId, uint64_t defaultCharacterNcharMapId) {
-        std::regex regexOwner(owner);
-        std::regex regexTable(table);
+        const std::vector<std::string>& keys = element->keys;
+        const std::string& keysStr = element->keysStr;
+        typeOptions options = element->options;
         char sysLobConstraintName[26] = "SYS_LOB0000000000C00000$$";
 
         for (auto obj: identifiersTouched) {
@@ -2498,7 +2635,7 @@ namespace OpenLogReplicator {
                 continue;
             SysObj* sysObj = sysObjMapObjTouchedIt->second;
 
-            if (sysObj->isDropped() || !sysObj->isTable() || !regex_match(sysObj->name, regexTable))
+            if (sysObj->isDropped() || !sysObj->isTable() || !element->tableMatcher.match(sysObj->name))
                 continue;
 
             SysUser* sysUser = nullptr;
@@ -2510,7 +2647,7 @@ namespace OpenLogReplicator {
                 sysUser = &sysUserAdaptive;
             } else {
                 sysUser = sysUserMapUserIt->second;
-                if (!regex_match(sysUser->name, regexOwner))
+                if (!element->ownerMatcher.match(sysUser->name))
                     continue;
             }
 
@@ -2581,6 +2718,8 @@ namespace OpenLogReplicator {
 
             tableTmp = new OracleTable(sysObj->obj, sysTab->dataObj, sysObj->owner, sysTab->cluCols,
                                        options, sysUser->name, sysObj->name);
+            tableTmp->schemaJson = R"("schema":{"owner":")" + BuilderJson::jsonEscape(tableTmp->owner) + R"(","table":")" +
+                                   BuilderJson::jsonEscape(tableTmp->name) + '"';
 
             uint64_t lobPartitions = 0;
             uint64_t lobIndexes = 0;
@@ -2734,6 +2873,7 @@ namespace OpenLogReplicator {
                                                                                      !(xmlType && ctx->flagsSet(Ctx::REDO_FLAGS_EXPERIMENTAL_XMLTYPE)),
                                              sysCol->isStoredAsLob(), sysCol->isSystemGenerated(), sysCol->isNested(),
                                              sysCol->isUnused(), sysCol->isAdded(), sysCol->isGuard(), xmlType);
+                columnTmp->nameJson = "\"" + BuilderJson::jsonEscape(columnTmp->name) + "\":";
 
                 tableTmp->addColumn(columnTmp);
                 columnTmp = nullptr;
@@ -2917,7 +3057,7 @@ namespace OpenLogReplicator {
             }
             msgs.push_back(ss.str());
 
-            tableTmp->setConditionStr(conditionStr);
+            tableTmp->setConditionStr(element->conditionStr);
             addTableToDict(tableTmp);
             tableTmp = nullptr;
         }
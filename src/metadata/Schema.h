@@ -25,6 +25,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <unordered_map>
 #include <vector>
 
+#include "../common/ObjectFilter.h"
 #include "../common/typeRowId.h"
 #include "../common/typeXid.h"
 #include "../common/types.h"
@@ -127,6 +128,7 @@ namespace OpenLogReplicator {
         std::unordered_map<typeDataObj, OracleLob*> lobIndexMap;
         std::unordered_map<typeObj, OracleTable*> tableMap;
         std::unordered_map<typeObj, OracleTable*> tablePartitionMap;
+        ObjectFilter tableFilter;
         XmlCtx* xmlCtxDefault;
         OracleColumn* columnTmp;
         OracleLob* lobTmp;
@@ -135,6 +137,28 @@ namespace OpenLogReplicator {
         std::set<typeObj> identifiersTouched;
         bool touched;
 
+        // Rows changed since the last checkpoint with full schema (deltaBaseScn), stored in delta checkpoints.
+        // Changes of XDB dictionaries are not tracked, they force the next checkpoint to contain the full schema.
+        // While reading checkpoints deltaLoadScn is the delta checkpoint to apply once its base is loaded.
+        typeScn deltaBaseScn;
+        typeScn deltaLoadScn;
+        bool deltaFull;
+        std::set<typeRowId> sysCColSetChanged;
+        std::set<typeRowId> sysCDefSetChanged;
+        std::set<typeRowId> sysColSetChanged;
+        std::set<typeRowId> sysDeferredStgSetChanged;
+        std::set<typeRowId> sysEColSetChanged;
+        std::set<typeRowId> sysLobSetChanged;
+        std::set<typeRowId> sysLobCompPartSetChanged;
+        std::set<typeRowId> sysLobFragSetChanged;
+        std::set<typeRowId> sysObjSetChanged;
+        std::set<typeRowId> sysTabSetChanged;
+        std::set<typeRowId> sysTabComPartSetChanged;
+        std::set<typeRowId> sysTabPartSetChanged;
+        std::set<typeRowId> sysTabSubPartSetChanged;
+        std::set<typeRowId> sysTsSetChanged;
+        std::set<typeRowId> sysUserSetChanged;
+
         // SYS.CCOL$
         std::map<typeRowId, SysCCol*> sysCColMapRowId;
         std::map<SysCColKey, SysCCol*> sysCColMapKey;
@@ -316,10 +340,11 @@ namespace OpenLogReplicator {
         [[nodiscard]] OracleLob* checkLobDict(typeDataObj dataObj) const;
         [[nodiscard]] OracleLob* checkLobIndexDict(typeDataObj dataObj) const;
         void dropUnusedMetadata(const std::set<std::string>& users, const std::vector<SchemaElement*>& schemaElements, std::vector<std::string>& msgs);
-        void buildMaps(const std::string& owner, const std::string& table, const std::vector<std::string>& keys, const std::string& keysStr,
-                       const std::string& conditionStr, typeOptions options, std::vector<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll,
+        void buildMaps(const SchemaElement* element, std::vector<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll,
                        uint64_t defaultCharacterMapId, uint64_t defaultCharacterNcharMapId);
         void resetTouched();
+        void deltaReset(typeScn newDeltaBaseScn);
+        [[nodiscard]] uint64_t deltaSize() const;
         void updateXmlCtx();
     };
 }
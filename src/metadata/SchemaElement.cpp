@@ -23,6 +23,8 @@ namespace OpenLogReplicator {
     SchemaElement::SchemaElement(const char* newOwner, const char* newTable, typeOptions newOptions) :
             owner(newOwner),
             table(newTable),
-            options(newOptions) {
+            options(newOptions),
+            ownerMatcher(owner),
+            tableMatcher(table) {
     }
 }
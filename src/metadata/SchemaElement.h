@@ -20,6 +20,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <vector>
 
 #include "../common/types.h"
+#include "NameMatcher.h"
 
 #ifndef SCHEMA_ELEMENT_H_
 #define SCHEMA_ELEMENT_H_
@@ -33,6 +34,8 @@ namespace OpenLogReplicator {
         std::string keysStr;
         std::string conditionStr;
         typeOptions options;
+        NameMatcher ownerMatcher;
+        NameMatcher tableMatcher;
 
         SchemaElement(const char* newOwner, const char* newTable, typeOptions newOptions);
     };
@@ -31,12 +31,18 @@ namespace OpenLogReplicator {
 
     class Serializer {
     public:
+        // Schema stored in the checkpoint file
+        static constexpr uint64_t SCHEMA_REF = 0;
+        static constexpr uint64_t SCHEMA_FULL = 1;
+        static constexpr uint64_t SCHEMA_DELTA = 2;
+
         Serializer();
         virtual ~Serializer();
 
         [[nodiscard]] virtual bool deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::vector<std::string>& msgs,
                                                bool loadMetadata, bool storeSchema) = 0;
-        virtual void serialize(Metadata* metadata, std::ostringstream& ss, bool noSchema) = 0;
+        virtual void serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaType) = 0;
+        [[nodiscard]] virtual bool isBinary() const = 0;
     };
 }
 
@@ -0,0 +1,781 @@
+/* Base class for serialization of metadata to binary format
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <cstring>
+#include <thread>
+
+#include "../common/Ctx.h"
+#include "../common/typeIntX.h"
+#include "../common/typeRowId.h"
+#include "../common/exception/DataException.h"
+#include "../common/exception/RuntimeException.h"
+#include "../common/table/SysCCol.h"
+#include "../common/table/SysCDef.h"
+#include "../common/table/SysCol.h"
+#include "../common/table/SysDeferredStg.h"
+#include "../common/table/SysECol.h"
+#include "../common/table/SysLob.h"
+#include "../common/table/SysLobCompPart.h"
+#include "../common/table/SysLobFrag.h"
+#include "../common/table/SysObj.h"
+#include "../common/table/SysTab.h"
+#include "../common/table/SysTabComPart.h"
+#include "../common/table/SysTabPart.h"
+#include "../common/table/SysTabSubPart.h"
+#include "../common/table/SysTs.h"
+#include "../common/table/SysUser.h"
+#include "Metadata.h"
+#include "Schema.h"
+#include "SerializerBinary.h"
+
+namespace OpenLogReplicator {
+    const char SerializerBinary::MAGIC[MAGIC_LENGTH + 1] = "OLRCHKPT";
+    const char* SerializerBinary::SECTION_NAMES[SECTIONS] = {"header", "sys-ccol", "sys-cdef", "sys-col", "sys-deferredstg", "sys-ecol",
+                                                             "sys-lob", "sys-lob-comp-part", "sys-lob-frag", "sys-obj", "sys-tab",
+                                                             "sys-tabcompart", "sys-tabpart", "sys-tabsubpart", "sys-ts", "sys-user"};
+    uint32_t SerializerBinary::CRC32[256];
+
+    SerializerBinary::SerializerBinary() :
+            SerializerJson(),
+            data(nullptr),
+            dataLength(0) {
+        for (uint64_t section = 0; section < SECTIONS; ++section) {
+            sectionRows[section] = 0;
+            sectionUsed[section] = false;
+            sectionOffset[section] = 0;
+            sectionLength[section] = 0;
+            sectionRowsRead[section] = 0;
+            sectionChecksum[section] = 0;
+            sectionFound[section] = false;
+        }
+        initializeCRC32();
+    }
+
+    SerializerBinary::~SerializerBinary() = default;
+
+    void SerializerBinary::initializeCRC32() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (uint64_t j = 0; j < 8; ++j)
+                value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+            CRC32[i] = value;
+        }
+    }
+
+    uint32_t SerializerBinary::checksum(const uint8_t* buffer, uint64_t length) {
+        uint32_t value = 0xFFFFFFFF;
+        for (uint64_t i = 0; i < length; ++i)
+            value = CRC32[(value ^ buffer[i]) & 0xFF] ^ (value >> 8);
+        return value ^ 0xFFFFFFFF;
+    }
+
+    bool SerializerBinary::isBinary() const {
+        return true;
+    }
+
+    void SerializerBinary::append16(std::string& buffer, uint16_t value) {
+        buffer.push_back(static_cast<char>(value & 0xFF));
+        buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+    }
+
+    void SerializerBinary::append32(std::string& buffer, uint32_t value) {
+        append16(buffer, static_cast<uint16_t>(value & 0xFFFF));
+        append16(buffer, static_cast<uint16_t>((value >> 16) & 0xFFFF));
+    }
+
+    void SerializerBinary::append64(std::string& buffer, uint64_t value) {
+        append32(buffer, static_cast<uint32_t>(value & 0xFFFFFFFF));
+        append32(buffer, static_cast<uint32_t>((value >> 32) & 0xFFFFFFFF));
+    }
+
+    void SerializerBinary::appendIntX(std::string& buffer, const typeIntX& value) {
+        append64(buffer, value.getData(0));
+        append64(buffer, value.getData(1));
+    }
+
+    void SerializerBinary::appendRowId(std::string& buffer, typeRowId rowId) {
+        append32(buffer, rowId.dataObj);
+        append32(buffer, rowId.dba);
+        append16(buffer, rowId.slot);
+    }
+
+    void SerializerBinary::appendString(std::string& buffer, const std::string& value) {
+        append32(buffer, value.length());
+        buffer.append(value);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysCCol* sysCCol) {
+        appendRowId(buffer, sysCCol->rowId);
+        append32(buffer, sysCCol->con);
+        append16(buffer, sysCCol->intCol);
+        append32(buffer, sysCCol->obj);
+        appendIntX(buffer, sysCCol->spare1);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysCDef* sysCDef) {
+        appendRowId(buffer, sysCDef->rowId);
+        append32(buffer, sysCDef->con);
+        append32(buffer, sysCDef->obj);
+        append16(buffer, sysCDef->type);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysCol* sysCol) {
+        appendRowId(buffer, sysCol->rowId);
+        append32(buffer, sysCol->obj);
+        append16(buffer, sysCol->col);
+        append16(buffer, sysCol->segCol);
+        append16(buffer, sysCol->intCol);
+        appendString(buffer, sysCol->name);
+        append16(buffer, sysCol->type);
+        append64(buffer, sysCol->length);
+        append64(buffer, sysCol->precision);
+        append64(buffer, sysCol->scale);
+        append64(buffer, sysCol->charsetForm);
+        append64(buffer, sysCol->charsetId);
+        append64(buffer, sysCol->null_);
+        appendIntX(buffer, sysCol->property);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysDeferredStg* sysDeferredStg) {
+        appendRowId(buffer, sysDeferredStg->rowId);
+        append32(buffer, sysDeferredStg->obj);
+        appendIntX(buffer, sysDeferredStg->flagsStg);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysECol* sysECol) {
+        appendRowId(buffer, sysECol->rowId);
+        append32(buffer, sysECol->tabObj);
+        append16(buffer, sysECol->colNum);
+        append16(buffer, sysECol->guardId);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysLob* sysLob) {
+        appendRowId(buffer, sysLob->rowId);
+        append32(buffer, sysLob->obj);
+        append16(buffer, sysLob->col);
+        append16(buffer, sysLob->intCol);
+        append32(buffer, sysLob->lObj);
+        append32(buffer, sysLob->ts);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysLobCompPart* sysLobCompPart) {
+        appendRowId(buffer, sysLobCompPart->rowId);
+        append32(buffer, sysLobCompPart->partObj);
+        append32(buffer, sysLobCompPart->lObj);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysLobFrag* sysLobFrag) {
+        appendRowId(buffer, sysLobFrag->rowId);
+        append32(buffer, sysLobFrag->fragObj);
+        append32(buffer, sysLobFrag->parentObj);
+        append32(buffer, sysLobFrag->ts);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysObj* sysObj) {
+        appendRowId(buffer, sysObj->rowId);
+        append32(buffer, sysObj->owner);
+        append32(buffer, sysObj->obj);
+        append32(buffer, sysObj->dataObj);
+        append16(buffer, sysObj->type);
+        appendString(buffer, sysObj->name);
+        appendIntX(buffer, sysObj->flags);
+        append16(buffer, sysObj->single ? 1 : 0);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysTab* sysTab) {
+        appendRowId(buffer, sysTab->rowId);
+        append32(buffer, sysTab->obj);
+        append32(buffer, sysTab->dataObj);
+        append32(buffer, sysTab->ts);
+        append16(buffer, sysTab->cluCols);
+        appendIntX(buffer, sysTab->flags);
+        appendIntX(buffer, sysTab->property);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysTabComPart* sysTabComPart) {
+        appendRowId(buffer, sysTabComPart->rowId);
+        append32(buffer, sysTabComPart->obj);
+        append32(buffer, sysTabComPart->dataObj);
+        append32(buffer, sysTabComPart->bo);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysTabPart* sysTabPart) {
+        appendRowId(buffer, sysTabPart->rowId);
+        append32(buffer, sysTabPart->obj);
+        append32(buffer, sysTabPart->dataObj);
+        append32(buffer, sysTabPart->bo);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysTabSubPart* sysTabSubPart) {
+        appendRowId(buffer, sysTabSubPart->rowId);
+        append32(buffer, sysTabSubPart->obj);
+        append32(buffer, sysTabSubPart->dataObj);
+        append32(buffer, sysTabSubPart->pObj);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysTs* sysTs) {
+        appendRowId(buffer, sysTs->rowId);
+        append32(buffer, sysTs->ts);
+        appendString(buffer, sysTs->name);
+        append32(buffer, sysTs->blockSize);
+    }
+
+    void SerializerBinary::appendRow(std::string& buffer, const SysUser* sysUser) {
+        appendRowId(buffer, sysUser->rowId);
+        append32(buffer, sysUser->user);
+        appendString(buffer, sysUser->name);
+        appendIntX(buffer, sysUser->spare1);
+        append16(buffer, sysUser->single ? 1 : 0);
+    }
+
+    template<class VALUE>
+    void SerializerBinary::serializeSection(uint64_t section, const std::map<typeRowId, VALUE*>& mapRowId, const std::set<typeRowId>* setChanged) {
+        std::string& buffer = sectionData[section];
+        sectionUsed[section] = true;
+
+        if (setChanged == nullptr) {
+            for (auto mapRowIdIt: mapRowId) {
+                appendRow(buffer, mapRowIdIt.second);
+                ++sectionRows[section];
+            }
+        } else {
+            for (auto rowId: *setChanged) {
+                auto mapRowIdIt = mapRowId.find(rowId);
+                // Deleted row, present only in "schema-drop" of the header
+                if (mapRowIdIt == mapRowId.end())
+                    continue;
+
+                appendRow(buffer, mapRowIdIt->second);
+                ++sectionRows[section];
+            }
+        }
+    }
+
+    void SerializerBinary::serializeSys(std::ostringstream& ss __attribute__((unused)), Schema* schema, bool delta) {
+        serializeSection(SECTION_SYS_CCOL, schema->sysCColMapRowId, delta ? &schema->sysCColSetChanged : nullptr);
+        serializeSection(SECTION_SYS_CDEF, schema->sysCDefMapRowId, delta ? &schema->sysCDefSetChanged : nullptr);
+        serializeSection(SECTION_SYS_COL, schema->sysColMapRowId, delta ? &schema->sysColSetChanged : nullptr);
+        serializeSection(SECTION_SYS_DEFERREDSTG, schema->sysDeferredStgMapRowId, delta ? &schema->sysDeferredStgSetChanged : nullptr);
+        serializeSection(SECTION_SYS_ECOL, schema->sysEColMapRowId, delta ? &schema->sysEColSetChanged : nullptr);
+        serializeSection(SECTION_SYS_LOB, schema->sysLobMapRowId, delta ? &schema->sysLobSetChanged : nullptr);
+        serializeSection(SECTION_SYS_LOB_COMP_PART, schema->sysLobCompPartMapRowId, delta ? &schema->sysLobCompPartSetChanged : nullptr);
+        serializeSection(SECTION_SYS_LOB_FRAG, schema->sysLobFragMapRowId, delta ? &schema->sysLobFragSetChanged : nullptr);
+        serializeSection(SECTION_SYS_OBJ, schema->sysObjMapRowId, delta ? &schema->sysObjSetChanged : nullptr);
+        serializeSection(SECTION_SYS_TAB, schema->sysTabMapRowId, delta ? &schema->sysTabSetChanged : nullptr);
+        serializeSection(SECTION_SYS_TABCOMPART, schema->sysTabComPartMapRowId, delta ? &schema->sysTabComPartSetChanged : nullptr);
+        serializeSection(SECTION_SYS_TABPART, schema->sysTabPartMapRowId, delta ? &schema->sysTabPartSetChanged : nullptr);
+        serializeSection(SECTION_SYS_TABSUBPART, schema->sysTabSubPartMapRowId, delta ? &schema->sysTabSubPartSetChanged : nullptr);
+        serializeSection(SECTION_SYS_TS, schema->sysTsMapRowId, delta ? &schema->sysTsSetChanged : nullptr);
+        serializeSection(SECTION_SYS_USER, schema->sysUserMapRowId, delta ? &schema->sysUserSetChanged : nullptr);
+    }
+
+    void SerializerBinary::serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaType) {
+        for (uint64_t section = 0; section < SECTIONS; ++section) {
+            sectionData[section].clear();
+            sectionRows[section] = 0;
+            sectionUsed[section] = false;
+        }
+
+        // The SYS tables are collected to sections by serializeSys()
+        std::ostringstream header;
+        SerializerJson::serialize(metadata, header, schemaType);
+        sectionData[SECTION_HEADER] = header.str();
+        sectionUsed[SECTION_HEADER] = true;
+
+        uint64_t sections = 0;
+        for (uint64_t section = 0; section < SECTIONS; ++section)
+            if (sectionUsed[section])
+                ++sections;
+
+        std::string sectionTable;
+        uint64_t offset = HEADER_LENGTH + sections * SECTION_ENTRY_LENGTH;
+        for (uint64_t section = 0; section < SECTIONS; ++section) {
+            if (!sectionUsed[section])
+                continue;
+
+            const std::string& buffer = sectionData[section];
+            append32(sectionTable, section);
+            append32(sectionTable, checksum(reinterpret_cast<const uint8_t*>(buffer.c_str()), buffer.length()));
+            append64(sectionTable, sectionRows[section]);
+            append64(sectionTable, offset);
+            append64(sectionTable, buffer.length());
+            offset += (buffer.length() + SECTION_ALIGN - 1) & ~(SECTION_ALIGN - 1);
+        }
+
+        std::string fileHeader(MAGIC, MAGIC_LENGTH);
+        append32(fileHeader, VERSION);
+        append32(fileHeader, sections);
+        append32(fileHeader, checksum(reinterpret_cast<const uint8_t*>(sectionTable.c_str()), sectionTable.length()));
+        append32(fileHeader, 0);
+
+        static const char padding[SECTION_ALIGN] = {0};
+        ss.write(fileHeader.c_str(), fileHeader.length());
+        ss.write(sectionTable.c_str(), sectionTable.length());
+        for (uint64_t section = 0; section < SECTIONS; ++section) {
+            if (!sectionUsed[section])
+                continue;
+
+            const std::string& buffer = sectionData[section];
+            ss.write(buffer.c_str(), buffer.length());
+            ss.write(padding, (SECTION_ALIGN - buffer.length() % SECTION_ALIGN) % SECTION_ALIGN);
+        }
+    }
+
+    void SerializerBinary::readSections(Ctx* ctx, const std::string& fileName) {
+        for (uint64_t section = 0; section < SECTIONS; ++section)
+            sectionFound[section] = false;
+
+        uint64_t version = ctx->read32Little(data + MAGIC_LENGTH);
+        if (version != VERSION)
+            throw DataException(20009, "file: " + fileName + " - binary format error: unsupported version " + std::to_string(version));
+
+        uint64_t sections = ctx->read32Little(data + MAGIC_LENGTH + 4);
+        if (sections > SECTIONS || HEADER_LENGTH + sections * SECTION_ENTRY_LENGTH > dataLength)
+            throw DataException(20009, "file: " + fileName + " - binary format error: section table truncated");
+
+        if (checksum(data + HEADER_LENGTH, sections * SECTION_ENTRY_LENGTH) != ctx->read32Little(data + MAGIC_LENGTH + 8))
+            throw DataException(20009, "file: " + fileName + " - binary format error: section table checksum mismatch");
+
+        for (uint64_t i = 0; i < sections; ++i) {
+            const uint8_t* entry = data + HEADER_LENGTH + i * SECTION_ENTRY_LENGTH;
+            uint64_t section = ctx->read32Little(entry);
+            if (section >= SECTIONS || sectionFound[section])
+                throw DataException(20009, "file: " + fileName + " - binary format error: invalid section " + std::to_string(section));
+
+            sectionChecksum[section] = ctx->read32Little(entry + 4);
+            sectionRowsRead[section] = ctx->read64Little(entry + 8);
+            sectionOffset[section] = ctx->read64Little(entry + 16);
+            sectionLength[section] = ctx->read64Little(entry + 24);
+            if (sectionOffset[section] > dataLength || sectionLength[section] > dataLength - sectionOffset[section])
+                throw DataException(20009, "file: " + fileName + " - binary format error: section " + SECTION_NAMES[section] + " truncated");
+            sectionFound[section] = true;
+        }
+
+        if (!sectionFound[SECTION_HEADER])
+            throw DataException(20009, "file: " + fileName + " - binary format error: section " + SECTION_NAMES[SECTION_HEADER] + " missing");
+        if (checksum(data + sectionOffset[SECTION_HEADER], sectionLength[SECTION_HEADER]) != sectionChecksum[SECTION_HEADER])
+            throw DataException(20009, "file: " + fileName + " - binary format error: section " + SECTION_NAMES[SECTION_HEADER] +
+                                       " checksum mismatch");
+    }
+
+    bool SerializerBinary::deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::vector<std::string>& msgs,
+                                       bool loadMetadata, bool loadSchema) {
+        // Files written in JSON format: checkpoint files created before the format was changed and schema files
+        if (ss.length() < HEADER_LENGTH || memcmp(ss.c_str(), MAGIC, MAGIC_LENGTH) != 0)
+            return SerializerJson::deserialize(metadata, ss, fileName, msgs, loadMetadata, loadSchema);
+
+        data = reinterpret_cast<const uint8_t*>(ss.c_str());
+        dataLength = ss.length();
+        std::string header;
+        try {
+            readSections(metadata->ctx, fileName);
+            header.assign(reinterpret_cast<const char*>(data + sectionOffset[SECTION_HEADER]), sectionLength[SECTION_HEADER]);
+        } catch (DataException& ex) {
+            metadata->ctx->error(ex.code, ex.msg);
+            data = nullptr;
+            return false;
+        }
+
+        bool ret = SerializerJson::deserialize(metadata, header, fileName, msgs, loadMetadata, loadSchema);
+        data = nullptr;
+        return ret;
+    }
+
+    template<class VALUE>
+    void SerializerBinary::deserializeRows(Schema* schema, std::vector<VALUE*>& rows, const std::map<typeRowId, VALUE*>& mapRowId,
+                                           void (Schema::*dictAdd)(VALUE*), const char* tableName) {
+        for (VALUE*& row: rows) {
+            if (mapRowId.find(row->rowId) != mapRowId.end())
+                throw DataException(50023, "duplicate " + std::string(tableName) + " value: (rowid: " + row->rowId.toString() + ")");
+
+            (schema->*dictAdd)(row);
+            row = nullptr;
+        }
+    }
+
+    void SerializerBinary::deserializeSys(Metadata* metadata, const std::string& fileName, const rapidjson::Value& document) {
+        if (data == nullptr) {
+            SerializerJson::deserializeSys(metadata, fileName, document);
+            return;
+        }
+
+        for (uint64_t section = SECTION_SYS_CCOL; section < SECTIONS; ++section)
+            if (!sectionFound[section])
+                throw DataException(20009, "file: " + fileName + " - binary format error: section " + SECTION_NAMES[section] + " missing");
+
+        // Sections are decoded in parallel, the rows are added to the schema by this thread in the same order as for JSON format
+        SerializerBinaryLoader* loaders[SECTIONS];
+        for (uint64_t section = 0; section < SECTIONS; ++section)
+            loaders[section] = nullptr;
+
+        int errorCode = 0;
+        std::string errorMsg;
+        try {
+            for (uint64_t section = SECTION_SYS_CCOL; section < SECTIONS; ++section) {
+                loaders[section] = new SerializerBinaryLoader(metadata->ctx, std::string("schema-") + SECTION_NAMES[section], fileName, section,
+                                                              data + sectionOffset[section], sectionLength[section], sectionRowsRead[section],
+                                                              sectionChecksum[section]);
+                metadata->ctx->spawnThread(loaders[section]);
+            }
+        } catch (RuntimeException& ex) {
+            errorCode = ex.code;
+            errorMsg = ex.msg;
+        }
+
+        for (uint64_t section = SECTION_SYS_CCOL; section < SECTIONS; ++section) {
+            if (loaders[section] == nullptr)
+                continue;
+            metadata->ctx->finishThread(loaders[section]);
+            if (errorCode == 0 && loaders[section]->errorCode != 0) {
+                errorCode = loaders[section]->errorCode;
+                errorMsg = loaders[section]->errorMsg;
+            }
+        }
+
+        if (errorCode == 0) {
+            Schema* schema = metadata->schema;
+            try {
+                deserializeRows(schema, loaders[SECTION_SYS_USER]->sysUsers, schema->sysUserMapRowId, &Schema::dictSysUserAdd, "SYS.USER$");
+                deserializeRows(schema, loaders[SECTION_SYS_OBJ]->sysObjs, schema->sysObjMapRowId, &Schema::dictSysObjAdd, "SYS.OBJ$");
+                deserializeRows(schema, loaders[SECTION_SYS_COL]->sysCols, schema->sysColMapRowId, &Schema::dictSysColAdd, "SYS.COL$");
+                deserializeRows(schema, loaders[SECTION_SYS_CCOL]->sysCCols, schema->sysCColMapRowId, &Schema::dictSysCColAdd, "SYS.CCOL$");
+                deserializeRows(schema, loaders[SECTION_SYS_CDEF]->sysCDefs, schema->sysCDefMapRowId, &Schema::dictSysCDefAdd, "SYS.CDEF$");
+                deserializeRows(schema, loaders[SECTION_SYS_DEFERREDSTG]->sysDeferredStgs, schema->sysDeferredStgMapRowId,
+                                &Schema::dictSysDeferredStgAdd, "SYS.DEFERRED_STG$");
+                deserializeRows(schema, loaders[SECTION_SYS_ECOL]->sysECols, schema->sysEColMapRowId, &Schema::dictSysEColAdd, "SYS.ECOL$");
+                deserializeRows(schema, loaders[SECTION_SYS_LOB]->sysLobs, schema->sysLobMapRowId, &Schema::dictSysLobAdd, "SYS.LOB$");
+                deserializeRows(schema, loaders[SECTION_SYS_LOB_COMP_PART]->sysLobCompParts, schema->sysLobCompPartMapRowId,
+                                &Schema::dictSysLobCompPartAdd, "SYS.LOBCOMPPART$");
+                deserializeRows(schema, loaders[SECTION_SYS_LOB_FRAG]->sysLobFrags, schema->sysLobFragMapRowId, &Schema::dictSysLobFragAdd,
+                                "SYS.LOBFRAG$");
+                deserializeRows(schema, loaders[SECTION_SYS_TAB]->sysTabs, schema->sysTabMapRowId, &Schema::dictSysTabAdd, "SYS.TAB$");
+                deserializeRows(schema, loaders[SECTION_SYS_TABPART]->sysTabParts, schema->sysTabPartMapRowId, &Schema::dictSysTabPartAdd,
+                                "SYS.TABPART$");
+                deserializeRows(schema, loaders[SECTION_SYS_TABCOMPART]->sysTabComParts, schema->sysTabComPartMapRowId,
+                                &Schema::dictSysTabComPartAdd, "SYS.TABCOMPART$");
+                deserializeRows(schema, loaders[SECTION_SYS_TABSUBPART]->sysTabSubParts, schema->sysTabSubPartMapRowId,
+                                &Schema::dictSysTabSubPartAdd, "SYS.TABSUBPART$");
+                deserializeRows(schema, loaders[SECTION_SYS_TS]->sysTss, schema->sysTsMapRowId, &Schema::dictSysTsAdd, "SYS.TS$");
+            } catch (DataException& ex) {
+                errorCode = ex.code;
+                errorMsg = ex.msg;
+            }
+        }
+
+        for (uint64_t section = SECTION_SYS_CCOL; section < SECTIONS; ++section)
+            delete loaders[section];
+
+        if (errorCode != 0)
+            throw DataException(errorCode, errorMsg);
+    }
+
+    SerializerBinaryLoader::SerializerBinaryLoader(Ctx* newCtx, const std::string& newAlias, const std::string& newFileName, uint64_t newSection,
+                                                   const uint8_t* newData, uint64_t newLength, uint64_t newRows, uint32_t newChecksum) :
+            Thread(newCtx, newAlias),
+            fileName(newFileName),
+            section(newSection),
+            data(newData),
+            length(newLength),
+            rows(newRows),
+            checksum(newChecksum),
+            pos(0),
+            errorCode(0) {
+    }
+
+    SerializerBinaryLoader::~SerializerBinaryLoader() {
+        for (SysCCol* sysCCol: sysCCols)
+            delete sysCCol;
+        for (SysCDef* sysCDef: sysCDefs)
+            delete sysCDef;
+        for (SysCol* sysCol: sysCols)
+            delete sysCol;
+        for (SysDeferredStg* sysDeferredStg: sysDeferredStgs)
+            delete sysDeferredStg;
+        for (SysECol* sysECol: sysECols)
+            delete sysECol;
+        for (SysLob* sysLob: sysLobs)
+            delete sysLob;
+        for (SysLobCompPart* sysLobCompPart: sysLobCompParts)
+            delete sysLobCompPart;
+        for (SysLobFrag* sysLobFrag: sysLobFrags)
+            delete sysLobFrag;
+        for (SysObj* sysObj: sysObjs)
+            delete sysObj;
+        for (SysTab* sysTab: sysTabs)
+            delete sysTab;
+        for (SysTabComPart* sysTabComPart: sysTabComParts)
+            delete sysTabComPart;
+        for (SysTabPart* sysTabPart: sysTabParts)
+            delete sysTabPart;
+        for (SysTabSubPart* sysTabSubPart: sysTabSubParts)
+            delete sysTabSubPart;
+        for (SysTs* sysTs: sysTss)
+            delete sysTs;
+        for (SysUser* sysUser: sysUsers)
+            delete sysUser;
+    }
+
+    void SerializerBinaryLoader::check(uint64_t size) {
+        if (size > length - pos)
+            throw DataException(20009, "file: " + fileName + " - binary format error: section " + SerializerBinary::SECTION_NAMES[section] +
+                                       " truncated at offset " + std::to_string(pos));
+    }
+
+    uint16_t SerializerBinaryLoader::read16() {
+        check(2);
+        uint16_t value = ctx->read16Little(data + pos);
+        pos += 2;
+        return value;
+    }
+
+    uint32_t SerializerBinaryLoader::read32() {
+        check(4);
+        uint32_t value = ctx->read32Little(data + pos);
+        pos += 4;
+        return value;
+    }
+
+    uint64_t SerializerBinaryLoader::read64() {
+        check(8);
+        uint64_t value = ctx->read64Little(data + pos);
+        pos += 8;
+        return value;
+    }
+
+    void SerializerBinaryLoader::readIntX(uint64_t& value1, uint64_t& value2) {
+        value1 = read64();
+        value2 = read64();
+    }
+
+    typeRowId SerializerBinaryLoader::readRowId() {
+        typeDataObj dataObj = read32();
+        typeDba dba = read32();
+        typeSlot slot = read16();
+        return typeRowId(dataObj, dba, slot);
+    }
+
+    std::string SerializerBinaryLoader::readString(uint64_t maxLength) {
+        uint64_t stringLength = read32();
+        if (stringLength > maxLength)
+            throw DataException(20009, "file: " + fileName + " - binary format error: section " + SerializerBinary::SECTION_NAMES[section] +
+                                       " string too long at offset " + std::to_string(pos));
+        check(stringLength);
+        std::string value(reinterpret_cast<const char*>(data + pos), stringLength);
+        pos += stringLength;
+        return value;
+    }
+
+    void SerializerBinaryLoader::readRow() {
+        typeRowId rowId = readRowId();
+
+        switch (section) {
+            case SerializerBinary::SECTION_SYS_CCOL: {
+                typeCon con = read32();
+                typeCol intCol = static_cast<typeCol>(read16());
+                typeObj obj = read32();
+                uint64_t spare11;
+                uint64_t spare12;
+                readIntX(spare11, spare12);
+                sysCCols.push_back(new SysCCol(rowId, con, intCol, obj, spare11, spare12));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_CDEF: {
+                typeCon con = read32();
+                typeObj obj = read32();
+                typeType type = read16();
+                sysCDefs.push_back(new SysCDef(rowId, con, obj, type));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_COL: {
+                typeObj obj = read32();
+                typeCol col = static_cast<typeCol>(read16());
+                typeCol segCol = static_cast<typeCol>(read16());
+                typeCol intCol = static_cast<typeCol>(read16());
+                std::string name = readString(SysCol::NAME_LENGTH);
+                typeType type = read16();
+                uint64_t length_ = read64();
+                int64_t precision = static_cast<int64_t>(read64());
+                int64_t scale = static_cast<int64_t>(read64());
+                uint64_t charsetForm = read64();
+                uint64_t charsetId = read64();
+                int64_t null_ = static_cast<int64_t>(read64());
+                uint64_t property1;
+                uint64_t property2;
+                readIntX(property1, property2);
+                if (segCol > 1000)
+                    throw DataException(50025, "value of SYS.COL$ too big for SEGCOL# (value: " + std::to_string(segCol) + ")");
+                sysCols.push_back(new SysCol(rowId, obj, col, segCol, intCol, name.c_str(), type, length_, precision, scale, charsetForm, charsetId,
+                                             null_, property1, property2));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_DEFERREDSTG: {
+                typeObj obj = read32();
+                uint64_t flagsStg1;
+                uint64_t flagsStg2;
+                readIntX(flagsStg1, flagsStg2);
+                sysDeferredStgs.push_back(new SysDeferredStg(rowId, obj, flagsStg1, flagsStg2));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_ECOL: {
+                typeObj tabObj = read32();
+                typeCol colNum = static_cast<typeCol>(read16());
+                typeCol guardId = static_cast<typeCol>(read16());
+                sysECols.push_back(new SysECol(rowId, tabObj, colNum, guardId));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_LOB: {
+                typeObj obj = read32();
+                typeCol col = static_cast<typeCol>(read16());
+                typeCol intCol = static_cast<typeCol>(read16());
+                typeObj lObj = read32();
+                typeTs ts = read32();
+                sysLobs.push_back(new SysLob(rowId, obj, col, intCol, lObj, ts));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_LOB_COMP_PART: {
+                typeObj partObj = read32();
+                typeObj lObj = read32();
+                sysLobCompParts.push_back(new SysLobCompPart(rowId, partObj, lObj));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_LOB_FRAG: {
+                typeObj fragObj = read32();
+                typeObj parentObj = read32();
+                typeTs ts = read32();
+                sysLobFrags.push_back(new SysLobFrag(rowId, fragObj, parentObj, ts));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_OBJ: {
+                typeUser owner = read32();
+                typeObj obj = read32();
+                typeDataObj dataObj = read32();
+                typeType type = read16();
+                std::string name = readString(SysObj::NAME_LENGTH);
+                uint64_t flags1;
+                uint64_t flags2;
+                readIntX(flags1, flags2);
+                bool single = (read16() != 0);
+                sysObjs.push_back(new SysObj(rowId, owner, obj, dataObj, type, name.c_str(), flags1, flags2, single));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_TAB: {
+                typeObj obj = read32();
+                typeDataObj dataObj = read32();
+                typeTs ts = read32();
+                typeCol cluCols = static_cast<typeCol>(read16());
+                uint64_t flags1;
+                uint64_t flags2;
+                readIntX(flags1, flags2);
+                uint64_t property1;
+                uint64_t property2;
+                readIntX(property1, property2);
+                sysTabs.push_back(new SysTab(rowId, obj, dataObj, ts, cluCols, flags1, flags2, property1, property2));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_TABCOMPART: {
+                typeObj obj = read32();
+                typeDataObj dataObj = read32();
+                typeObj bo = read32();
+                sysTabComParts.push_back(new SysTabComPart(rowId, obj, dataObj, bo));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_TABPART: {
+                typeObj obj = read32();
+                typeDataObj dataObj = read32();
+                typeObj bo = read32();
+                sysTabParts.push_back(new SysTabPart(rowId, obj, dataObj, bo));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_TABSUBPART: {
+                typeObj obj = read32();
+                typeDataObj dataObj = read32();
+                typeObj pObj = read32();
+                sysTabSubParts.push_back(new SysTabSubPart(rowId, obj, dataObj, pObj));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_TS: {
+                typeTs ts = read32();
+                std::string name = readString(SysTs::NAME_LENGTH);
+                uint32_t blockSize = read32();
+                sysTss.push_back(new SysTs(rowId, ts, name.c_str(), blockSize));
+                break;
+            }
+
+            case SerializerBinary::SECTION_SYS_USER: {
+                typeUser user = read32();
+                std::string name = readString(SysUser::NAME_LENGTH);
+                uint64_t spare11;
+                uint64_t spare12;
+                readIntX(spare11, spare12);
+                bool single = (read16() != 0);
+                sysUsers.push_back(new SysUser(rowId, user, name.c_str(), spare11, spare12, single));
+                break;
+            }
+
+            default:
+                throw DataException(20009, "file: " + fileName + " - binary format error: invalid section " + std::to_string(section));
+        }
+    }
+
+    void SerializerBinaryLoader::run() {
+        if (ctx->trace & Ctx::TRACE_THREADS) {
+            std::ostringstream ss;
+            ss << std::this_thread::get_id();
+            ctx->logTrace(Ctx::TRACE_THREADS, "schema loader (" + ss.str() + ") start");
+        }
+
+        try {
+            if (SerializerBinary::checksum(data, length) != checksum)
+                throw DataException(20009, "file: " + fileName + " - binary format error: section " + SerializerBinary::SECTION_NAMES[section] +
+                                           " checksum mismatch");
+
+            for (uint64_t row = 0; row < rows; ++row)
+                readRow();
+
+            if (pos != length)
+                throw DataException(20009, "file: " + fileName + " - binary format error: section " + SerializerBinary::SECTION_NAMES[section] +
+                                           " has " + std::to_string(length - pos) + " bytes after the last row");
+        } catch (DataException& ex) {
+            errorCode = ex.code;
+            errorMsg = ex.msg;
+        } catch (std::bad_alloc& ex) {
+            errorCode = 10018;
+            errorMsg = "memory allocation failed: " + std::string(ex.what());
+        }
+
+        if (ctx->trace & Ctx::TRACE_THREADS) {
+            std::ostringstream ss;
+            ss << std::this_thread::get_id();
+            ctx->logTrace(Ctx::TRACE_THREADS, "schema loader (" + ss.str() + ") stop");
+        }
+    }
+}
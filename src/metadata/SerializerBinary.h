@@ -0,0 +1,171 @@
+/* Header for SerializerBinary class
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <vector>
+
+#include "../common/Thread.h"
+#include "SerializerJson.h"
+
+#ifndef SERIALIZER_BINARY_H_
+#define SERIALIZER_BINARY_H_
+
+namespace OpenLogReplicator {
+    class typeIntX;
+
+    // Checkpoint file layout (all numbers little-endian):
+    //   header:        magic[8], version u32, section count u32, section table checksum u32, reserved u32
+    //   section table: per section: id u32, checksum u32, rows u64, offset u64, length u64
+    //   sections:      aligned to 8 bytes; section 0 is the JSON document without the SYS tables, other sections contain rows of
+    //                  one SYS table each and are decoded in parallel
+    class SerializerBinary final : public SerializerJson {
+    public:
+        static constexpr uint64_t VERSION = 1;
+        static constexpr uint64_t MAGIC_LENGTH = 8;
+        static constexpr uint64_t HEADER_LENGTH = 24;
+        static constexpr uint64_t SECTION_ENTRY_LENGTH = 32;
+        static constexpr uint64_t SECTION_ALIGN = 8;
+
+        static constexpr uint64_t SECTION_HEADER = 0;
+        static constexpr uint64_t SECTION_SYS_CCOL = 1;
+        static constexpr uint64_t SECTION_SYS_CDEF = 2;
+        static constexpr uint64_t SECTION_SYS_COL = 3;
+        static constexpr uint64_t SECTION_SYS_DEFERREDSTG = 4;
+        static constexpr uint64_t SECTION_SYS_ECOL = 5;
+        static constexpr uint64_t SECTION_SYS_LOB = 6;
+        static constexpr uint64_t SECTION_SYS_LOB_COMP_PART = 7;
+        static constexpr uint64_t SECTION_SYS_LOB_FRAG = 8;
+        static constexpr uint64_t SECTION_SYS_OBJ = 9;
+        static constexpr uint64_t SECTION_SYS_TAB = 10;
+        static constexpr uint64_t SECTION_SYS_TABCOMPART = 11;
+        static constexpr uint64_t SECTION_SYS_TABPART = 12;
+        static constexpr uint64_t SECTION_SYS_TABSUBPART = 13;
+        static constexpr uint64_t SECTION_SYS_TS = 14;
+        static constexpr uint64_t SECTION_SYS_USER = 15;
+        static constexpr uint64_t SECTIONS = 16;
+
+        static const char MAGIC[MAGIC_LENGTH + 1];
+        static const char* SECTION_NAMES[SECTIONS];
+
+    protected:
+        static uint32_t CRC32[256];
+
+        // Serialization
+        std::string sectionData[SECTIONS];
+        uint64_t sectionRows[SECTIONS];
+        bool sectionUsed[SECTIONS];
+
+        // Deserialization
+        const uint8_t* data;
+        uint64_t dataLength;
+        uint64_t sectionOffset[SECTIONS];
+        uint64_t sectionLength[SECTIONS];
+        uint64_t sectionRowsRead[SECTIONS];
+        uint32_t sectionChecksum[SECTIONS];
+        bool sectionFound[SECTIONS];
+
+        static void append16(std::string& buffer, uint16_t value);
+        static void append32(std::string& buffer, uint32_t value);
+        static void append64(std::string& buffer, uint64_t value);
+        static void appendIntX(std::string& buffer, const typeIntX& value);
+        static void appendRowId(std::string& buffer, typeRowId rowId);
+        static void appendString(std::string& buffer, const std::string& value);
+        static void appendRow(std::string& buffer, const SysCCol* sysCCol);
+        static void appendRow(std::string& buffer, const SysCDef* sysCDef);
+        static void appendRow(std::string& buffer, const SysCol* sysCol);
+        static void appendRow(std::string& buffer, const SysDeferredStg* sysDeferredStg);
+        static void appendRow(std::string& buffer, const SysECol* sysECol);
+        static void appendRow(std::string& buffer, const SysLob* sysLob);
+        static void appendRow(std::string& buffer, const SysLobCompPart* sysLobCompPart);
+        static void appendRow(std::string& buffer, const SysLobFrag* sysLobFrag);
+        static void appendRow(std::string& buffer, const SysObj* sysObj);
+        static void appendRow(std::string& buffer, const SysTab* sysTab);
+        static void appendRow(std::string& buffer, const SysTabComPart* sysTabComPart);
+        static void appendRow(std::string& buffer, const SysTabPart* sysTabPart);
+        static void appendRow(std::string& buffer, const SysTabSubPart* sysTabSubPart);
+        static void appendRow(std::string& buffer, const SysTs* sysTs);
+        static void appendRow(std::string& buffer, const SysUser* sysUser);
+        template<class VALUE>
+        void serializeSection(uint64_t section, const std::map<typeRowId, VALUE*>& mapRowId, const std::set<typeRowId>* setChanged);
+        void serializeSys(std::ostringstream& ss, Schema* schema, bool delta) override;
+        void readSections(Ctx* ctx, const std::string& fileName);
+        template<class VALUE>
+        void deserializeRows(Schema* schema, std::vector<VALUE*>& rows, const std::map<typeRowId, VALUE*>& mapRowId, void (Schema::*dictAdd)(VALUE*),
+                             const char* tableName);
+        void deserializeSys(Metadata* metadata, const std::string& fileName, const rapidjson::Value& document) override;
+
+    public:
+        SerializerBinary();
+        ~SerializerBinary() override;
+
+        static void initializeCRC32();
+        [[nodiscard]] static uint32_t checksum(const uint8_t* buffer, uint64_t length);
+
+        [[nodiscard]] bool deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::vector<std::string>& msgs,
+                                       bool loadMetadata, bool storeSchema) override;
+        void serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaType) override;
+        [[nodiscard]] bool isBinary() const override;
+    };
+
+    // Decodes rows of one section of the checkpoint file, the rows are added to the schema later by the thread which started loading
+    class SerializerBinaryLoader final : public Thread {
+    protected:
+        std::string fileName;
+        uint64_t section;
+        const uint8_t* data;
+        uint64_t length;
+        uint64_t rows;
+        uint32_t checksum;
+        uint64_t pos;
+
+        void run() override;
+        void check(uint64_t size);
+        uint16_t read16();
+        uint32_t read32();
+        uint64_t read64();
+        void readIntX(uint64_t& value1, uint64_t& value2);
+        typeRowId readRowId();
+        std::string readString(uint64_t maxLength);
+        void readRow();
+
+    public:
+        int errorCode;
+        std::string errorMsg;
+        std::vector<SysCCol*> sysCCols;
+        std::vector<SysCDef*> sysCDefs;
+        std::vector<SysCol*> sysCols;
+        std::vector<SysDeferredStg*> sysDeferredStgs;
+        std::vector<SysECol*> sysECols;
+        std::vector<SysLob*> sysLobs;
+        std::vector<SysLobCompPart*> sysLobCompParts;
+        std::vector<SysLobFrag*> sysLobFrags;
+        std::vector<SysObj*> sysObjs;
+        std::vector<SysTab*> sysTabs;
+        std::vector<SysTabComPart*> sysTabComParts;
+        std::vector<SysTabPart*> sysTabParts;
+        std::vector<SysTabSubPart*> sysTabSubParts;
+        std::vector<SysTs*> sysTss;
+        std::vector<SysUser*> sysUsers;
+
+        SerializerBinaryLoader(Ctx* newCtx, const std::string& newAlias, const std::string& newFileName, uint64_t newSection, const uint8_t* newData,
+                               uint64_t newLength, uint64_t newRows, uint32_t newChecksum);
+        ~SerializerBinaryLoader() override;
+    };
+}
+
+#endif
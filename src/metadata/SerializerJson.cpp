@@ -54,7 +54,227 @@ namespace OpenLogReplicator {
 
     SerializerJson::~SerializerJson() = default;
 
-    void SerializerJson::serialize(Metadata* metadata, std::ostringstream& ss, bool storeSchema) {
+    bool SerializerJson::isBinary() const {
+        return false;
+    }
+
+    template<class VALUE>
+    void SerializerJson::serializeTable(std::ostringstream& ss, const char* name, const std::map<typeRowId, VALUE*>& mapRowId,
+                                        const std::set<typeRowId>* setChanged) {
+        ss << R"(")" << name << R"(":[)";
+        bool hasPrev = false;
+        if (setChanged == nullptr) {
+            for (auto mapRowIdIt: mapRowId) {
+                if (hasPrev)
+                    ss << ",";
+                else
+                    hasPrev = true;
+
+                serializeRow(ss, mapRowIdIt.second);
+            }
+        } else {
+            for (auto rowId: *setChanged) {
+                auto mapRowIdIt = mapRowId.find(rowId);
+                // Deleted row, present only in "schema-drop"
+                if (mapRowIdIt == mapRowId.end())
+                    continue;
+
+                if (hasPrev)
+                    ss << ",";
+                else
+                    hasPrev = true;
+
+                serializeRow(ss, mapRowIdIt->second);
+            }
+        }
+        ss << "]";
+    }
+
+    void SerializerJson::serializeDrop(std::ostringstream& ss, const char* name, const std::set<typeRowId>& setChanged) {
+        ss << R"(")" << name << R"(":[)";
+        bool hasPrev = false;
+        for (auto rowId: setChanged) {
+            if (hasPrev)
+                ss << ",";
+            else
+                hasPrev = true;
+
+            ss << R"(")" << rowId << R"(")";
+        }
+        ss << "]";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysCCol* sysCCol) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysCCol->rowId <<
+                           R"(","con":)" << std::dec << sysCCol->con <<
+                           R"(,"int-col":)" << std::dec << sysCCol->intCol <<
+                           R"(,"obj":)" << std::dec << sysCCol->obj <<
+                           R"(,"spare1":)" << std::dec << sysCCol->spare1.toString() << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysCDef* sysCDef) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysCDef->rowId <<
+                           R"(","con":)" << std::dec << sysCDef->con <<
+                           R"(,"obj":)" << std::dec << sysCDef->obj <<
+                           R"(,"type":)" << std::dec << sysCDef->type << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysCol* sysCol) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysCol->rowId <<
+                           R"(","obj":)" << std::dec << sysCol->obj <<
+                           R"(,"col":)" << std::dec << sysCol->col <<
+                           R"(,"seg-col":)" << std::dec << sysCol->segCol <<
+                           R"(,"int-col":)" << std::dec << sysCol->intCol <<
+                           R"(,"name":")";
+        Ctx::writeEscapeValue(ss, sysCol->name);
+        ss << R"(","type":)" << std::dec << sysCol->type <<
+           R"(,"length":)" << std::dec << sysCol->length <<
+           R"(,"precision":)" << std::dec << sysCol->precision <<
+           R"(,"scale":)" << std::dec << sysCol->scale <<
+           R"(,"charset-form":)" << std::dec << sysCol->charsetForm <<
+           R"(,"charset-id":)" << std::dec << sysCol->charsetId <<
+           R"(,"null":)" << std::dec << sysCol->null_ <<
+           R"(,"property":)" << sysCol->property.toString() << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysDeferredStg* sysDeferredStg) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysDeferredStg->rowId <<
+                           R"(","obj":)" << std::dec << sysDeferredStg->obj <<
+                           R"(,"flags-stg":)" << std::dec << sysDeferredStg->flagsStg.toString() << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysECol* sysECol) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysECol->rowId <<
+                           R"(","tab-obj":)" << std::dec << sysECol->tabObj <<
+                           R"(,"col-num":)" << std::dec << sysECol->colNum <<
+                           R"(,"guard-id":)" << std::dec << sysECol->guardId << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysLob* sysLob) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysLob->rowId <<
+                           R"(","obj":)" << std::dec << sysLob->obj <<
+                           R"(,"col":)" << std::dec << sysLob->col <<
+                           R"(,"int-col":)" << std::dec << sysLob->intCol <<
+                           R"(,"l-obj":)" << std::dec << sysLob->lObj <<
+                           R"(,"ts":)" << std::dec << sysLob->ts << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysLobCompPart* sysLobCompPart) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysLobCompPart->rowId <<
+                           R"(","part-obj":)" << std::dec << sysLobCompPart->partObj <<
+                           R"(,"l-obj":)" << std::dec << sysLobCompPart->lObj << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysLobFrag* sysLobFrag) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysLobFrag->rowId <<
+                           R"(","frag-obj":)" << std::dec << sysLobFrag->fragObj <<
+                           R"(,"parent-obj":)" << std::dec << sysLobFrag->parentObj <<
+                           R"(,"ts":)" << std::dec << sysLobFrag->ts << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysObj* sysObj) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysObj->rowId <<
+                           R"(","owner":)" << std::dec << sysObj->owner <<
+                           R"(,"obj":)" << std::dec << sysObj->obj <<
+                           R"(,"data-obj":)" << std::dec << sysObj->dataObj <<
+                           R"(,"name":")";
+        Ctx::writeEscapeValue(ss, sysObj->name);
+        ss << R"(","type":)" << std::dec << sysObj->type <<
+           R"(,"flags":)" << std::dec << sysObj->flags.toString() <<
+           R"(,"single":)" << std::dec << static_cast<uint64_t>(sysObj->single) << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysTab* sysTab) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysTab->rowId <<
+                           R"(","obj":)" << std::dec << sysTab->obj <<
+                           R"(,"data-obj":)" << std::dec << sysTab->dataObj <<
+                           R"(,"ts":)" << std::dec << sysTab->ts <<
+                           R"(,"clu-cols":)" << std::dec << sysTab->cluCols <<
+                           R"(,"flags":)" << std::dec << sysTab->flags.toString() <<
+                           R"(,"property":)" << std::dec << sysTab->property.toString() << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysTabComPart* sysTabComPart) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysTabComPart->rowId <<
+                           R"(","obj":)" << std::dec << sysTabComPart->obj <<
+                           R"(,"data-obj":)" << std::dec << sysTabComPart->dataObj <<
+                           R"(,"bo":)" << std::dec << sysTabComPart->bo << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysTabPart* sysTabPart) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysTabPart->rowId <<
+                           R"(","obj":)" << std::dec << sysTabPart->obj <<
+                           R"(,"data-obj":)" << std::dec << sysTabPart->dataObj <<
+                           R"(,"bo":)" << std::dec << sysTabPart->bo << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysTabSubPart* sysTabSubPart) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysTabSubPart->rowId <<
+                           R"(","obj":)" << std::dec << sysTabSubPart->obj <<
+                           R"(,"data-obj":)" << std::dec << sysTabSubPart->dataObj <<
+                           R"(,"p-obj":)" << std::dec << sysTabSubPart->pObj << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysTs* sysTs) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysTs->rowId <<
+                           R"(","ts":)" << std::dec << sysTs->ts <<
+                           R"(,"name":")";
+        Ctx::writeEscapeValue(ss, sysTs->name);
+        ss << R"(","block-size":)" << std::dec << sysTs->blockSize << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const SysUser* sysUser) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << sysUser->rowId <<
+                           R"(","user":)" << std::dec << sysUser->user <<
+                           R"(,"name":")";
+        Ctx::writeEscapeValue(ss, sysUser->name);
+        ss << R"(","spare1":)" << std::dec << sysUser->spare1.toString() <<
+           R"(,"single":)" << std::dec << static_cast<uint64_t>(sysUser->single) << "}";
+    }
+
+    void SerializerJson::serializeRow(std::ostringstream& ss, const XdbTtSet* xdbTtSet) {
+        ss SERIALIZER_ENDL << R"({"row-id":")" << xdbTtSet->rowId <<
+                           R"(","guid":")" << std::dec << xdbTtSet->guid <<
+                           R"(","toksuf":")";
+        Ctx::writeEscapeValue(ss, xdbTtSet->tokSuf);
+        ss << R"(","flags":)" << std::dec << xdbTtSet->flags <<
+           R"(,"obj":)" << std::dec << xdbTtSet->obj << "}";
+    }
+
+    void SerializerJson::serializeSys(std::ostringstream& ss, Schema* schema, bool delta) {
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-ccol", schema->sysCColMapRowId, delta ? &schema->sysCColSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-cdef", schema->sysCDefMapRowId, delta ? &schema->sysCDefSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-col", schema->sysColMapRowId, delta ? &schema->sysColSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-deferredstg", schema->sysDeferredStgMapRowId, delta ? &schema->sysDeferredStgSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-ecol", schema->sysEColMapRowId, delta ? &schema->sysEColSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-lob", schema->sysLobMapRowId, delta ? &schema->sysLobSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-lob-comp-part", schema->sysLobCompPartMapRowId, delta ? &schema->sysLobCompPartSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-lob-frag", schema->sysLobFragMapRowId, delta ? &schema->sysLobFragSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-obj", schema->sysObjMapRowId, delta ? &schema->sysObjSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-tab", schema->sysTabMapRowId, delta ? &schema->sysTabSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-tabcompart", schema->sysTabComPartMapRowId, delta ? &schema->sysTabComPartSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-tabpart", schema->sysTabPartMapRowId, delta ? &schema->sysTabPartSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-tabsubpart", schema->sysTabSubPartMapRowId, delta ? &schema->sysTabSubPartSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-ts", schema->sysTsMapRowId, delta ? &schema->sysTsSetChanged : nullptr);
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "sys-user", schema->sysUserMapRowId, delta ? &schema->sysUserSetChanged : nullptr);
+    }
+
+    void SerializerJson::serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaType) {
         // Assuming the caller holds all locks
         ss << R"({"database":")";
         Ctx::writeEscapeValue(ss, metadata->database);
@@ -145,316 +365,66 @@ namespace OpenLogReplicator {
         ss << "]," SERIALIZER_ENDL;
 
         // Schema did not change since the last checkpoint file
-        if (!storeSchema) {
+        if (schemaType == SCHEMA_REF) {
             ss << R"("schema-ref-scn":)" << metadata->schema->refScn << "}";
             return;
         }
 
-        metadata->schema->refScn = metadata->checkpointScn;
-        ss << R"("schema-scn":)" << metadata->schema->scn << "," SERIALIZER_ENDL;
-
-        // SYS.CCOL$
-        ss << R"("sys-ccol":[)";
-        hasPrev = false;
-        for (auto sysCColMapRowIdIt: metadata->schema->sysCColMapRowId) {
-            SysCCol* sysCCol = sysCColMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysCCol->rowId <<
-                               R"(","con":)" << std::dec << sysCCol->con <<
-                               R"(,"int-col":)" << std::dec << sysCCol->intCol <<
-                               R"(,"obj":)" << std::dec << sysCCol->obj <<
-                               R"(,"spare1":)" << std::dec << sysCCol->spare1.toString() << "}";
-        }
-
-        // SYS.CDEF$
-        ss << "]," SERIALIZER_ENDL << R"("sys-cdef":[)";
-        hasPrev = false;
-        for (auto sysCDefMapRowIdIt: metadata->schema->sysCDefMapRowId) {
-            const SysCDef* sysCDef = sysCDefMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysCDef->rowId <<
-                               R"(","con":)" << std::dec << sysCDef->con <<
-                               R"(,"obj":)" << std::dec << sysCDef->obj <<
-                               R"(,"type":)" << std::dec << sysCDef->type << "}";
-        }
-
-        // SYS.COL$
-        ss << "]," SERIALIZER_ENDL << R"("sys-col":[)";
-        hasPrev = false;
-        for (auto sysColMapRowIdIt: metadata->schema->sysColMapRowId) {
-            SysCol* sysCol = sysColMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysCol->rowId <<
-                               R"(","obj":)" << std::dec << sysCol->obj <<
-                               R"(,"col":)" << std::dec << sysCol->col <<
-                               R"(,"seg-col":)" << std::dec << sysCol->segCol <<
-                               R"(,"int-col":)" << std::dec << sysCol->intCol <<
-                               R"(,"name":")";
-            Ctx::writeEscapeValue(ss, sysCol->name);
-            ss << R"(","type":)" << std::dec << sysCol->type <<
-               R"(,"length":)" << std::dec << sysCol->length <<
-               R"(,"precision":)" << std::dec << sysCol->precision <<
-               R"(,"scale":)" << std::dec << sysCol->scale <<
-               R"(,"charset-form":)" << std::dec << sysCol->charsetForm <<
-               R"(,"charset-id":)" << std::dec << sysCol->charsetId <<
-               R"(,"null":)" << std::dec << sysCol->null_ <<
-               R"(,"property":)" << sysCol->property.toString() << "}";
-        }
-
-        // SYS.DEFERRED_STG$
-        ss << "]," SERIALIZER_ENDL << R"("sys-deferredstg":[)";
-        hasPrev = false;
-        for (auto sysDeferredStgMapRowIdIt: metadata->schema->sysDeferredStgMapRowId) {
-            SysDeferredStg* sysDeferredStg = sysDeferredStgMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysDeferredStg->rowId <<
-                               R"(","obj":)" << std::dec << sysDeferredStg->obj <<
-                               R"(,"flags-stg":)" << std::dec << sysDeferredStg->flagsStg.toString() << "}";
-        }
-
-        // SYS.ECOL$
-        ss << "]," SERIALIZER_ENDL << R"("sys-ecol":[)";
-        hasPrev = false;
-        for (auto sysEColMapRowIdIt: metadata->schema->sysEColMapRowId) {
-            const SysECol* sysECol = sysEColMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysECol->rowId <<
-                               R"(","tab-obj":)" << std::dec << sysECol->tabObj <<
-                               R"(,"col-num":)" << std::dec << sysECol->colNum <<
-                               R"(,"guard-id":)" << std::dec << sysECol->guardId << "}";
+        Schema* schema = metadata->schema;
+        schema->refScn = metadata->checkpointScn;
+        ss << R"("schema-scn":)" << schema->scn;
+
+        // Rows changed since the checkpoint file with full schema: all are dropped first, then the existing ones are added again
+        bool delta = (schemaType == SCHEMA_DELTA);
+        if (delta) {
+            ss << "," SERIALIZER_ENDL << R"("schema-base-scn":)" << schema->deltaBaseScn << "," SERIALIZER_ENDL << R"("schema-drop":{)";
+            serializeDrop(ss, "sys-ccol", schema->sysCColSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-cdef", schema->sysCDefSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-col", schema->sysColSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-deferredstg", schema->sysDeferredStgSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-ecol", schema->sysEColSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-lob", schema->sysLobSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-lob-comp-part", schema->sysLobCompPartSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-lob-frag", schema->sysLobFragSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-obj", schema->sysObjSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-tab", schema->sysTabSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-tabcompart", schema->sysTabComPartSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-tabpart", schema->sysTabPartSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-tabsubpart", schema->sysTabSubPartSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-ts", schema->sysTsSetChanged);
+            ss << ",";
+            serializeDrop(ss, "sys-user", schema->sysUserSetChanged);
+            ss << "}";
         }
 
-        // SYS.LOB$
-        ss << "]," SERIALIZER_ENDL << R"("sys-lob":[)";
-        hasPrev = false;
-        for (auto sysLobMapRowIdIt: metadata->schema->sysLobMapRowId) {
-            const SysLob* sysLob = sysLobMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
+        serializeSys(ss, schema, delta);
 
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysLob->rowId <<
-                               R"(","obj":)" << std::dec << sysLob->obj <<
-                               R"(,"col":)" << std::dec << sysLob->col <<
-                               R"(,"int-col":)" << std::dec << sysLob->intCol <<
-                               R"(,"l-obj":)" << std::dec << sysLob->lObj <<
-                               R"(,"ts":)" << std::dec << sysLob->ts << "}";
-        }
-
-        // SYS.LOBCOMPPART$
-        ss << "]," SERIALIZER_ENDL << R"("sys-lob-comp-part":[)";
-        hasPrev = false;
-        for (auto sysLobCompPartMapRowIdIt: metadata->schema->sysLobCompPartMapRowId) {
-            const SysLobCompPart* sysLobCompPart = sysLobCompPartMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysLobCompPart->rowId <<
-                               R"(","part-obj":)" << std::dec << sysLobCompPart->partObj <<
-                               R"(,"l-obj":)" << std::dec << sysLobCompPart->lObj << "}";
-        }
-
-        // SYS.LOBFRAG$
-        ss << "]," SERIALIZER_ENDL << R"("sys-lob-frag":[)";
-        hasPrev = false;
-        for (auto sysLobFragMapRowIdIt: metadata->schema->sysLobFragMapRowId) {
-            const SysLobFrag* sysLobFrag = sysLobFragMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysLobFrag->rowId <<
-                               R"(","frag-obj":)" << std::dec << sysLobFrag->fragObj <<
-                               R"(,"parent-obj":)" << std::dec << sysLobFrag->parentObj <<
-                               R"(,"ts":)" << std::dec << sysLobFrag->ts << "}";
-        }
-
-        // SYS.OBJ$
-        ss << "]," SERIALIZER_ENDL << R"("sys-obj":[)";
-        hasPrev = false;
-        for (auto sysObjMapRowIdIt: metadata->schema->sysObjMapRowId) {
-            SysObj* sysObj = sysObjMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysObj->rowId <<
-                               R"(","owner":)" << std::dec << sysObj->owner <<
-                               R"(,"obj":)" << std::dec << sysObj->obj <<
-                               R"(,"data-obj":)" << std::dec << sysObj->dataObj <<
-                               R"(,"name":")";
-            Ctx::writeEscapeValue(ss, sysObj->name);
-            ss << R"(","type":)" << std::dec << sysObj->type <<
-               R"(,"flags":)" << std::dec << sysObj->flags.toString() <<
-               R"(,"single":)" << std::dec << static_cast<uint64_t>(sysObj->single) << "}";
-        }
-
-        // SYS.TAB$
-        ss << "]," SERIALIZER_ENDL << R"("sys-tab":[)";
-        hasPrev = false;
-        for (auto sysTabMapRowIdIt: metadata->schema->sysTabMapRowId) {
-            SysTab* sysTab = sysTabMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysTab->rowId <<
-                               R"(","obj":)" << std::dec << sysTab->obj <<
-                               R"(,"data-obj":)" << std::dec << sysTab->dataObj <<
-                               R"(,"ts":)" << std::dec << sysTab->ts <<
-                               R"(,"clu-cols":)" << std::dec << sysTab->cluCols <<
-                               R"(,"flags":)" << std::dec << sysTab->flags.toString() <<
-                               R"(,"property":)" << std::dec << sysTab->property.toString() << "}";
-        }
-
-        // SYS.TABCOMPART$
-        ss << "]," SERIALIZER_ENDL << R"("sys-tabcompart":[)";
-        hasPrev = false;
-        for (auto sysTabComPartMapRowIdIt: metadata->schema->sysTabComPartMapRowId) {
-            const SysTabComPart* sysTabComPart = sysTabComPartMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysTabComPart->rowId <<
-                               R"(","obj":)" << std::dec << sysTabComPart->obj <<
-                               R"(,"data-obj":)" << std::dec << sysTabComPart->dataObj <<
-                               R"(,"bo":)" << std::dec << sysTabComPart->bo << "}";
-        }
-
-        // SYS.TABPART$
-        ss << "]," SERIALIZER_ENDL << R"("sys-tabpart":[)";
-        hasPrev = false;
-        for (auto sysTabPartMapRowIdIt: metadata->schema->sysTabPartMapRowId) {
-            const SysTabPart* sysTabPart = sysTabPartMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysTabPart->rowId <<
-                               R"(","obj":)" << std::dec << sysTabPart->obj <<
-                               R"(,"data-obj":)" << std::dec << sysTabPart->dataObj <<
-                               R"(,"bo":)" << std::dec << sysTabPart->bo << "}";
-        }
-
-        // SYS.TABSUBPART$
-        ss << "]," SERIALIZER_ENDL << R"("sys-tabsubpart":[)";
-        hasPrev = false;
-        for (auto sysTabSubPartMapRowIdIt: metadata->schema->sysTabSubPartMapRowId) {
-            const SysTabSubPart* sysTabSubPart = sysTabSubPartMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysTabSubPart->rowId <<
-                               R"(","obj":)" << std::dec << sysTabSubPart->obj <<
-                               R"(,"data-obj":)" << std::dec << sysTabSubPart->dataObj <<
-                               R"(,"p-obj":)" << std::dec << sysTabSubPart->pObj << "}";
-        }
-
-        // SYS.TS$
-        ss << "]," SERIALIZER_ENDL << R"("sys-ts":[)";
-        hasPrev = false;
-        for (auto sysTsMapRowIdIt: metadata->schema->sysTsMapRowId) {
-            const SysTs* sysTs = sysTsMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysTs->rowId <<
-                               R"(","ts":)" << std::dec << sysTs->ts <<
-                               R"(,"name":")";
-            Ctx::writeEscapeValue(ss, sysTs->name);
-            ss << R"(","block-size":)" << std::dec << sysTs->blockSize << "}";
-        }
-
-        // SYS.USER$
-        ss << "]," SERIALIZER_ENDL << R"("sys-user":[)";
-        hasPrev = false;
-        for (auto sysUserMapRowIdIt: metadata->schema->sysUserMapRowId) {
-            SysUser* sysUser = sysUserMapRowIdIt.second;
-
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << sysUser->rowId <<
-                               R"(","user":)" << std::dec << sysUser->user <<
-                               R"(,"name":")";
-            Ctx::writeEscapeValue(ss, sysUser->name);
-            ss << R"(","spare1":)" << std::dec << sysUser->spare1.toString() <<
-               R"(,"single":)" << std::dec << static_cast<uint64_t>(sysUser->single) << "}";
+        if (delta) {
+            ss << "}";
+            return;
         }
 
-        // XDB.XDB$TTSET
-        ss << "]," SERIALIZER_ENDL << R"("xdb-ttset":[)";
-        hasPrev = false;
-        for (auto xdbTtSetMapRowIdIt: metadata->schema->xdbTtSetMapRowId) {
-            const XdbTtSet* xdbTtSet = xdbTtSetMapRowIdIt.second;
+        ss << "," SERIALIZER_ENDL;
+        serializeTable(ss, "xdb-ttset", schema->xdbTtSetMapRowId, nullptr);
 
-            if (hasPrev)
-                ss << ",";
-            else
-                hasPrev = true;
-
-            ss SERIALIZER_ENDL << R"({"row-id":")" << xdbTtSet->rowId <<
-                               R"(","guid":")" << std::dec << xdbTtSet->guid <<
-                               R"(","toksuf":")";
-            Ctx::writeEscapeValue(ss, xdbTtSet->tokSuf);
-            ss << R"(","flags":)" << std::dec << xdbTtSet->flags <<
-               R"(,"obj":)" << std::dec << xdbTtSet->obj << "}";
-        }
-
-        for (auto schemaXmlIt: metadata->schema->schemaXmlMap) {
+        for (auto schemaXmlIt: schema->schemaXmlMap) {
             const XmlCtx* xmlCtx = schemaXmlIt.second;
 
             // XDB.X$NMxxx
-            ss << "]," SERIALIZER_ENDL << R"("xdb-xnm)" << xmlCtx->tokSuf << R"(":[)";
+            ss << "," SERIALIZER_ENDL << R"("xdb-xnm)" << xmlCtx->tokSuf << R"(":[)";
             hasPrev = false;
             for (auto xdbXNmMapRowIdIt: xmlCtx->xdbXNmMapRowId) {
                 const XdbXNm* xdbXNm = xdbXNmMapRowIdIt.second;
@@ -469,9 +439,10 @@ namespace OpenLogReplicator {
                 Ctx::writeEscapeValue(ss, xdbXNm->nmSpcUri);
                 ss << R"(","id":")" << xdbXNm->id << R"("})";
             }
+            ss << "]";
 
             // XDB.X$PTxxx
-            ss << "]," SERIALIZER_ENDL << R"("xdb-xpt)" << xmlCtx->tokSuf << R"(":[)";
+            ss << "," SERIALIZER_ENDL << R"("xdb-xpt)" << xmlCtx->tokSuf << R"(":[)";
             hasPrev = false;
             for (auto xdbXPtMapRowIdIt: xmlCtx->xdbXPtMapRowId) {
                 const XdbXPt* xdbXPt = xdbXPtMapRowIdIt.second;
@@ -486,9 +457,10 @@ namespace OpenLogReplicator {
                 Ctx::writeEscapeValue(ss, xdbXPt->path);
                 ss << R"(","id":")" << xdbXPt->id << R"("})";
             }
+            ss << "]";
 
             // XDB.X$QNxxx
-            ss << "]," SERIALIZER_ENDL << R"("xdb-xqn)" << xmlCtx->tokSuf << R"(":[)";
+            ss << "," SERIALIZER_ENDL << R"("xdb-xqn)" << xmlCtx->tokSuf << R"(":[)";
             hasPrev = false;
             for (auto xdbXQnMapRowIdIt: xmlCtx->xdbXQnMapRowId) {
                 const XdbXQn* xdbXQn = xdbXQnMapRowIdIt.second;
@@ -507,9 +479,11 @@ namespace OpenLogReplicator {
                 Ctx::writeEscapeValue(ss, xdbXQn->flags);
                 ss << R"(","id":")" << xdbXQn->id << R"("})";
             }
+            ss << "]";
         }
 
-        ss << "]}";
+        ss << "}";
+        schema->deltaReset(metadata->checkpointScn);
     }
 
     bool SerializerJson::deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::vector<std::string>& msgs, bool loadMetadata,
@@ -528,6 +502,7 @@ namespace OpenLogReplicator {
                                                                "log-archive-format", "log-archive-dest", "nls-character-set",
                                                                "nls-nchar-character-set", "supp-log-db-primary", "supp-log-db-all",
                                                                "online-redo", "incarnations", "users", "schema-ref-scn", "schema-scn",
+                                                               "schema-base-scn", "schema-drop",
                                                                "sys-user", "sys-obj", "sys-col",  "sys-ccol", "sys-cdef",
                                                                "sys-deferredstg", "sys-ecol", "sys-lob", "sys-lob-comp-part",
                                                                "sys-lob-frag", "sys-tab", "sys-tabpart", "sys-tabcompart",
@@ -665,45 +640,64 @@ namespace OpenLogReplicator {
                 }
 
                 if (loadSchema) {
+                    bool delta = false;
+
                     // Schema referenced to other checkpoint file
                     if (document.HasMember("schema-ref-scn")) {
                         metadata->schema->scn = ZERO_SCN;
                         metadata->schema->refScn = Ctx::getJsonFieldU64(fileName, document, "schema-ref-scn");
 
                     } else {
+                        // Changes are tracked after the caller knows which checkpoint file contained the full schema
+                        typeScn baseScn = ZERO_SCN;
+                        if (document.HasMember("schema-base-scn")) {
+                            baseScn = Ctx::getJsonFieldU64(fileName, document, "schema-base-scn");
+
+                            // Checkpoint file with full schema must be loaded first, then this file again
+                            if (metadata->schema->scn == ZERO_SCN || metadata->schema->deltaBaseScn != baseScn) {
+                                metadata->schema->scn = ZERO_SCN;
+                                metadata->schema->refScn = baseScn;
+                                metadata->schema->deltaLoadScn = Ctx::getJsonFieldU64(fileName, document, "scn");
+                                return true;
+                            }
+
+                            delta = true;
+                            metadata->schema->deltaBaseScn = ZERO_SCN;
+                            metadata->schema->deltaLoadScn = ZERO_SCN;
+                            deserializeDrop(metadata, fileName, Ctx::getJsonFieldO(fileName, document, "schema-drop"));
+                        } else
+                            metadata->schema->deltaReset(ZERO_SCN);
+
                         metadata->schema->scn = Ctx::getJsonFieldU64(fileName, document, "schema-scn");
                         metadata->schema->refScn = ZERO_SCN;
 
-                        deserializeSysUser(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-user"));
-                        deserializeSysObj(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-obj"));
-                        deserializeSysCol(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-col"));
-                        deserializeSysCCol(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-ccol"));
-                        deserializeSysCDef(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-cdef"));
-                        deserializeSysDeferredStg(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-deferredstg"));
-                        deserializeSysECol(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-ecol"));
-                        deserializeSysLob(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-lob"));
-                        deserializeSysLobCompPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-lob-comp-part"));
-                        deserializeSysLobFrag(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-lob-frag"));
-                        deserializeSysTab(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tab"));
-                        deserializeSysTabPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tabpart"));
-                        deserializeSysTabComPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tabcompart"));
-                        deserializeSysTabSubPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tabsubpart"));
-                        deserializeSysTs(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-ts"));
-                        // allow continuing
-                        if (document.HasMember("xdb-ttset"))
-                            deserializeXdbTtSet(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "xdb-ttset"));
-
-                        for (auto ttSetIt: metadata->schema->xdbTtSetMapRowId) {
-                            XmlCtx* xmlCtx = new XmlCtx(metadata->ctx, ttSetIt.second->tokSuf, ttSetIt.second->flags);
-                            metadata->schema->schemaXmlMap.insert_or_assign(ttSetIt.second->tokSuf, xmlCtx);
-
-                            std::string field = "xdb-xnm" + ttSetIt.second->tokSuf;
-                            deserializeXdbXNm(metadata, xmlCtx, fileName, Ctx::getJsonFieldA(fileName, document, field.c_str()));
-                            field = "xdb-xpt" + ttSetIt.second->tokSuf;
-                            deserializeXdbXPt(metadata, xmlCtx, fileName, Ctx::getJsonFieldA(fileName, document, field.c_str()));
-                            field = "xdb-xqn" + ttSetIt.second->tokSuf;
-                            deserializeXdbXQn(metadata, xmlCtx, fileName, Ctx::getJsonFieldA(fileName, document, field.c_str()));
+                        deserializeSys(metadata, fileName, document);
+
+                        if (!delta) {
+                            // allow continuing
+                            if (document.HasMember("xdb-ttset"))
+                                deserializeXdbTtSet(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "xdb-ttset"));
+
+                            for (auto ttSetIt: metadata->schema->xdbTtSetMapRowId) {
+                                XmlCtx* xmlCtx = new XmlCtx(metadata->ctx, ttSetIt.second->tokSuf, ttSetIt.second->flags);
+                                metadata->schema->schemaXmlMap.insert_or_assign(ttSetIt.second->tokSuf, xmlCtx);
+
+                                std::string field = "xdb-xnm" + ttSetIt.second->tokSuf;
+                                deserializeXdbXNm(metadata, xmlCtx, fileName, Ctx::getJsonFieldA(fileName, document, field.c_str()));
+                                field = "xdb-xpt" + ttSetIt.second->tokSuf;
+                                deserializeXdbXPt(metadata, xmlCtx, fileName, Ctx::getJsonFieldA(fileName, document, field.c_str()));
+                                field = "xdb-xqn" + ttSetIt.second->tokSuf;
+                                deserializeXdbXQn(metadata, xmlCtx, fileName, Ctx::getJsonFieldA(fileName, document, field.c_str()));
+                            }
                         }
+
+                        metadata->schema->deltaBaseScn = baseScn;
+                    }
+
+                    // Tables of the base schema changed by the delta are built again
+                    if (delta) {
+                        std::vector<std::string> msgsDropped;
+                        metadata->schema->dropUnusedMetadata(metadata->users, metadata->schemaElements, msgsDropped);
                     }
 
                     for (const SchemaElement* element: metadata->schemaElements) {
@@ -711,8 +705,7 @@ namespace OpenLogReplicator {
                             msgs.push_back("- creating table schema for owner: " + element->owner + " table: " + element->table + " options: " +
                                            std::to_string(element->options));
 
-                        metadata->schema->buildMaps(element->owner, element->table, element->keys, element->keysStr, element->conditionStr, element->options,
-                                                    msgs, metadata->suppLogDbPrimary, metadata->suppLogDbAll, metadata->defaultCharacterMapId,
+                        metadata->schema->buildMaps(element, msgs, metadata->suppLogDbPrimary, metadata->suppLogDbAll, metadata->defaultCharacterMapId,
                                                     metadata->defaultCharacterNcharMapId);
                     }
 
@@ -728,6 +721,81 @@ namespace OpenLogReplicator {
         return true;
     }
 
+    void SerializerJson::deserializeSys(Metadata* metadata, const std::string& fileName, const rapidjson::Value& document) {
+        deserializeSysUser(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-user"));
+        deserializeSysObj(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-obj"));
+        deserializeSysCol(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-col"));
+        deserializeSysCCol(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-ccol"));
+        deserializeSysCDef(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-cdef"));
+        deserializeSysDeferredStg(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-deferredstg"));
+        deserializeSysECol(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-ecol"));
+        deserializeSysLob(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-lob"));
+        deserializeSysLobCompPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-lob-comp-part"));
+        deserializeSysLobFrag(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-lob-frag"));
+        deserializeSysTab(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tab"));
+        deserializeSysTabPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tabpart"));
+        deserializeSysTabComPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tabcompart"));
+        deserializeSysTabSubPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tabsubpart"));
+        deserializeSysTs(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-ts"));
+    }
+
+    template<class VALUE>
+    void SerializerJson::deserializeDropTable(Metadata* metadata, const std::string& fileName, const rapidjson::Value& schemaDropJson, const char* field,
+                                              VALUE* (Schema::*dictFind)(typeRowId), void (Schema::*dictDrop)(VALUE*),
+                                              std::set<typeRowId>& setChanged) {
+        const rapidjson::Value& dropJson = Ctx::getJsonFieldA(fileName, schemaDropJson, field);
+        for (rapidjson::SizeType i = 0; i < dropJson.Size(); ++i) {
+            typeRowId rowId(Ctx::getJsonFieldS(fileName, typeRowId::LENGTH, dropJson, field, i));
+            setChanged.insert(rowId);
+
+            VALUE* value = (metadata->schema->*dictFind)(rowId);
+            if (value == nullptr)
+                continue;
+            (metadata->schema->*dictDrop)(value);
+            delete value;
+        }
+    }
+
+    void SerializerJson::deserializeDrop(Metadata* metadata, const std::string& fileName, const rapidjson::Value& schemaDropJson) {
+        if (!metadata->ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
+            static const char* schemaDropChildNames[] = {"sys-ccol", "sys-cdef", "sys-col", "sys-deferredstg", "sys-ecol", "sys-lob",
+                                                         "sys-lob-comp-part", "sys-lob-frag", "sys-obj", "sys-tab", "sys-tabcompart",
+                                                         "sys-tabpart", "sys-tabsubpart", "sys-ts", "sys-user", nullptr};
+            Ctx::checkJsonFields(fileName, schemaDropJson, schemaDropChildNames);
+        }
+
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-ccol", &Schema::dictSysCColFind, &Schema::dictSysCColDrop,
+                             metadata->schema->sysCColSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-cdef", &Schema::dictSysCDefFind, &Schema::dictSysCDefDrop,
+                             metadata->schema->sysCDefSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-col", &Schema::dictSysColFind, &Schema::dictSysColDrop,
+                             metadata->schema->sysColSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-deferredstg", &Schema::dictSysDeferredStgFind, &Schema::dictSysDeferredStgDrop,
+                             metadata->schema->sysDeferredStgSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-ecol", &Schema::dictSysEColFind, &Schema::dictSysEColDrop,
+                             metadata->schema->sysEColSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-lob", &Schema::dictSysLobFind, &Schema::dictSysLobDrop,
+                             metadata->schema->sysLobSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-lob-comp-part", &Schema::dictSysLobCompPartFind, &Schema::dictSysLobCompPartDrop,
+                             metadata->schema->sysLobCompPartSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-lob-frag", &Schema::dictSysLobFragFind, &Schema::dictSysLobFragDrop,
+                             metadata->schema->sysLobFragSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-obj", &Schema::dictSysObjFind, &Schema::dictSysObjDrop,
+                             metadata->schema->sysObjSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-tab", &Schema::dictSysTabFind, &Schema::dictSysTabDrop,
+                             metadata->schema->sysTabSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-tabcompart", &Schema::dictSysTabComPartFind, &Schema::dictSysTabComPartDrop,
+                             metadata->schema->sysTabComPartSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-tabpart", &Schema::dictSysTabPartFind, &Schema::dictSysTabPartDrop,
+                             metadata->schema->sysTabPartSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-tabsubpart", &Schema::dictSysTabSubPartFind, &Schema::dictSysTabSubPartDrop,
+                             metadata->schema->sysTabSubPartSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-ts", &Schema::dictSysTsFind, &Schema::dictSysTsDrop,
+                             metadata->schema->sysTsSetChanged);
+        deserializeDropTable(metadata, fileName, schemaDropJson, "sys-user", &Schema::dictSysUserFind, &Schema::dictSysUserDrop,
+                             metadata->schema->sysUserSetChanged);
+    }
+
     void SerializerJson::deserializeSysCCol(Metadata* metadata, const std::string& fileName, const rapidjson::Value& sysCColJson) {
         for (rapidjson::SizeType i = 0; i < sysCColJson.Size(); ++i) {
             if (!metadata->ctx->disableChecksSet(Ctx::DISABLE_CHECKS_JSON_TAGS)) {
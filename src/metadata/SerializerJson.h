@@ -17,9 +17,12 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <map>
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
+#include <set>
 
+#include "../common/typeRowId.h"
 #include "Serializer.h"
 
 #ifndef SERIALIZER_JSON_H_
@@ -29,10 +32,53 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     class Ctx;
+    class Schema;
+    class SysCCol;
+    class SysCDef;
+    class SysCol;
+    class SysDeferredStg;
+    class SysECol;
+    class SysLob;
+    class SysLobCompPart;
+    class SysLobFrag;
+    class SysObj;
+    class SysTab;
+    class SysTabComPart;
+    class SysTabPart;
+    class SysTabSubPart;
+    class SysTs;
+    class SysUser;
+    class XdbTtSet;
     class XmlCtx;
 
-    class SerializerJson final : public Serializer {
+    class SerializerJson : public Serializer {
     protected:
+        template<class VALUE>
+        static void serializeTable(std::ostringstream& ss, const char* name, const std::map<typeRowId, VALUE*>& mapRowId,
+                                   const std::set<typeRowId>* setChanged);
+        static void serializeDrop(std::ostringstream& ss, const char* name, const std::set<typeRowId>& setChanged);
+        static void serializeRow(std::ostringstream& ss, const SysCCol* sysCCol);
+        static void serializeRow(std::ostringstream& ss, const SysCDef* sysCDef);
+        static void serializeRow(std::ostringstream& ss, const SysCol* sysCol);
+        static void serializeRow(std::ostringstream& ss, const SysDeferredStg* sysDeferredStg);
+        static void serializeRow(std::ostringstream& ss, const SysECol* sysECol);
+        static void serializeRow(std::ostringstream& ss, const SysLob* sysLob);
+        static void serializeRow(std::ostringstream& ss, const SysLobCompPart* sysLobCompPart);
+        static void serializeRow(std::ostringstream& ss, const SysLobFrag* sysLobFrag);
+        static void serializeRow(std::ostringstream& ss, const SysObj* sysObj);
+        static void serializeRow(std::ostringstream& ss, const SysTab* sysTab);
+        static void serializeRow(std::ostringstream& ss, const SysTabComPart* sysTabComPart);
+        static void serializeRow(std::ostringstream& ss, const SysTabPart* sysTabPart);
+        static void serializeRow(std::ostringstream& ss, const SysTabSubPart* sysTabSubPart);
+        static void serializeRow(std::ostringstream& ss, const SysTs* sysTs);
+        static void serializeRow(std::ostringstream& ss, const SysUser* sysUser);
+        static void serializeRow(std::ostringstream& ss, const XdbTtSet* xdbTtSet);
+        template<class VALUE>
+        void deserializeDropTable(Metadata* metadata, const std::string& fileName, const rapidjson::Value& schemaDropJson, const char* field,
+                                  VALUE* (Schema::*dictFind)(typeRowId), void (Schema::*dictDrop)(VALUE*), std::set<typeRowId>& setChanged);
+        void deserializeDrop(Metadata* metadata, const std::string& fileName, const rapidjson::Value& schemaDropJson);
+        virtual void serializeSys(std::ostringstream& ss, Schema* schema, bool delta);
+        virtual void deserializeSys(Metadata* metadata, const std::string& fileName, const rapidjson::Value& document);
         void deserializeSysCCol(Metadata* metadata, const std::string& fileName, const rapidjson::Value& sysCColJson);
         void deserializeSysCDef(Metadata* metadata, const std::string& fileName, const rapidjson::Value& sysCDefJson);
         void deserializeSysCol(Metadata* metadata, const std::string& fileName, const rapidjson::Value& sysColJson);
@@ -59,7 +105,8 @@ namespace OpenLogReplicator {
 
         [[nodiscard]] bool deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::vector<std::string>& msgs,
                                        bool loadMetadata, bool storeSchema) override;
-        virtual void serialize(Metadata* metadata, std::ostringstream& ss, bool noSchema) override;
+        void serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaType) override;
+        [[nodiscard]] bool isBinary() const override;
     };
 }
 
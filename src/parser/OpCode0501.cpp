@@ -297,7 +297,7 @@ namespace OpenLogReplicator {
         }
     }
 
-    void OpCode0501::process0501(Ctx* ctx, RedoLogRecord* redoLogRecord) {
+    void OpCode0501::process0501(Ctx* ctx, RedoLogRecord* redoLogRecord, const ObjectFilter* objectFilter) {
         init(ctx, redoLogRecord);
         OpCode::process(ctx, redoLogRecord);
         uint64_t fieldPos = 0;
@@ -317,6 +317,12 @@ namespace OpenLogReplicator {
         if ((redoLogRecord->flg & (FLG_MULTIBLOCKUNDOHEAD | FLG_MULTIBLOCKUNDOTAIL | FLG_MULTIBLOCKUNDOMID)) != 0)
             return;
 
+        // Row data of tables which are not replicated is not analyzed
+        if (objectFilter != nullptr && redoLogRecord->opc == 0x0B01 && redoLogRecord->dataObj != 0 && !objectFilter->check(redoLogRecord->obj)) {
+            redoLogRecord->rowDataSkipped = true;
+            return;
+        }
+
         if (!RedoLogRecord::nextFieldOpt(ctx, redoLogRecord, fieldNum, fieldPos, fieldLength, 0x050114))
             return;
         // Field: 3
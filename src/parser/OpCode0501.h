@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include "../common/ObjectFilter.h"
 #include "OpCode.h"
 
 #ifndef OP_CODE_05_01_H_
@@ -36,7 +37,7 @@ namespace OpenLogReplicator {
         static void opc0D17(Ctx* ctx, RedoLogRecord* redoLogRecord, typeField& fieldNum, uint64_t& fieldPos, uint16_t& fieldLength);
 
     public:
-        static void process0501(Ctx* ctx, RedoLogRecord* redoLogRecord);
+        static void process0501(Ctx* ctx, RedoLogRecord* redoLogRecord, const ObjectFilter* objectFilter);
     };
 }
 
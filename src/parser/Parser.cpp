@@ -20,6 +20,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <algorithm>
 
 #include "../builder/Builder.h"
+#include "../builder/BuilderPool.h"
 #include "../common/Clock.h"
 #include "../common/LobCtx.h"
 #include "../common/OracleLob.h"
@@ -55,6 +56,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "OpCode1A02.h"
 #include "OpCode1A06.h"
 #include "Parser.h"
+#include "ParserPool.h"
 #include "Transaction.h"
 #include "TransactionBuffer.h"
 
@@ -71,12 +73,14 @@ namespace OpenLogReplicator {
             lwnTimestamp(0),
             lwnScn(0),
             lwnCheckpointBlock(0),
+            lwnBuffersConfirmed(0),
             group(newGroup),
             path(newPath),
             sequence(0),
             firstScn(ZERO_SCN),
             nextScn(ZERO_SCN),
-            reader(nullptr) {
+            reader(nullptr),
+            pool(nullptr) {
 
         memset(reinterpret_cast<void*>(&zero), 0, sizeof(RedoLogRecord));
 
@@ -102,20 +106,58 @@ namespace OpenLogReplicator {
         *length = sizeof(uint64_t);
     }
 
-    void Parser::analyzeLwn(LwnMember* lwnMember) {
+    uint8_t* Parser::allocateLwn(uint64_t size, uint64_t recordLength) {
+        uint64_t* length = reinterpret_cast<uint64_t*>(lwnChunks[lwnAllocated - 1]);
+
+        if (((*length + size + 7) & 0xFFFFFFF8) > Ctx::MEMORY_CHUNK_SIZE_MB * 1024 * 1024) {
+            if (lwnAllocated == MAX_LWN_CHUNKS)
+                throw RedoLogException(50052, "all " + std::to_string(MAX_LWN_CHUNKS) + " lwn buffers allocated");
+
+            lwnChunks[lwnAllocated++] = ctx->getMemoryChunk(Ctx::MEMORY_MODULE_PARSER, false);
+            if (lwnAllocated > lwnAllocatedMax)
+                lwnAllocatedMax = lwnAllocated;
+            length = reinterpret_cast<uint64_t*>(lwnChunks[lwnAllocated - 1]);
+            *length = sizeof(uint64_t);
+        }
+
+        if (((*length + size + 7) & 0xFFFFFFF8) > Ctx::MEMORY_CHUNK_SIZE_MB * 1024 * 1024)
+            throw RedoLogException(50053, "too big redo log record, length: " + std::to_string(recordLength));
+
+        uint8_t* buffer = lwnChunks[lwnAllocated - 1] + *length;
+        *length += (size + 7) & 0xFFFFFFF8;
+        return buffer;
+    }
+
+    void Parser::relocateLwn() {
+        for (LwnMember* lwnMember: lwnInPlace) {
+            uint8_t* data = allocateLwn(lwnMember->length, lwnMember->length);
+            memcpy(reinterpret_cast<void*>(data), reinterpret_cast<const void*>(lwnMember->data), lwnMember->length);
+            lwnMember->data = data;
+        }
+        lwnInPlace.clear();
+    }
+
+    void Parser::releaseLwnBuffers() {
+        lwnInPlace.clear();
+        if (lwnBuffers.empty())
+            return;
+
+        for (uint64_t redoBufferNum: lwnBuffers)
+            reader->bufferFree(redoBufferNum);
+        lwnBuffers.clear();
+        reader->confirmReadData(lwnBuffersConfirmed);
+    }
+
+    uint64_t Parser::analyzeLwnHeader(LwnMember* lwnMember, uint8_t* data, uint32_t recordLength) {
         if (ctx->trace & Ctx::TRACE_LWN)
             ctx->logTrace(Ctx::TRACE_LWN, "analyze blk: " + std::to_string(lwnMember->block) + " offset: " +
                                           std::to_string(lwnMember->offset) + " scn: " + std::to_string(lwnMember->scn) + " subscn: " +
                                           std::to_string(lwnMember->subScn));
 
-        uint8_t* data = reinterpret_cast<uint8_t*>(lwnMember) + sizeof(struct LwnMember);
-        RedoLogRecord redoLogRecord[2];
-        int64_t vectorCur = -1;
         if (ctx->trace & Ctx::TRACE_LWN)
             ctx->logTrace(Ctx::TRACE_LWN, "analyze length: " + std::to_string(lwnMember->length) + " scn: " + std::to_string(lwnMember->scn) +
                                           " subscn: " + std::to_string(lwnMember->subScn));
 
-        uint32_t recordLength = ctx->read32(data);
         uint8_t vld = data[4];
         uint64_t headerLength;
 
@@ -195,353 +237,348 @@ namespace OpenLogReplicator {
                                           ", field length: " + std::to_string(recordLength));
         }
 
-        uint64_t offset = headerLength;
-        uint64_t vectors = 0;
+        return headerLength;
+    }
 
-        while (offset < recordLength) {
-            int64_t vectorPrev = vectorCur;
-            if (vectorPrev == -1)
-                vectorCur = 0;
-            else
-                vectorCur = 1 - vectorPrev;
+    uint64_t Parser::analyzeVector(LwnMember* lwnMember, uint8_t* data, uint32_t recordLength, uint64_t offset, uint64_t vectorNo,
+                                   RedoLogRecord* redoLogRecord) {
+        memset(reinterpret_cast<void*>(redoLogRecord), 0, sizeof(RedoLogRecord));
+        redoLogRecord->vectorNo = vectorNo;
+        redoLogRecord->cls = ctx->read16(data + offset + 2);
+        redoLogRecord->afn = static_cast<typeAfn>(ctx->read32(data + offset + 4) & 0xFFFF);
+        redoLogRecord->dba = ctx->read32(data + offset + 8);
+        redoLogRecord->scnRecord = ctx->readScn(data + offset + 12);
+        redoLogRecord->rbl = 0; // TODO: verify field length/position
+        redoLogRecord->seq = data[offset + 20];
+        redoLogRecord->typ = data[offset + 21];
+        typeUsn usn = (redoLogRecord->cls >= 15) ? (redoLogRecord->cls - 15) / 2 : -1;
+
+        uint64_t fieldOffset;
+        if (ctx->version >= RedoLogRecord::REDO_VERSION_12_1) {
+            fieldOffset = 32;
+            redoLogRecord->flgRecord = ctx->read16(data + offset + 28);
+            redoLogRecord->conId = static_cast<typeConId>(ctx->read16(data + offset + 24));
+        } else {
+            fieldOffset = 24;
+            redoLogRecord->flgRecord = 0;
+            redoLogRecord->conId = 0;
+        }
 
-            memset(reinterpret_cast<void*>(&redoLogRecord[vectorCur]), 0, sizeof(RedoLogRecord));
-            redoLogRecord[vectorCur].vectorNo = (++vectors);
-            redoLogRecord[vectorCur].cls = ctx->read16(data + offset + 2);
-            redoLogRecord[vectorCur].afn = static_cast<typeAfn>(ctx->read32(data + offset + 4) & 0xFFFF);
-            redoLogRecord[vectorCur].dba = ctx->read32(data + offset + 8);
-            redoLogRecord[vectorCur].scnRecord = ctx->readScn(data + offset + 12);
-            redoLogRecord[vectorCur].rbl = 0; // TODO: verify field length/position
-            redoLogRecord[vectorCur].seq = data[offset + 20];
-            redoLogRecord[vectorCur].typ = data[offset + 21];
-            typeUsn usn = (redoLogRecord[vectorCur].cls >= 15) ? (redoLogRecord[vectorCur].cls - 15) / 2 : -1;
-
-            uint64_t fieldOffset;
-            if (ctx->version >= RedoLogRecord::REDO_VERSION_12_1) {
-                fieldOffset = 32;
-                redoLogRecord[vectorCur].flgRecord = ctx->read16(data + offset + 28);
-                redoLogRecord[vectorCur].conId = static_cast<typeConId>(ctx->read16(data + offset + 24));
-            } else {
-                fieldOffset = 24;
-                redoLogRecord[vectorCur].flgRecord = 0;
-                redoLogRecord[vectorCur].conId = 0;
-            }
+        if (offset + fieldOffset + 1 >= recordLength) {
+            dumpRedoVector(data, recordLength);
+            throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
+                                          std::to_string(lwnMember->offset) + ": position of field list (" + std::to_string(offset + fieldOffset + 1) +
+                                          ") outside of record, length: " + std::to_string(recordLength));
+        }
 
-            if (offset + fieldOffset + 1 >= recordLength) {
-                dumpRedoVector(data, recordLength);
-                throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
-                                              std::to_string(lwnMember->offset) + ": position of field list (" + std::to_string(offset + fieldOffset + 1) +
-                                              ") outside of record, length: " + std::to_string(recordLength));
-            }
+        uint8_t* fieldList = data + offset + fieldOffset;
+
+        redoLogRecord->opCode = (static_cast<typeOp1>(data[offset + 0]) << 8) | data[offset + 1];
+        redoLogRecord->length = fieldOffset + ((ctx->read16(fieldList) + 2) & 0xFFFC);
+        redoLogRecord->sequence = sequence;
+        redoLogRecord->scn = lwnMember->scn;
+        redoLogRecord->subScn = lwnMember->subScn;
+        redoLogRecord->usn = usn;
+        redoLogRecord->data = data + offset;
+        redoLogRecord->dataOffset = lwnMember->block * reader->getBlockSize() + lwnMember->offset + offset;
+        redoLogRecord->fieldLengthsDelta = fieldOffset;
+        if (redoLogRecord->fieldLengthsDelta + 1 >= recordLength) {
+            dumpRedoVector(data, recordLength);
+            throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
+                                          std::to_string(lwnMember->offset) + ": field length list (" +
+                                          std::to_string(redoLogRecord->fieldLengthsDelta) +
+                                          ") outside of record, length: " + std::to_string(recordLength));
+        }
+        redoLogRecord->fieldCnt = (ctx->read16(redoLogRecord->data + redoLogRecord->fieldLengthsDelta) - 2) / 2;
+        redoLogRecord->fieldPos = fieldOffset + ((ctx->read16(redoLogRecord->data + redoLogRecord->fieldLengthsDelta) + 2) & 0xFFFC);
+        if (redoLogRecord->fieldPos >= recordLength) {
+            dumpRedoVector(data, recordLength);
+            throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
+                                          std::to_string(lwnMember->offset) + ": fields (" + std::to_string(redoLogRecord->fieldPos) +
+                                          ") outside of record, length: " + std::to_string(recordLength));
+        }
 
-            uint8_t* fieldList = data + offset + fieldOffset;
-
-            redoLogRecord[vectorCur].opCode = (static_cast<typeOp1>(data[offset + 0]) << 8) | data[offset + 1];
-            redoLogRecord[vectorCur].length = fieldOffset + ((ctx->read16(fieldList) + 2) & 0xFFFC);
-            redoLogRecord[vectorCur].sequence = sequence;
-            redoLogRecord[vectorCur].scn = lwnMember->scn;
-            redoLogRecord[vectorCur].subScn = lwnMember->subScn;
-            redoLogRecord[vectorCur].usn = usn;
-            redoLogRecord[vectorCur].data = data + offset;
-            redoLogRecord[vectorCur].dataOffset = lwnMember->block * reader->getBlockSize() + lwnMember->offset + offset;
-            redoLogRecord[vectorCur].fieldLengthsDelta = fieldOffset;
-            if (redoLogRecord[vectorCur].fieldLengthsDelta + 1 >= recordLength) {
-                dumpRedoVector(data, recordLength);
-                throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
-                                              std::to_string(lwnMember->offset) + ": field length list (" +
-                                              std::to_string(redoLogRecord[vectorCur].fieldLengthsDelta) +
-                                              ") outside of record, length: " + std::to_string(recordLength));
-            }
-            redoLogRecord[vectorCur].fieldCnt = (ctx->read16(redoLogRecord[vectorCur].data + redoLogRecord[vectorCur].fieldLengthsDelta) - 2) / 2;
-            redoLogRecord[vectorCur].fieldPos = fieldOffset +
-                                                ((ctx->read16(redoLogRecord[vectorCur].data + redoLogRecord[vectorCur].fieldLengthsDelta) + 2) & 0xFFFC);
-            if (redoLogRecord[vectorCur].fieldPos >= recordLength) {
+        for (uint64_t i = 1; i <= redoLogRecord->fieldCnt; ++i) {
+            redoLogRecord->length += (ctx->read16(fieldList + i * 2) + 3) & 0xFFFC;
+
+            if (offset + redoLogRecord->length > recordLength) {
                 dumpRedoVector(data, recordLength);
                 throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
-                                              std::to_string(lwnMember->offset) + ": fields (" + std::to_string(redoLogRecord[vectorCur].fieldPos) +
-                                              ") outside of record, length: " + std::to_string(recordLength));
+                                              std::to_string(lwnMember->offset) + ": position of field list outside of record (" + "i: " +
+                                              std::to_string(i) + " c: " + std::to_string(redoLogRecord->fieldCnt) + " " + " o: " +
+                                              std::to_string(fieldOffset) + " p: " + std::to_string(offset) + " l: " +
+                                              std::to_string(redoLogRecord->length) + " r: " + std::to_string(recordLength) + ")");
             }
+        }
 
-            // uint64_t fieldPos = redoLogRecord[vectorCur].fieldPos;
-            for (uint64_t i = 1; i <= redoLogRecord[vectorCur].fieldCnt; ++i) {
-                redoLogRecord[vectorCur].length += (ctx->read16(fieldList + i * 2) + 3) & 0xFFFC;
-
-                if (offset + redoLogRecord[vectorCur].length > recordLength) {
-                    dumpRedoVector(data, recordLength);
-                    throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
-                                                  std::to_string(lwnMember->offset) + ": position of field list outside of record (" + "i: " +
-                                                  std::to_string(i) + " c: " + std::to_string(redoLogRecord[vectorCur].fieldCnt) + " " + " o: " +
-                                                  std::to_string(fieldOffset) + " p: " + std::to_string(offset) + " l: " +
-                                                  std::to_string(redoLogRecord[vectorCur].length) + " r: " + std::to_string(recordLength) + ")");
-                }
-            }
+        if (redoLogRecord->fieldPos > redoLogRecord->length) {
+            dumpRedoVector(data, recordLength);
+            throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
+                                          std::to_string(lwnMember->offset) + ": incomplete record, offset: " +
+                                          std::to_string(redoLogRecord->fieldPos) + ", length: " +
+                                          std::to_string(redoLogRecord->length));
+        }
 
-            if (redoLogRecord[vectorCur].fieldPos > redoLogRecord[vectorCur].length) {
-                dumpRedoVector(data, recordLength);
-                throw RedoLogException(50046, "block: " + std::to_string(lwnMember->block) + ", offset: " +
-                                              std::to_string(lwnMember->offset) + ": incomplete record, offset: " +
-                                              std::to_string(redoLogRecord[vectorCur].fieldPos) + ", length: " +
-                                              std::to_string(redoLogRecord[vectorCur].length));
-            }
+        redoLogRecord->recordObj = 0xFFFFFFFF;
+        redoLogRecord->recordDataObj = 0xFFFFFFFF;
+        return offset + redoLogRecord->length;
+    }
 
-            redoLogRecord[vectorCur].recordObj = 0xFFFFFFFF;
-            redoLogRecord[vectorCur].recordDataObj = 0xFFFFFFFF;
-            offset += redoLogRecord[vectorCur].length;
+    const ObjectFilter* Parser::rowDataFilter() const {
+        // Dump and schemaless modes need all row data decoded
+        if (ctx->dumpRedoLog >= 1 || ctx->flagsSet(Ctx::REDO_FLAGS_SCHEMALESS))
+            return nullptr;
+        return &metadata->schema->tableFilter;
+    }
 
-            switch (redoLogRecord[vectorCur].opCode) {
-                case 0x0501:
-                    // Undo
-                    OpCode0501::process0501(ctx, &redoLogRecord[vectorCur]);
+    void Parser::processVector(RedoLogRecord* redoLogRecord, const RedoLogRecord* redoLogRecordPrev) {
+        // Row and index changes inherit the object from the preceding undo vector
+        if (redoLogRecordPrev != nullptr && redoLogRecordPrev->opCode == 0x0501) {
+            switch (redoLogRecord->opCode) {
+                case 0x0A02:
+                case 0x0A08:
+                case 0x0A12:
+                case 0x0B02:
+                case 0x0B03:
+                case 0x0B04:
+                case 0x0B05:
+                case 0x0B06:
+                case 0x0B08:
+                case 0x0B0B:
+                case 0x0B0C:
+                case 0x0B10:
+                case 0x0B16:
+                case 0x1A02:
+                    redoLogRecord->recordDataObj = redoLogRecordPrev->dataObj;
+                    redoLogRecord->recordObj = redoLogRecordPrev->obj;
                     break;
 
-                case 0x0502:
-                    // Begin transaction
-                    OpCode0502::process0502(ctx, &redoLogRecord[vectorCur]);
+                default:
                     break;
+            }
 
-                case 0x0504:
-                    // Commit/rollback transaction
-                    OpCode0504::process0504(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            // Row changes of tables which are not replicated are not analyzed
+            if (redoLogRecordPrev->rowDataSkipped && (redoLogRecord->opCode & 0xFF00) == 0x0B00) {
+                redoLogRecord->rowDataSkipped = true;
+                return;
+            }
+        }
 
-                case 0x0506:
-                    // Partial rollback
-                    OpCode0506::process0506(ctx, &redoLogRecord[vectorCur]);
-                    break;
+        switch (redoLogRecord->opCode) {
+            case 0x0501:
+                // Undo
+                OpCode0501::process0501(ctx, redoLogRecord, rowDataFilter());
+                break;
 
-                case 0x050B:
-                    OpCode050B::process050B(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0502:
+                // Begin transaction
+                OpCode0502::process0502(ctx, redoLogRecord);
+                break;
 
-                case 0x0513:
-                    // Session information
-                    OpCode0513::process0513(ctx, &redoLogRecord[vectorCur], lastTransaction);
-                    break;
+            case 0x0504:
+                // Commit/rollback transaction
+                OpCode0504::process0504(ctx, redoLogRecord);
+                break;
 
-                    // Session information
-                case 0x0514:
-                    OpCode0514::process0514(ctx, &redoLogRecord[vectorCur], lastTransaction);
-                    break;
+            case 0x0506:
+                // Partial rollback
+                OpCode0506::process0506(ctx, redoLogRecord);
+                break;
 
-                case 0x0A02:
-                    // REDO: Insert leaf row
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0A02::process0A02(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x050B:
+                OpCode050B::process050B(ctx, redoLogRecord);
+                break;
 
-                case 0x0A08:
-                    // REDO: Init header
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0A08::process0A08(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0513:
+                // Session information
+                OpCode0513::process0513(ctx, redoLogRecord, lastTransaction);
+                break;
 
-                case 0x0A12:
-                    // REDO: Update key data in row
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0A12::process0A12(ctx, &redoLogRecord[vectorCur]);
-                    break;
+                // Session information
+            case 0x0514:
+                OpCode0514::process0514(ctx, redoLogRecord, lastTransaction);
+                break;
 
-                case 0x0B02:
-                    // REDO: Insert row piece
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B02::process0B02(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0A02:
+                // REDO: Insert leaf row
+                OpCode0A02::process0A02(ctx, redoLogRecord);
+                break;
 
-                case 0x0B03:
-                    // REDO: Delete row piece
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B03::process0B03(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0A08:
+                // REDO: Init header
+                OpCode0A08::process0A08(ctx, redoLogRecord);
+                break;
 
-                case 0x0B04:
-                    // REDO: Lock row piece
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B04::process0B04(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0A12:
+                // REDO: Update key data in row
+                OpCode0A12::process0A12(ctx, redoLogRecord);
+                break;
 
-                case 0x0B05:
-                    // REDO: Update row piece
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B05::process0B05(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B02:
+                // REDO: Insert row piece
+                OpCode0B02::process0B02(ctx, redoLogRecord);
+                break;
 
-                case 0x0B06:
-                    // REDO: Overwrite row piece
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B06::process0B06(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B03:
+                // REDO: Delete row piece
+                OpCode0B03::process0B03(ctx, redoLogRecord);
+                break;
 
-                case 0x0B08:
-                    // REDO: Change forwarding address
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B08::process0B08(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B04:
+                // REDO: Lock row piece
+                OpCode0B04::process0B04(ctx, redoLogRecord);
+                break;
 
-                case 0x0B0B:
-                    // REDO: Insert multiple rows
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B0B::process0B0B(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B05:
+                // REDO: Update row piece
+                OpCode0B05::process0B05(ctx, redoLogRecord);
+                break;
 
-                case 0x0B0C:
-                    // REDO: Delete multiple rows
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B0C::process0B0C(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B06:
+                // REDO: Overwrite row piece
+                OpCode0B06::process0B06(ctx, redoLogRecord);
+                break;
 
-                case 0x0B10:
-                    // REDO: Supplemental log for update
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B10::process0B10(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B08:
+                // REDO: Change forwarding address
+                OpCode0B08::process0B08(ctx, redoLogRecord);
+                break;
 
-                case 0x0B16:
-                    // REDO: Logminer support - KDOCMP
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode0B16::process0B16(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B0B:
+                // REDO: Insert multiple rows
+                OpCode0B0B::process0B0B(ctx, redoLogRecord);
+                break;
 
-                case 0x1301:
-                    // LOB
-                    OpCode1301::process1301(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B0C:
+                // REDO: Delete multiple rows
+                OpCode0B0C::process0B0C(ctx, redoLogRecord);
+                break;
 
-                case 0x1A02:
-                    // LOB index 12+ and LOB redo
-                    if (vectorPrev != -1 && redoLogRecord[vectorPrev].opCode == 0x0501) {
-                        redoLogRecord[vectorCur].recordDataObj = redoLogRecord[vectorPrev].dataObj;
-                        redoLogRecord[vectorCur].recordObj = redoLogRecord[vectorPrev].obj;
-                    }
-                    OpCode1A02::process1A02(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B10:
+                // REDO: Supplemental log for update
+                OpCode0B10::process0B10(ctx, redoLogRecord);
+                break;
 
-                case 0x1A06:
-                    OpCode1A06::process1A06(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x0B16:
+                // REDO: Logminer support - KDOCMP
+                OpCode0B16::process0B16(ctx, redoLogRecord);
+                break;
 
-                case 0x1801:
-                    // DDL
-                    OpCode1801::process1801(ctx, &redoLogRecord[vectorCur]);
-                    break;
+            case 0x1301:
+                // LOB
+                OpCode1301::process1301(ctx, redoLogRecord);
+                break;
 
-                default:
-                    OpCode::process(ctx, &redoLogRecord[vectorCur]);
-                    break;
-            }
+            case 0x1A02:
+                // LOB index 12+ and LOB redo
+                OpCode1A02::process1A02(ctx, redoLogRecord);
+                break;
 
-            if (vectorPrev != -1) {
-                if (redoLogRecord[vectorPrev].opCode == 0x0501) {
-                    if ((redoLogRecord[vectorCur].opCode & 0xFF00) == 0x0A00 || redoLogRecord[vectorCur].opCode == 0x1A02) {
-                        // UNDO - index
-                        appendToTransactionIndex(&redoLogRecord[vectorPrev], &redoLogRecord[vectorCur]);
-                    } else if ((redoLogRecord[vectorCur].opCode & 0xFF00) == 0x0B00 || redoLogRecord[vectorCur].opCode == 0x0513 ||
-                               redoLogRecord[vectorCur].opCode == 0x0514) {
-                        // UNDO - data
-                        appendToTransaction(&redoLogRecord[vectorPrev], &redoLogRecord[vectorCur]);
-                    } else if (redoLogRecord[vectorCur].opCode == 0x0501) {
-                        // Single 5.1
-                        appendToTransaction(&redoLogRecord[vectorPrev]);
-                        continue;
-                    } else if (redoLogRecord[vectorPrev].opc == 0x0B01)
-                        ctx->warning(70010, "unknown undo OP: " + std::to_string(redoLogRecord[vectorCur].opCode) + ", opc: " +
-                                            std::to_string(redoLogRecord[vectorPrev].opc));
-
-                    vectorCur = -1;
-                    continue;
-                }
+            case 0x1A06:
+                OpCode1A06::process1A06(ctx, redoLogRecord);
+                break;
 
-                if ((redoLogRecord[vectorCur].opCode == 0x0506 || redoLogRecord[vectorCur].opCode == 0x050B)) {
-                    if ((redoLogRecord[vectorPrev].opCode & 0xFF00) == 0x0B00)
-                        appendToTransactionRollback(&redoLogRecord[vectorPrev], &redoLogRecord[vectorCur]);
-                    else if (redoLogRecord[vectorCur].opc == 0x0B01)
-                        ctx->warning(70011, "unknown rollback OP: " + std::to_string(redoLogRecord[vectorPrev].opCode) + ", opc: " +
-                                            std::to_string(redoLogRecord[vectorCur].opc));
+            case 0x1801:
+                // DDL
+                OpCode1801::process1801(ctx, redoLogRecord);
+                break;
 
-                    vectorCur = -1;
-                    continue;
-                }
-            }
+            default:
+                OpCode::process(ctx, redoLogRecord);
+                break;
+        }
+    }
 
-            // UNDO - data
-            if (redoLogRecord[vectorCur].opCode == 0x0501 && (redoLogRecord[vectorCur].flg & (FLG_MULTIBLOCKUNDOTAIL | FLG_MULTIBLOCKUNDOMID)) != 0) {
-                appendToTransaction(&redoLogRecord[vectorCur]);
-                vectorCur = -1;
-                continue;
+    bool Parser::appendVector(RedoLogRecord* redoLogRecordPrev, RedoLogRecord* redoLogRecordCur) {
+        if (redoLogRecordPrev != nullptr) {
+            if (redoLogRecordPrev->opCode == 0x0501) {
+                if ((redoLogRecordCur->opCode & 0xFF00) == 0x0A00 || redoLogRecordCur->opCode == 0x1A02) {
+                    // UNDO - index
+                    appendToTransactionIndex(redoLogRecordPrev, redoLogRecordCur);
+                } else if ((redoLogRecordCur->opCode & 0xFF00) == 0x0B00 || redoLogRecordCur->opCode == 0x0513 ||
+                           redoLogRecordCur->opCode == 0x0514) {
+                    // UNDO - data
+                    appendToTransaction(redoLogRecordPrev, redoLogRecordCur);
+                } else if (redoLogRecordCur->opCode == 0x0501) {
+                    // Single 5.1
+                    appendToTransaction(redoLogRecordPrev);
+                    return false;
+                } else if (redoLogRecordPrev->opc == 0x0B01)
+                    ctx->warning(70010, "unknown undo OP: " + std::to_string(redoLogRecordCur->opCode) + ", opc: " +
+                                        std::to_string(redoLogRecordPrev->opc));
+
+                return true;
             }
 
-            // ROLLBACK - data
-            if (redoLogRecord[vectorCur].opCode == 0x0506 || redoLogRecord[vectorCur].opCode == 0x050B) {
-                appendToTransactionRollback(&redoLogRecord[vectorCur]);
-                vectorCur = -1;
-                continue;
-            }
+            if ((redoLogRecordCur->opCode == 0x0506 || redoLogRecordCur->opCode == 0x050B)) {
+                if ((redoLogRecordPrev->opCode & 0xFF00) == 0x0B00)
+                    appendToTransactionRollback(redoLogRecordPrev, redoLogRecordCur);
+                else if (redoLogRecordCur->opc == 0x0B01)
+                    ctx->warning(70011, "unknown rollback OP: " + std::to_string(redoLogRecordPrev->opCode) + ", opc: " +
+                                        std::to_string(redoLogRecordCur->opc));
 
-            // BEGIN
-            if (redoLogRecord[vectorCur].opCode == 0x0502) {
-                appendToTransactionBegin(&redoLogRecord[vectorCur]);
-                vectorCur = -1;
-                continue;
+                return true;
             }
+        }
 
-            // COMMIT
-            if (redoLogRecord[vectorCur].opCode == 0x0504) {
-                appendToTransactionCommit(&redoLogRecord[vectorCur]);
-                vectorCur = -1;
-                continue;
-            }
+        // UNDO - data
+        if (redoLogRecordCur->opCode == 0x0501 && (redoLogRecordCur->flg & (FLG_MULTIBLOCKUNDOTAIL | FLG_MULTIBLOCKUNDOMID)) != 0) {
+            appendToTransaction(redoLogRecordCur);
+            return true;
+        }
 
-            // LOB
-            if (redoLogRecord[vectorCur].opCode == 0x1301 || redoLogRecord[vectorCur].opCode == 0x1A06) {
-                appendToTransactionLob(&redoLogRecord[vectorCur]);
-                vectorCur = -1;
-                continue;
-            }
+        // ROLLBACK - data
+        if (redoLogRecordCur->opCode == 0x0506 || redoLogRecordCur->opCode == 0x050B) {
+            appendToTransactionRollback(redoLogRecordCur);
+            return true;
+        }
+
+        // BEGIN
+        if (redoLogRecordCur->opCode == 0x0502) {
+            appendToTransactionBegin(redoLogRecordCur);
+            return true;
+        }
+
+        // COMMIT
+        if (redoLogRecordCur->opCode == 0x0504) {
+            appendToTransactionCommit(redoLogRecordCur);
+            return true;
+        }
+
+        // LOB
+        if (redoLogRecordCur->opCode == 0x1301 || redoLogRecordCur->opCode == 0x1A06) {
+            appendToTransactionLob(redoLogRecordCur);
+            return true;
+        }
+
+        // DDL
+        if (redoLogRecordCur->opCode == 0x1801) {
+            appendToTransactionDdl(redoLogRecordCur);
+            return true;
+        }
+
+        return false;
+    }
+
+    void Parser::analyzeLwn(LwnMember* lwnMember) {
+        uint8_t* data = lwnMember->data;
+        uint32_t recordLength = ctx->read32(data);
+        RedoLogRecord redoLogRecord[2];
+        int64_t vectorCur = -1;
+        uint64_t offset = analyzeLwnHeader(lwnMember, data, recordLength);
+        uint64_t vectors = 0;
 
-            // DDL
-            if (redoLogRecord[vectorCur].opCode == 0x1801) {
-                appendToTransactionDdl(&redoLogRecord[vectorCur]);
+        while (offset < recordLength) {
+            int64_t vectorPrev = vectorCur;
+            if (vectorPrev == -1)
+                vectorCur = 0;
+            else
+                vectorCur = 1 - vectorPrev;
+
+            offset = analyzeVector(lwnMember, data, recordLength, offset, ++vectors, &redoLogRecord[vectorCur]);
+            processVector(&redoLogRecord[vectorCur], vectorPrev != -1 ? &redoLogRecord[vectorPrev] : nullptr);
+            if (appendVector(vectorPrev != -1 ? &redoLogRecord[vectorPrev] : nullptr, &redoLogRecord[vectorCur]))
                 vectorCur = -1;
-                continue;
-            }
         }
 
         // UNDO - data
@@ -550,6 +587,77 @@ namespace OpenLogReplicator {
         }
     }
 
+    void Parser::decodeLwn(uint64_t index) {
+        LwnMember* lwnMember = lwnMembers[index];
+        LwnDecoded& lwnDecoded = lwnDecodedList[index];
+        uint8_t* data = lwnMember->data;
+
+        try {
+            uint32_t recordLength = ctx->read32(data);
+            uint64_t offset = analyzeLwnHeader(lwnMember, data, recordLength);
+            bool prevUndo = false;
+
+            while (offset < recordLength) {
+                lwnDecoded.redoLogRecords.emplace_back();
+                RedoLogRecord* redoLogRecord = &lwnDecoded.redoLogRecords.back();
+                offset = analyzeVector(lwnMember, data, recordLength, offset, lwnDecoded.redoLogRecords.size(), redoLogRecord);
+
+                // Session attributes are bound to the last transaction, known only when appending
+                if (redoLogRecord->opCode == 0x0513 || redoLogRecord->opCode == 0x0514) {
+                    lwnDecoded.state = LwnDecoded::STATE_SERIAL;
+                    return;
+                }
+
+                processVector(redoLogRecord, prevUndo ? redoLogRecord - 1 : nullptr);
+
+                // Same pairing as in appendVector(): a multi-block undo vector which is not preceded by an undo vector is consumed alone
+                prevUndo = redoLogRecord->opCode == 0x0501 &&
+                           (prevUndo || (redoLogRecord->flg & (FLG_MULTIBLOCKUNDOTAIL | FLG_MULTIBLOCKUNDOMID)) == 0);
+            }
+        } catch (DataException& ex) {
+            // The vector which failed is not appended
+            if (!lwnDecoded.redoLogRecords.empty())
+                lwnDecoded.redoLogRecords.pop_back();
+            lwnDecoded.errorCode = ex.code;
+            lwnDecoded.errorMsg = ex.msg;
+            lwnDecoded.errorRedoLog = false;
+        } catch (RedoLogException& ex) {
+            if (!lwnDecoded.redoLogRecords.empty())
+                lwnDecoded.redoLogRecords.pop_back();
+            lwnDecoded.errorCode = ex.code;
+            lwnDecoded.errorMsg = ex.msg;
+            lwnDecoded.errorRedoLog = true;
+        }
+
+        lwnDecoded.state = LwnDecoded::STATE_DECODED;
+    }
+
+    void Parser::applyLwn(LwnMember* lwnMember, LwnDecoded& lwnDecoded) {
+        if (lwnDecoded.state != LwnDecoded::STATE_DECODED) {
+            analyzeLwn(lwnMember);
+            return;
+        }
+
+        RedoLogRecord* redoLogRecordPrev = nullptr;
+        for (RedoLogRecord& redoLogRecord: lwnDecoded.redoLogRecords) {
+            if (appendVector(redoLogRecordPrev, &redoLogRecord))
+                redoLogRecordPrev = nullptr;
+            else
+                redoLogRecordPrev = &redoLogRecord;
+        }
+
+        if (lwnDecoded.errorCode != 0) {
+            if (lwnDecoded.errorRedoLog)
+                throw RedoLogException(lwnDecoded.errorCode, lwnDecoded.errorMsg);
+            throw DataException(lwnDecoded.errorCode, lwnDecoded.errorMsg);
+        }
+
+        // UNDO - data
+        if (redoLogRecordPrev != nullptr && redoLogRecordPrev->opCode == 0x0501) {
+            appendToTransaction(redoLogRecordPrev);
+        }
+    }
+
     void Parser::appendToTransactionDdl(RedoLogRecord* redoLogRecord1) {
         // Skip list
         if (transactionBuffer->skipXidList.find(redoLogRecord1->xid) != transactionBuffer->skipXidList.end())
@@ -563,7 +671,7 @@ namespace OpenLogReplicator {
 
         const OracleTable* table;
         {
-            std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+            std::shared_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction);
             table = metadata->schema->checkTableDict(redoLogRecord1->obj);
         }
 
@@ -597,7 +705,7 @@ namespace OpenLogReplicator {
     void Parser::appendToTransactionLob(RedoLogRecord* redoLogRecord1) {
         OracleLob* lob;
         {
-            std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+            std::shared_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction);
             lob = metadata->schema->checkLobDict(redoLogRecord1->dataObj);
         }
 
@@ -611,8 +719,8 @@ namespace OpenLogReplicator {
         redoLogRecord1->lobPageSize = lob->checkLobPageSize(redoLogRecord1->dataObj);
 
         if (redoLogRecord1->xid.isEmpty()) {
-            auto lobIdToXidMapIt = ctx->lobIdToXidMap.find(redoLogRecord1->lobId);
-            if (lobIdToXidMapIt == ctx->lobIdToXidMap.end()) {
+            auto lobIdToXidMapIt = transactionBuffer->lobIdToXidMap.find(redoLogRecord1->lobId);
+            if (lobIdToXidMapIt == transactionBuffer->lobIdToXidMap.end()) {
                 transactionBuffer->addOrphanedLob(redoLogRecord1);
                 return;
             } else
@@ -660,9 +768,15 @@ namespace OpenLogReplicator {
             return;
         }
 
-        const OracleTable* table;
-        {
-            std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+        // The table could have been added by a DDL after the vector was analyzed
+        if (redoLogRecord1->rowDataSkipped && metadata->schema->tableFilter.check(redoLogRecord1->obj)) {
+            redoLogRecord1->rowDataSkipped = false;
+            OpCode0501::process0501(ctx, redoLogRecord1, nullptr);
+        }
+
+        const OracleTable* table = nullptr;
+        if (!redoLogRecord1->rowDataSkipped) {
+            std::shared_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction);
             table = metadata->schema->checkTableDict(redoLogRecord1->obj);
         }
 
@@ -718,7 +832,7 @@ namespace OpenLogReplicator {
 
         const OracleTable* table;
         {
-            std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+            std::shared_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction);
             table = metadata->schema->checkTableDict(redoLogRecord1->obj);
         }
 
@@ -740,17 +854,16 @@ namespace OpenLogReplicator {
         Transaction* transaction = transactionBuffer->findTransaction(metadata->schema->xmlCtxDefault, redoLogRecord1->xid, redoLogRecord1->conId,
                                                                       false, true, false);
         transaction->begin = true;
-        transaction->firstSequence = sequence;
-        transaction->firstOffset = lwnCheckpointBlock * reader->getBlockSize();
+        transactionBuffer->beginTransaction(transaction, redoLogRecord1->conId, sequence, lwnCheckpointBlock * reader->getBlockSize());
         transaction->log(ctx, "B   ", redoLogRecord1);
         lastTransaction = transaction;
     }
 
     void Parser::appendToTransactionCommit(RedoLogRecord* redoLogRecord1) {
         // Clean LOB's if used
-        for (auto lobIdToXidMapIt = ctx->lobIdToXidMap.begin(); lobIdToXidMapIt != ctx->lobIdToXidMap.end();) {
+        for (auto lobIdToXidMapIt = transactionBuffer->lobIdToXidMap.begin(); lobIdToXidMapIt != transactionBuffer->lobIdToXidMap.end();) {
             if (lobIdToXidMapIt->second == redoLogRecord1->xid) {
-                lobIdToXidMapIt = ctx->lobIdToXidMap.erase(lobIdToXidMapIt);
+                lobIdToXidMapIt = transactionBuffer->lobIdToXidMap.erase(lobIdToXidMapIt);
             } else
                 ++lobIdToXidMapIt;
         }
@@ -784,6 +897,20 @@ namespace OpenLogReplicator {
             (transaction->commitScn > metadata->firstSchemaScn && transaction->system)) {
 
             if (transaction->begin) {
+                // Schema changes and debug transactions are flushed by the parser thread after all earlier transactions are done
+                if (builder->pool != nullptr && !transaction->system && !transaction->rollback && !transaction->shutdown &&
+                    ctx->stopTransactions == 0) {
+                    if (ctx->metrics != nullptr)
+                        ctx->metrics->emitTransactionsCommitOut(1);
+
+                    transactionBuffer->dropTransaction(redoLogRecord1->xid, redoLogRecord1->conId);
+                    lastTransaction = nullptr;
+                    builder->pool->flush(transaction, lwnScn);
+                    return;
+                }
+
+                if (builder->pool != nullptr && !transaction->rollback)
+                    builder->pool->drain();
                 transaction->flush(metadata, transactionBuffer, builder, lwnScn);
                 if (ctx->metrics != nullptr) {
                     if (transaction->rollback)
@@ -846,6 +973,14 @@ namespace OpenLogReplicator {
             return;
         lastTransaction = transaction;
 
+        // The table could have been added by a DDL after the vectors were analyzed
+        if (redoLogRecord1->rowDataSkipped && metadata->schema->tableFilter.check(redoLogRecord1->obj)) {
+            redoLogRecord1->rowDataSkipped = false;
+            redoLogRecord2->rowDataSkipped = false;
+            OpCode0501::process0501(ctx, redoLogRecord1, nullptr);
+            processVector(redoLogRecord2, redoLogRecord1);
+        }
+
         typeObj obj;
         if (redoLogRecord1->dataObj != 0) {
             obj = redoLogRecord1->obj;
@@ -884,9 +1019,9 @@ namespace OpenLogReplicator {
                 // Supp log for update
             case 0x0B16: {
                 // Logminer support - KDOCMP
-                const OracleTable* table;
-                {
-                    std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+                const OracleTable* table = nullptr;
+                if (!redoLogRecord1->rowDataSkipped) {
+                    std::shared_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction);
                     table = metadata->schema->checkTableDict(obj);
                 }
 
@@ -971,7 +1106,7 @@ namespace OpenLogReplicator {
 
         const OracleTable* table;
         {
-            std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+            std::shared_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction);
             table = metadata->schema->checkTableDict(obj);
         }
 
@@ -1049,7 +1184,7 @@ namespace OpenLogReplicator {
 
         const OracleLob* lob;
         {
-            std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+            std::shared_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction);
             lob = metadata->schema->checkLobIndexDict(dataObj);
         }
 
@@ -1091,8 +1226,8 @@ namespace OpenLogReplicator {
                 return;
             }
 
-            auto lobIdToXidMapIt = ctx->lobIdToXidMap.find(redoLogRecord2->lobId);
-            if (lobIdToXidMapIt != ctx->lobIdToXidMap.end()) {
+            auto lobIdToXidMapIt = transactionBuffer->lobIdToXidMap.find(redoLogRecord2->lobId);
+            if (lobIdToXidMapIt != transactionBuffer->lobIdToXidMap.end()) {
                 typeXid parentXid = lobIdToXidMapIt->second;
 
                 if (parentXid != redoLogRecord1->xid) {
@@ -1161,11 +1296,11 @@ namespace OpenLogReplicator {
                                           std::to_string(redoLogRecord2->lobPageNo) + " ind key: " + ss.str());
         }
 
-        auto lobIdToXidMapIt = ctx->lobIdToXidMap.find(redoLogRecord2->lobId);
-        if (lobIdToXidMapIt == ctx->lobIdToXidMap.end()) {
+        auto lobIdToXidMapIt = transactionBuffer->lobIdToXidMap.find(redoLogRecord2->lobId);
+        if (lobIdToXidMapIt == transactionBuffer->lobIdToXidMap.end()) {
             if (ctx->trace & Ctx::TRACE_LOB)
                 ctx->logTrace(Ctx::TRACE_LOB, "id: " + redoLogRecord2->lobId.lower() + " xid: " + redoLogRecord1->xid.toString() + " MAP");
-            ctx->lobIdToXidMap.insert_or_assign(redoLogRecord2->lobId, redoLogRecord1->xid);
+            transactionBuffer->lobIdToXidMap.insert_or_assign(redoLogRecord2->lobId, redoLogRecord1->xid);
             transaction->lobCtx.checkOrphanedLobs(ctx, redoLogRecord2->lobId, redoLogRecord1->xid, redoLogRecord1->dataOffset);
         }
 
@@ -1336,30 +1471,22 @@ namespace OpenLogReplicator {
 
                         recordLength4 = (static_cast<uint64_t>(ctx->read32(redoBlock + blockOffset)) + 3) & 0xFFFFFFFC;
                         if (recordLength4 > 0) {
-                            uint64_t* length = reinterpret_cast<uint64_t*>(lwnChunks[lwnAllocated - 1]);
-
-                            if (((*length + sizeof(struct LwnMember) + recordLength4 + 7) & 0xFFFFFFF8) > Ctx::MEMORY_CHUNK_SIZE_MB * 1024 * 1024) {
-                                if (lwnAllocated == MAX_LWN_CHUNKS)
-                                    throw RedoLogException(50052, "all " + std::to_string(MAX_LWN_CHUNKS) + " lwn buffers allocated");
-
-                                lwnChunks[lwnAllocated++] = ctx->getMemoryChunk(Ctx::MEMORY_MODULE_PARSER, false);
-                                if (lwnAllocated > lwnAllocatedMax)
-                                    lwnAllocatedMax = lwnAllocated;
-                                length = reinterpret_cast<uint64_t*>(lwnChunks[lwnAllocated - 1]);
-                                *length = sizeof(uint64_t);
+                            // A record which fits in the block is referenced in the read buffer, only records spanning blocks are copied
+                            bool inPlace = blockOffset + recordLength4 <= reader->getBlockSize();
+                            if (inPlace) {
+                                lwnMember = reinterpret_cast<struct LwnMember*>(allocateLwn(sizeof(struct LwnMember), recordLength4));
+                                lwnMember->data = redoBlock + blockOffset;
+                                lwnInPlace.push_back(lwnMember);
+                            } else {
+                                lwnMember = reinterpret_cast<struct LwnMember*>(allocateLwn(sizeof(struct LwnMember) + recordLength4, recordLength4));
+                                lwnMember->data = reinterpret_cast<uint8_t*>(lwnMember) + sizeof(struct LwnMember);
                             }
-
-                            if (((*length + sizeof(struct LwnMember) + recordLength4 + 7) & 0xFFFFFFF8) > Ctx::MEMORY_CHUNK_SIZE_MB * 1024 * 1024)
-                                throw RedoLogException(50053, "too big redo log record, length: " + std::to_string(recordLength4));
-
-                            lwnMember = reinterpret_cast<struct LwnMember*>(lwnChunks[lwnAllocated - 1] + *length);
-                            *length += (sizeof(struct LwnMember) + recordLength4 + 7) & 0xFFFFFFF8;
                             lwnMember->scn = ctx->read32(redoBlock + blockOffset + 8) |
                                              (static_cast<uint64_t>(ctx->read16(redoBlock + blockOffset + 6)) << 32);
                             lwnMember->subScn = ctx->read16(redoBlock + blockOffset + 12);
                             lwnMember->block = currentBlock;
                             lwnMember->offset = blockOffset;
-                                lwnMember->length = recordLength4;
+                            lwnMember->length = recordLength4;
                             lwnMember->number = number++;
                             if (ctx->trace & Ctx::TRACE_LWN)
                                 ctx->logTrace(Ctx::TRACE_LWN, "length: " + std::to_string(recordLength4) + " scn: " +
@@ -1368,6 +1495,11 @@ namespace OpenLogReplicator {
                             lwnMembers.push_back(lwnMember);
                             if (lwnMembers.size() >= MAX_RECORDS_IN_LWN)
                                 throw RedoLogException(50054, "all " + std::to_string(lwnMembers.size()) + " records in lwn were used");
+
+                            if (inPlace) {
+                                blockOffset += recordLength4;
+                                continue;
+                            }
                         }
 
                         recordLeftToCopy = recordLength4;
@@ -1384,7 +1516,7 @@ namespace OpenLogReplicator {
                     else
                         toCopy = recordLeftToCopy;
 
-                    memcpy(reinterpret_cast<void*>(reinterpret_cast<uint8_t*>(lwnMember) + sizeof(struct LwnMember) + recordPos),
+                    memcpy(reinterpret_cast<void*>(lwnMember->data + recordPos),
                            reinterpret_cast<const void*>(redoBlock + blockOffset), toCopy);
                     recordLeftToCopy -= toCopy;
                     blockOffset += toCopy;
@@ -1405,6 +1537,20 @@ namespace OpenLogReplicator {
                     if (ctx->trace & Ctx::TRACE_LWN)
                         ctx->logTrace(Ctx::TRACE_LWN, "* analyze: " + std::to_string(lwnScn));
 
+                    // Decode the records of the whole LWN in parallel, appending to transactions stays serial
+                    bool decoded = false;
+                    if (pool != nullptr && ctx->dumpRedoLog == 0 && lwnMembers.size() > 1) {
+                        if (lwnDecodedList.size() < lwnMembers.size())
+                            lwnDecodedList.resize(lwnMembers.size());
+                        for (uint64_t i = 0; i < lwnMembers.size(); ++i) {
+                            lwnDecodedList[i].redoLogRecords.clear();
+                            lwnDecodedList[i].errorCode = 0;
+                            lwnDecodedList[i].state = LwnDecoded::STATE_PENDING;
+                        }
+                        decoded = pool->decode(this, lwnMembers.size());
+                    }
+                    uint32_t lwnFirstNumber = lwnMembers.empty() ? 0 : lwnMembers[0]->number;
+
                     std::sort(lwnMembers.begin(), lwnMembers.end(), [](const LwnMember* a, const LwnMember* b) {
                         if (a->scn < b->scn)
                             return true;
@@ -1419,7 +1565,10 @@ namespace OpenLogReplicator {
 
                     for (const auto member : lwnMembers) {
                         try {
-                            analyzeLwn(member);
+                            if (decoded)
+                                applyLwn(member, lwnDecodedList[member->number - lwnFirstNumber]);
+                            else
+                                analyzeLwn(member);
                         } catch (DataException& ex) {
                             if (ctx->flagsSet(Ctx::REDO_FLAGS_IGNORE_DATA_ERRORS)) {
                                 ctx->error(ex.code, ex.msg);
@@ -1438,8 +1587,12 @@ namespace OpenLogReplicator {
                     if (lwnScn > metadata->firstDataScn) {
                         if (ctx->trace & Ctx::TRACE_CHECKPOINT)
                             ctx->logTrace(Ctx::TRACE_CHECKPOINT, "on: " + std::to_string(lwnScn));
-                        builder->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
-                                                   currentBlock * reader->getBlockSize(), switchRedo);
+                        if (builder->pool != nullptr)
+                            builder->pool->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
+                                                           currentBlock * reader->getBlockSize(), switchRedo);
+                        else
+                            builder->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
+                                                       currentBlock * reader->getBlockSize(), switchRedo);
 
                         typeSeq minSequence = ZERO_SEQ;
                         uint64_t minOffset = -1;
@@ -1452,6 +1605,8 @@ namespace OpenLogReplicator {
                                              (currentBlock - lwnConfirmedBlock) * reader->getBlockSize(), minSequence,
                                              minOffset, minXid);
 
+                        if (ctx->stopCheckpoints > 0 && builder->pool != nullptr)
+                            builder->pool->drain();
                         if (ctx->stopCheckpoints > 0 && metadata->isNewData(lwnScn, builder->lwnIdx)) {
                             --ctx->stopCheckpoints;
                             if (ctx->stopCheckpoints == 0) {
@@ -1469,6 +1624,7 @@ namespace OpenLogReplicator {
                     lwnNumCnt = 0;
                     freeLwn();
                     lwnMembers.clear();
+                    releaseLwnBuffers();
 
                     if (ctx->metrics)
                         ctx->metrics->emitBytesParsed((currentBlock - lwnConfirmedBlock) * reader->getBlockSize());
@@ -1478,8 +1634,18 @@ namespace OpenLogReplicator {
 
                 // Free memory
                 if (redoBufferPos == Ctx::MEMORY_CHUNK_SIZE) {
-                    reader->bufferFree(redoBufferNum);
-                    reader->confirmReadData(confirmedBufferStart);
+                    if (lwnInPlace.empty()) {
+                        reader->bufferFree(redoBufferNum);
+                        reader->confirmReadData(confirmedBufferStart);
+                    } else {
+                        // Records of the current LWN still point to the read buffer
+                        lwnBuffers.push_back(redoBufferNum);
+                        lwnBuffersConfirmed = confirmedBufferStart;
+                        if (lwnBuffers.size() >= std::max<uint64_t>(ctx->readBufferMax / 2, 1)) {
+                            relocateLwn();
+                            releaseLwnBuffers();
+                        }
+                    }
                 }
             }
 
@@ -1489,8 +1655,12 @@ namespace OpenLogReplicator {
                     switchRedo = true;
                     if (ctx->trace & Ctx::TRACE_CHECKPOINT)
                         ctx->logTrace(Ctx::TRACE_CHECKPOINT, "on: " + std::to_string(lwnScn) + " with switch");
-                    builder->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
-                                               currentBlock * reader->getBlockSize(), switchRedo);
+                    if (builder->pool != nullptr)
+                        builder->pool->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
+                                                       currentBlock * reader->getBlockSize(), switchRedo);
+                    else
+                        builder->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
+                                                   currentBlock * reader->getBlockSize(), switchRedo);
                     if (ctx->metrics)
                         ctx->metrics->emitCheckpointsOut(1);
                 } else {
@@ -1502,13 +1672,23 @@ namespace OpenLogReplicator {
             if (ctx->softShutdown) {
                 if (ctx->trace & Ctx::TRACE_CHECKPOINT)
                     ctx->logTrace(Ctx::TRACE_CHECKPOINT, "on: " + std::to_string(lwnScn) + " at exit");
-                builder->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
-                                           currentBlock * reader->getBlockSize(), false);
+                if (builder->pool != nullptr)
+                    builder->pool->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
+                                                   currentBlock * reader->getBlockSize(), false);
+                else
+                    builder->processCheckpoint(lwnScn, sequence, lwnTimestamp.toEpoch(ctx->hostTimezone),
+                                               currentBlock * reader->getBlockSize(), false);
                 if (ctx->metrics)
                     ctx->metrics->emitCheckpointsOut(1);
 
                 reader->setRet(Reader::REDO_SHUTDOWN);
             } else {
+                // The reader may reuse the read buffers while the parser waits
+                if (!lwnInPlace.empty()) {
+                    relocateLwn();
+                    releaseLwnBuffers();
+                }
+
                 if (reader->checkFinished(confirmedBufferStart)) {
                     if (reader->getRet() == Reader::REDO_FINISHED && nextScn == ZERO_SCN && reader->getNextScn() != ZERO_SCN)
                         nextScn = reader->getNextScn();
@@ -1519,6 +1699,10 @@ namespace OpenLogReplicator {
             }
         }
 
+        // All transactions of this redo log are in the output queue before switching to the next one
+        if (builder->pool != nullptr)
+            builder->pool->drain();
+
         if (ctx->metrics && reader->getNextScn() != ZERO_SCN) {
             int64_t diff = ctx->clock->getTimeT() - reader->getNextTime().toEpoch(ctx->hostTimezone);
 
@@ -1570,6 +1754,9 @@ namespace OpenLogReplicator {
         }
 
         freeLwn();
+        lwnMembers.clear();
+        lwnInPlace.clear();
+        releaseLwnBuffers();
         return reader->getRet();
     }
 
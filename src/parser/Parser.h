@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <string>
 #include <vector>
 
 #include "../common/Ctx.h"
@@ -34,11 +35,14 @@ namespace OpenLogReplicator {
     class Builder;
     class Reader;
     class Metadata;
+    class ObjectFilter;
+    class ParserPool;
     class Transaction;
     class TransactionBuffer;
     class XmlCtx;
 
     struct LwnMember {
+        uint8_t* data;
         uint64_t offset;
         uint64_t length;
         typeScn scn;
@@ -47,6 +51,18 @@ namespace OpenLogReplicator {
         typeSubScn subScn;
     };
 
+    struct LwnDecoded {
+        static constexpr uint8_t STATE_PENDING = 0;
+        static constexpr uint8_t STATE_DECODED = 1;
+        static constexpr uint8_t STATE_SERIAL = 2;
+
+        std::vector<RedoLogRecord> redoLogRecords;
+        std::string errorMsg;
+        int errorCode;
+        uint8_t state;
+        bool errorRedoLog;
+    };
+
     class Parser final {
     protected:
         Ctx* ctx;
@@ -58,14 +74,29 @@ namespace OpenLogReplicator {
 
         uint8_t* lwnChunks[MAX_LWN_CHUNKS];
         std::vector<LwnMember*> lwnMembers;
+        std::vector<LwnDecoded> lwnDecodedList;
         uint64_t lwnAllocated;
         uint64_t lwnAllocatedMax;
         typeTime lwnTimestamp;
         typeScn lwnScn;
         uint64_t lwnCheckpointBlock;
+        std::vector<LwnMember*> lwnInPlace;
+        std::vector<uint64_t> lwnBuffers;
+        uint64_t lwnBuffersConfirmed;
 
         void freeLwn();
+        uint8_t* allocateLwn(uint64_t size, uint64_t recordLength);
+        void relocateLwn();
+        void releaseLwnBuffers();
+        uint64_t analyzeLwnHeader(LwnMember* lwnMember, uint8_t* data, uint32_t recordLength);
+        uint64_t analyzeVector(LwnMember* lwnMember, uint8_t* data, uint32_t recordLength, uint64_t offset, uint64_t vectorNo,
+                               RedoLogRecord* redoLogRecord);
+        [[nodiscard]] const ObjectFilter* rowDataFilter() const;
+        void processVector(RedoLogRecord* redoLogRecord, const RedoLogRecord* redoLogRecordPrev);
+        [[nodiscard]] bool appendVector(RedoLogRecord* redoLogRecordPrev, RedoLogRecord* redoLogRecordCur);
         void analyzeLwn(LwnMember* lwnMember);
+        void decodeLwn(uint64_t index);
+        void applyLwn(LwnMember* lwnMember, LwnDecoded& lwnDecoded);
         void appendToTransactionDdl(RedoLogRecord* redoLogRecord1);
         void appendToTransactionBegin(RedoLogRecord* redoLogRecord1);
         void appendToTransactionCommit(RedoLogRecord* redoLogRecord1);
@@ -84,12 +115,15 @@ namespace OpenLogReplicator {
         typeScn firstScn;
         typeScn nextScn;
         Reader* reader;
+        ParserPool* pool;
 
         Parser(Ctx* newCtx, Builder* newBuilder, Metadata* newMetadata, TransactionBuffer* newTransactionBuffer, int64_t newGroup, const std::string& newPath);
         virtual ~Parser();
 
         uint64_t parse();
         std::string toString();
+
+        friend class ParserPool;
     };
 }
 
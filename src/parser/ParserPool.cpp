@@ -0,0 +1,124 @@
+/* Pool of threads decoding redo log records of one LWN
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include "../common/Ctx.h"
+#include "Parser.h"
+#include "ParserPool.h"
+#include "ParserWorker.h"
+
+namespace OpenLogReplicator {
+    ParserPool::ParserPool(Ctx* newCtx) :
+            ctx(newCtx),
+            parser(nullptr),
+            next(0),
+            size(0),
+            generation(0),
+            running(0),
+            busy(0) {
+    }
+
+    ParserPool::~ParserPool() {
+        for (ParserWorker* worker: workers)
+            delete worker;
+        workers.clear();
+    }
+
+    void ParserPool::addWorker(ParserWorker* worker) {
+        std::unique_lock<std::mutex> lck(mtx);
+        workers.push_back(worker);
+        ++running;
+    }
+
+    bool ParserPool::decode(Parser* newParser, uint64_t newSize) {
+        // The pool may be shared by many sources, when busy the parser decodes the LWN alone
+        std::unique_lock<std::mutex> lckDecode(mtxDecode, std::try_to_lock);
+        if (!lckDecode.owns_lock())
+            return false;
+
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            parser = newParser;
+            size = newSize;
+            next = 0;
+            busy = running;
+            ++generation;
+            condJob.notify_all();
+        }
+
+        // The parser thread takes part in decoding too
+        try {
+            work();
+        } catch (std::bad_alloc& ex) {
+            // The workers must not touch the LWN after the parser is gone
+            wait();
+            throw;
+        }
+        wait();
+        return true;
+    }
+
+    void ParserPool::wait() {
+        std::unique_lock<std::mutex> lck(mtx);
+        while (busy > 0) {
+            if (ctx->trace & Ctx::TRACE_SLEEP)
+                ctx->logTrace(Ctx::TRACE_SLEEP, "ParserPool:wait");
+            condDone.wait_for(lck, std::chrono::milliseconds(100));
+        }
+        parser = nullptr;
+    }
+
+    bool ParserPool::getJob(uint64_t& workerGeneration) {
+        std::unique_lock<std::mutex> lck(mtx);
+        while (true) {
+            // Every started worker reports back, otherwise the parser would wait forever
+            if (workerGeneration != generation) {
+                workerGeneration = generation;
+                return true;
+            }
+
+            if (ctx->hardShutdown || (ctx->softShutdown && ctx->replicatorFinished))
+                break;
+            condJob.wait_for(lck, std::chrono::milliseconds(100));
+        }
+
+        --running;
+        condDone.notify_all();
+        return false;
+    }
+
+    void ParserPool::work() {
+        uint64_t index;
+        while ((index = next.fetch_add(1)) < size)
+            parser->decodeLwn(index);
+    }
+
+    void ParserPool::finished() {
+        std::unique_lock<std::mutex> lck(mtx);
+        if (busy > 0)
+            --busy;
+        if (busy == 0)
+            condDone.notify_all();
+    }
+
+    void ParserPool::wakeUp() {
+        std::unique_lock<std::mutex> lck(mtx);
+        condJob.notify_all();
+        condDone.notify_all();
+    }
+}
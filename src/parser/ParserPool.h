@@ -0,0 +1,68 @@
+/* Header for ParserPool class
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "../common/types.h"
+
+#ifndef PARSER_POOL_H_
+#define PARSER_POOL_H_
+
+namespace OpenLogReplicator {
+    class Ctx;
+    class Parser;
+    class ParserWorker;
+
+    class ParserPool final {
+    protected:
+        Ctx* ctx;
+        std::vector<ParserWorker*> workers;
+        Parser* parser;
+        std::atomic<uint64_t> next;
+        uint64_t size;
+        uint64_t generation;
+        uint64_t running;
+        uint64_t busy;
+
+        std::mutex mtx;
+        std::mutex mtxDecode;
+        std::condition_variable condJob;
+        std::condition_variable condDone;
+
+        [[nodiscard]] bool getJob(uint64_t& workerGeneration);
+        void work();
+        void wait();
+        void finished();
+
+    public:
+        explicit ParserPool(Ctx* newCtx);
+        virtual ~ParserPool();
+
+        void addWorker(ParserWorker* worker);
+        [[nodiscard]] bool decode(Parser* newParser, uint64_t newSize);
+        void wakeUp();
+
+        friend class ParserWorker;
+    };
+}
+
+#endif
@@ -0,0 +1,63 @@
+/* Thread decoding redo log records for the parser pool
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <thread>
+
+#include "../common/Ctx.h"
+#include "ParserPool.h"
+#include "ParserWorker.h"
+
+namespace OpenLogReplicator {
+    ParserWorker::ParserWorker(Ctx* newCtx, const std::string& newAlias, ParserPool* newPool) :
+            Thread(newCtx, newAlias),
+            pool(newPool) {
+    }
+
+    ParserWorker::~ParserWorker() = default;
+
+    void ParserWorker::wakeUp() {
+        pool->wakeUp();
+    }
+
+    void ParserWorker::run() {
+        if (ctx->trace & Ctx::TRACE_THREADS) {
+            std::ostringstream ss;
+            ss << std::this_thread::get_id();
+            ctx->logTrace(Ctx::TRACE_THREADS, "parser (" + ss.str() + ") start");
+        }
+
+        uint64_t generation = 0;
+        while (pool->getJob(generation)) {
+            // Records not decoded here are decoded again by the parser thread
+            try {
+                pool->work();
+            } catch (std::bad_alloc& ex) {
+                ctx->error(10018, "memory allocation failed: " + std::string(ex.what()));
+                ctx->stopHard();
+            }
+            pool->finished();
+        }
+
+        if (ctx->trace & Ctx::TRACE_THREADS) {
+            std::ostringstream ss;
+            ss << std::this_thread::get_id();
+            ctx->logTrace(Ctx::TRACE_THREADS, "parser (" + ss.str() + ") stop");
+        }
+    }
+}
@@ -32,7 +32,8 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "TransactionBuffer.h"
 
 namespace OpenLogReplicator {
-    Transaction::Transaction(typeXid newXid, std::map<LobKey, uint8_t*>* newOrphanedLobs, XmlCtx* newXmlCtx) :
+    Transaction::Transaction(typeXid newXid, std::map<LobKey, uint8_t*>* newOrphanedLobs, std::mutex* newOrphanedLobsMtx, LobPool* newLobPool,
+                             XmlCtx* newXmlCtx) :
             deallocTc(nullptr),
             opCodes(0),
             mergeBuffer(nullptr),
@@ -52,8 +53,14 @@ namespace OpenLogReplicator {
             shutdown(false),
             lastSplit(false),
             dump(false),
-            size(0) {
+            size(0),
+            chunks(0),
+            swapFileDes(-1),
+            swapChunks(0),
+            swapSize(0) {
         lobCtx.orphanedLobs = newOrphanedLobs;
+        lobCtx.orphanedLobsMtx = newOrphanedLobsMtx;
+        lobCtx.lobPool = newLobPool;
     }
 
     void Transaction::add(Metadata* metadata, TransactionBuffer* transactionBuffer, RedoLogRecord* redoLogRecord1) {
@@ -77,8 +84,8 @@ namespace OpenLogReplicator {
 
         while (lastTc != nullptr && lastTc->size > 0 && opCodes > 0) {
             uint64_t lengthLast = *(reinterpret_cast<uint64_t*>(lastTc->buffer + lastTc->size - ROW_HEADER_TOTAL + ROW_HEADER_SIZE));
-            // auto lastRedoLogRecord1 = reinterpret_cast<RedoLogRecord*>(lastTc->buffer + lastTc->size - lengthLast + ROW_HEADER_REDO1);
-            const auto lastRedoLogRecord2 = reinterpret_cast<const RedoLogRecord*>(lastTc->buffer + lastTc->size - lengthLast + ROW_HEADER_REDO2);
+            // auto lastRedoLogRecord1 = reinterpret_cast<const RowRecord*>(lastTc->buffer + lastTc->size - lengthLast + ROW_HEADER_REDO1);
+            const auto lastRedoLogRecord2 = reinterpret_cast<const RowRecord*>(lastTc->buffer + lastTc->size - lengthLast + ROW_HEADER_REDO2);
 
             bool ok = false;
             switch (lastRedoLogRecord2->opCode) {
@@ -148,8 +155,8 @@ namespace OpenLogReplicator {
 
         while (lastTc != nullptr && lastTc->size > 0 && opCodes > 0) {
             uint64_t lengthLast = *(reinterpret_cast<const uint64_t*>(lastTc->buffer + lastTc->size - ROW_HEADER_TOTAL + ROW_HEADER_SIZE));
-            const auto lastRedoLogRecord1 = reinterpret_cast<const RedoLogRecord*>(lastTc->buffer + lastTc->size - lengthLast + ROW_HEADER_REDO1);
-            const auto lastRedoLogRecord2 = reinterpret_cast<const RedoLogRecord*>(lastTc->buffer + lastTc->size - lengthLast + ROW_HEADER_REDO2);
+            const auto lastRedoLogRecord1 = reinterpret_cast<const RowRecord*>(lastTc->buffer + lastTc->size - lengthLast + ROW_HEADER_REDO1);
+            const auto lastRedoLogRecord2 = reinterpret_cast<const RowRecord*>(lastTc->buffer + lastTc->size - lengthLast + ROW_HEADER_REDO2);
 
             bool ok = false;
             switch (lastRedoLogRecord2->opCode) {
@@ -192,8 +199,14 @@ namespace OpenLogReplicator {
         bool opFlush;
         deallocTc = nullptr;
         uint64_t maxMessageMb = builder->getMaxMessageMb();
-        std::unique_lock<std::mutex> lckTransaction(metadata->mtxTransaction);
+        // System transactions modify the schema, others only read it and may be flushed in parallel by the builder pool
+        std::unique_lock<std::shared_mutex> lckTransaction(metadata->mtxTransaction, std::defer_lock);
+        std::shared_lock<std::shared_mutex> lckTransactionShared(metadata->mtxTransaction, std::defer_lock);
         std::unique_lock<std::mutex> lckSchema(metadata->mtxSchema, std::defer_lock);
+        if (system)
+            lckTransaction.lock();
+        else
+            lckTransactionShared.lock();
 
         if (opCodes == 0 || rollback)
             return;
@@ -216,19 +229,26 @@ namespace OpenLogReplicator {
         RedoLogRecord* last1 = nullptr;
         RedoLogRecord* last2 = nullptr;
 
-        TransactionChunk* tc = firstTc;
+        // Swapped chunks are read back in order before the chunks kept in memory
+        bool swapped = swapChunks > 0;
+        uint64_t swapIndex = 0;
+        TransactionChunk* tc = swapped ? transactionBuffer->swapIn(this, swapIndex++) : firstTc;
         while (tc != nullptr) {
             uint64_t pos = 0;
             for (uint64_t i = 0; i < tc->elements; ++i) {
                 typeOp2 op = *(reinterpret_cast<typeOp2*>(tc->buffer + pos));
 
-                RedoLogRecord* redoLogRecord1 = reinterpret_cast<RedoLogRecord*>(tc->buffer + pos + ROW_HEADER_REDO1);
-                RedoLogRecord* redoLogRecord2 = reinterpret_cast<RedoLogRecord*>(tc->buffer + pos + ROW_HEADER_REDO2);
+                // Records are rebuilt from the compact row header, they must live as long as they are linked in the row piece list
+                if (first1 == nullptr)
+                    flushRecords.clear();
+                RedoLogRecord* redoLogRecord1 = &flushRecords.emplace_back();
+                RedoLogRecord* redoLogRecord2 = &flushRecords.emplace_back();
+                TransactionBuffer::loadRowRecord(redoLogRecord1, tc->buffer + pos + ROW_HEADER_REDO1, tc->buffer + pos + ROW_HEADER_DATA);
+                TransactionBuffer::loadRowRecord(redoLogRecord2, tc->buffer + pos + ROW_HEADER_REDO2,
+                                                 tc->buffer + pos + ROW_HEADER_DATA + redoLogRecord1->length);
                 log(metadata->ctx, "flu1", redoLogRecord1);
                 log(metadata->ctx, "flu2", redoLogRecord2);
 
-                redoLogRecord1->data = tc->buffer + pos + ROW_HEADER_DATA;
-                redoLogRecord2->data = tc->buffer + pos + ROW_HEADER_DATA + redoLogRecord1->length;
                 pos += redoLogRecord1->length + redoLogRecord2->length + ROW_HEADER_TOTAL;
 
                 if (metadata->ctx->trace & Ctx::TRACE_TRANSACTION)
@@ -560,12 +580,23 @@ namespace OpenLogReplicator {
                 }
             }
 
-            TransactionChunk* nextTc = tc->next;
+            TransactionChunk* nextTc;
+            if (!swapped) {
+                nextTc = tc->next;
+            } else if (swapIndex < swapChunks) {
+                nextTc = transactionBuffer->swapIn(this, swapIndex++);
+            } else {
+                nextTc = firstTc;
+                swapped = false;
+            }
             tc->next = deallocTc;
             deallocTc = tc;
             tc = nextTc;
-            firstTc = tc;
+            if (!swapped)
+                firstTc = tc;
         }
+        transactionBuffer->swapDrop(this);
+        flushRecords.clear();
 
         while (deallocTc != nullptr) {
             TransactionChunk* nextTc = deallocTc->next;
@@ -602,6 +633,8 @@ namespace OpenLogReplicator {
             deallocTc = nextTc;
         }
         deallocTc = nullptr;
+        flushRecords.clear();
+        transactionBuffer->swapDrop(this);
 
         if (mergeBuffer != nullptr) {
             delete[] mergeBuffer;
@@ -630,6 +663,7 @@ namespace OpenLogReplicator {
            " flags: " << std::dec << begin << "/" << rollback << "/" << system <<
            " op: " << std::dec << opCodes <<
            " chunks: " << std::dec << tcCount <<
+           " swapped: " << std::dec << swapChunks <<
            " sz: " << std::dec << size;
         return ss.str();
     }
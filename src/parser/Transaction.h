@@ -17,7 +17,9 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <deque>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -33,6 +35,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     class Builder;
+    class LobPool;
     class Metadata;
     class TransactionBuffer;
     struct TransactionChunk;
@@ -41,6 +44,7 @@ namespace OpenLogReplicator {
     class Transaction final {
     protected:
         TransactionChunk* deallocTc;
+        std::deque<RedoLogRecord> flushRecords;
         uint64_t opCodes;
 
     public:
@@ -63,11 +67,18 @@ namespace OpenLogReplicator {
         bool lastSplit;
         bool dump;
         uint64_t size;
+        // Chunks kept in memory
+        uint64_t chunks;
+        // Chunks from the beginning of the transaction moved to the swap file
+        int swapFileDes;
+        uint64_t swapChunks;
+        uint64_t swapSize;
 
         // Attributes
         std::unordered_map<std::string, std::string> attributes;
 
-        explicit Transaction(typeXid newXid, std::map<LobKey, uint8_t*>* newOrphanedLobs, XmlCtx* newXmlCtx);
+        explicit Transaction(typeXid newXid, std::map<LobKey, uint8_t*>* newOrphanedLobs, std::mutex* newOrphanedLobsMtx, LobPool* newLobPool,
+                             XmlCtx* newXmlCtx);
 
         void add(Metadata* metadata, TransactionBuffer* transactionBuffer, RedoLogRecord* redoLogRecord1);
         void add(Metadata* metadata, TransactionBuffer* transactionBuffer, RedoLogRecord* redoLogRecord1, const RedoLogRecord* redoLogRecord2);
@@ -17,10 +17,14 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <cerrno>
 #include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "../common/RedoLogRecord.h"
 #include "../common/exception/RedoLogException.h"
+#include "../common/exception/RuntimeException.h"
 #include "OpCode0501.h"
 #include "OpCode050B.h"
 #include "Transaction.h"
@@ -28,7 +32,9 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     TransactionBuffer::TransactionBuffer(Ctx* newCtx) :
-            ctx(newCtx) {
+            ctx(newCtx),
+            swapFileNum(0),
+            lobPool(newCtx) {
         buffer[0] = 0;
     }
 
@@ -42,7 +48,7 @@ namespace OpenLogReplicator {
 
         for (const auto& orphanedLobsIt: orphanedLobs) {
             uint8_t* data = orphanedLobsIt.second;
-            delete[] data;
+            lobPool.freePage(data);
         }
         orphanedLobs.clear();
     }
@@ -54,6 +60,8 @@ namespace OpenLogReplicator {
             delete transaction;
         }
         xidTransactionMap.clear();
+        transactionOrder.clear();
+        swapOrder.clear();
     }
 
     Transaction* TransactionBuffer::findTransaction(XmlCtx* xmlCtx, typeXid xid, typeConId conId, bool old, bool add, bool rollback) {
@@ -69,10 +77,11 @@ namespace OpenLogReplicator {
             if (!add)
                 return nullptr;
 
-            transaction = new Transaction(xid, &orphanedLobs, xmlCtx);
+            transaction = new Transaction(xid, &orphanedLobs, &mtxOrphanedLobs, &lobPool, xmlCtx);
             {
                 std::unique_lock<std::mutex> lck(mtx);
                 xidTransactionMap.insert_or_assign(xidMap, transaction);
+                transactionOrder.insert(std::make_tuple(transaction->firstSequence, transaction->firstOffset, xidMap));
             }
 
             if (dumpXidList.find(xid) != dumpXidList.end())
@@ -86,29 +95,53 @@ namespace OpenLogReplicator {
         typeXidMap xidMap = (xid.getData() >> 32) | (static_cast<uint64_t>(conId) << 32);
         {
             std::unique_lock<std::mutex> lck(mtx);
-            xidTransactionMap.erase(xidMap);
+            auto xidTransactionMapIt = xidTransactionMap.find(xidMap);
+            if (xidTransactionMapIt == xidTransactionMap.end())
+                return;
+
+            Transaction* transaction = xidTransactionMapIt->second;
+            transactionOrder.erase(std::make_tuple(transaction->firstSequence, transaction->firstOffset, xidMap));
+            xidTransactionMap.erase(xidTransactionMapIt);
+            swapOrder.erase(std::make_pair(transaction->chunks, transaction));
+        }
+    }
+
+    void TransactionBuffer::beginTransaction(Transaction* transaction, typeConId conId, typeSeq sequence, uint64_t offset) {
+        typeXidMap xidMap = (transaction->xid.getData() >> 32) | (static_cast<uint64_t>(conId) << 32);
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            transactionOrder.erase(std::make_tuple(transaction->firstSequence, transaction->firstOffset, xidMap));
+            transaction->firstSequence = sequence;
+            transaction->firstOffset = offset;
+            transactionOrder.insert(std::make_tuple(sequence, offset, xidMap));
         }
     }
 
     TransactionChunk* TransactionBuffer::newTransactionChunk() {
-        uint8_t* chunk;
+        uint8_t* chunk = nullptr;
         TransactionChunk* tc;
-        uint64_t pos;
+        uint64_t pos = 0;
         uint64_t freeMap;
-        if (!partiallyFullChunks.empty()) {
-            auto partiallyFullChunksIt = partiallyFullChunks.cbegin();
-            chunk = partiallyFullChunksIt->first;
-            freeMap = partiallyFullChunksIt->second;
-            pos = ffs(freeMap) - 1;
-            freeMap &= ~(1 << pos);
-            if (freeMap == 0)
-                partiallyFullChunks.erase(chunk);
-            else
-                partiallyFullChunks.insert_or_assign(chunk, freeMap);
-        } else {
+        {
+            std::unique_lock<std::mutex> lck(mtxChunks);
+            if (!partiallyFullChunks.empty()) {
+                auto partiallyFullChunksIt = partiallyFullChunks.cbegin();
+                chunk = partiallyFullChunksIt->first;
+                freeMap = partiallyFullChunksIt->second;
+                pos = ffs(freeMap) - 1;
+                freeMap &= ~(1 << pos);
+                if (freeMap == 0)
+                    partiallyFullChunks.erase(chunk);
+                else
+                    partiallyFullChunks.insert_or_assign(chunk, freeMap);
+            }
+        }
+
+        // Allocation might wait for free memory, don't block other threads releasing chunks
+        if (chunk == nullptr) {
             chunk = ctx->getMemoryChunk(Ctx::MEMORY_MODULE_TRANSACTIONS, false);
-            pos = 0;
             freeMap = BUFFERS_FREE_MASK & (~1);
+            std::unique_lock<std::mutex> lck(mtxChunks);
             partiallyFullChunks.insert_or_assign(chunk, freeMap);
         }
 
@@ -122,15 +155,20 @@ namespace OpenLogReplicator {
     void TransactionBuffer::deleteTransactionChunk(TransactionChunk* tc) {
         uint8_t* chunk = tc->header;
         uint64_t pos = tc->pos;
-        uint64_t freeMap = partiallyFullChunks[chunk];
+        {
+            std::unique_lock<std::mutex> lck(mtxChunks);
+            uint64_t freeMap = partiallyFullChunks[chunk];
 
-        freeMap |= (1 << pos);
+            freeMap |= (1 << pos);
 
-        if (freeMap == BUFFERS_FREE_MASK) {
-            ctx->freeMemoryChunk(Ctx::MEMORY_MODULE_TRANSACTIONS, chunk, false);
+            if (freeMap != BUFFERS_FREE_MASK) {
+                partiallyFullChunks.insert_or_assign(chunk, freeMap);
+                return;
+            }
             partiallyFullChunks.erase(chunk);
-        } else
-            partiallyFullChunks.insert_or_assign(chunk, freeMap);
+        }
+
+        ctx->freeMemoryChunk(Ctx::MEMORY_MODULE_TRANSACTIONS, chunk, false);
     }
 
     void TransactionBuffer::deleteTransactionChunks(TransactionChunk* tc) {
@@ -155,12 +193,13 @@ namespace OpenLogReplicator {
                                               transaction->xid.toString());
 
             uint64_t lengthLast = *(reinterpret_cast<uint64_t*>(transaction->lastTc->buffer + transaction->lastTc->size - ROW_HEADER_TOTAL + ROW_HEADER_SIZE));
-            RedoLogRecord* last501 = reinterpret_cast<RedoLogRecord*>(transaction->lastTc->buffer + transaction->lastTc->size - lengthLast + ROW_HEADER_REDO1);
-            last501->data = transaction->lastTc->buffer + transaction->lastTc->size - lengthLast + ROW_HEADER_DATA;
+            RedoLogRecord last501;
+            loadRowRecord(&last501, transaction->lastTc->buffer + transaction->lastTc->size - lengthLast + ROW_HEADER_REDO1,
+                          transaction->lastTc->buffer + transaction->lastTc->size - lengthLast + ROW_HEADER_DATA);
 
-            uint64_t size = last501->length + redoLogRecord->length;
+            uint64_t size = last501.length + redoLogRecord->length;
             transaction->mergeBuffer = new uint8_t[size];
-            mergeBlocks(transaction->mergeBuffer, redoLogRecord, last501);
+            mergeBlocks(transaction->mergeBuffer, redoLogRecord, &last501);
             rollbackTransactionChunk(transaction);
         }
         if ((redoLogRecord->flg & (FLG_MULTIBLOCKUNDOTAIL | FLG_MULTIBLOCKUNDOMID)) != 0)
@@ -170,24 +209,27 @@ namespace OpenLogReplicator {
 
         // Empty list
         if (transaction->lastTc == nullptr) {
+            swapCheck();
             transaction->lastTc = newTransactionChunk();
             transaction->firstTc = transaction->lastTc;
+            swapOrderSet(transaction, transaction->chunks + 1);
         }
 
         // New block needed
         if (transaction->lastTc->size + length > DATA_BUFFER_SIZE) {
+            swapCheck();
             TransactionChunk* tcNew = newTransactionChunk();
             tcNew->prev = transaction->lastTc;
             transaction->lastTc->next = tcNew;
             transaction->lastTc = tcNew;
+            swapOrderSet(transaction, transaction->chunks + 1);
         }
 
         // Append to the chunk at the end
         TransactionChunk* tc = transaction->lastTc;
         *(reinterpret_cast<typeOp2*>(tc->buffer + tc->size + ROW_HEADER_OP)) = (redoLogRecord->opCode << 16);
-        memcpy(reinterpret_cast<void*>(tc->buffer + tc->size + ROW_HEADER_REDO1),
-               reinterpret_cast<const void*>(redoLogRecord), sizeof(RedoLogRecord));
-        memset(reinterpret_cast<void*>(tc->buffer + tc->size + ROW_HEADER_REDO2), 0, sizeof(RedoLogRecord));
+        storeRowRecord(tc->buffer + tc->size + ROW_HEADER_REDO1, redoLogRecord);
+        memset(reinterpret_cast<void*>(tc->buffer + tc->size + ROW_HEADER_REDO2), 0, sizeof(RowRecord));
         memcpy(reinterpret_cast<void*>(tc->buffer + tc->size + ROW_HEADER_DATA),
                reinterpret_cast<const void*>(redoLogRecord->data), redoLogRecord->length);
 
@@ -219,19 +261,20 @@ namespace OpenLogReplicator {
                                               transaction->xid.toString() + " second position");
 
             uint64_t lengthLast = *(reinterpret_cast<uint64_t*>(transaction->lastTc->buffer + transaction->lastTc->size - ROW_HEADER_TOTAL + ROW_HEADER_SIZE));
-            RedoLogRecord* last501 = reinterpret_cast<RedoLogRecord*>(transaction->lastTc->buffer + transaction->lastTc->size - lengthLast + ROW_HEADER_REDO1);
-            last501->data = transaction->lastTc->buffer + transaction->lastTc->size - lengthLast + ROW_HEADER_DATA;
+            RedoLogRecord last501;
+            loadRowRecord(&last501, transaction->lastTc->buffer + transaction->lastTc->size - lengthLast + ROW_HEADER_REDO1,
+                          transaction->lastTc->buffer + transaction->lastTc->size - lengthLast + ROW_HEADER_DATA);
 
-            uint64_t size = last501->length + redoLogRecord1->length;
+            uint64_t size = last501.length + redoLogRecord1->length;
             transaction->mergeBuffer = new uint8_t[size];
-            mergeBlocks(transaction->mergeBuffer, redoLogRecord1, last501);
+            mergeBlocks(transaction->mergeBuffer, redoLogRecord1, &last501);
 
             uint16_t fieldPos = redoLogRecord1->fieldPos;
             uint16_t fieldLength = ctx->read16(redoLogRecord1->data + redoLogRecord1->fieldLengthsDelta + 1 * 2);
             fieldPos += (fieldLength + 3) & 0xFFFC;
 
             ctx->write16(redoLogRecord1->data + fieldPos + 20, redoLogRecord1->flg);
-            OpCode0501::process0501(ctx, redoLogRecord1);
+            OpCode0501::process0501(ctx, redoLogRecord1, nullptr);
             length = redoLogRecord1->length + redoLogRecord2->length + ROW_HEADER_TOTAL;
 
             rollbackTransactionChunk(transaction);
@@ -240,25 +283,27 @@ namespace OpenLogReplicator {
 
         // Empty list
         if (transaction->lastTc == nullptr) {
+            swapCheck();
             transaction->lastTc = newTransactionChunk();
             transaction->firstTc = transaction->lastTc;
+            swapOrderSet(transaction, transaction->chunks + 1);
         }
 
         // New block needed
         if (transaction->lastTc->size + length > DATA_BUFFER_SIZE) {
+            swapCheck();
             TransactionChunk* tcNew = newTransactionChunk();
             tcNew->prev = transaction->lastTc;
             transaction->lastTc->next = tcNew;
             transaction->lastTc = tcNew;
+            swapOrderSet(transaction, transaction->chunks + 1);
         }
 
         // Append to the chunk at the end
         TransactionChunk* tc = transaction->lastTc;
         *(reinterpret_cast<typeOp2*>(tc->buffer + tc->size + ROW_HEADER_OP)) = (redoLogRecord1->opCode << 16) | redoLogRecord2->opCode;
-        memcpy(reinterpret_cast<void*>(tc->buffer + tc->size + ROW_HEADER_REDO1),
-               reinterpret_cast<const void*>(redoLogRecord1), sizeof(RedoLogRecord));
-        memcpy(reinterpret_cast<void*>(tc->buffer + tc->size + ROW_HEADER_REDO2),
-               reinterpret_cast<const void*>(redoLogRecord2), sizeof(RedoLogRecord));
+        storeRowRecord(tc->buffer + tc->size + ROW_HEADER_REDO1, redoLogRecord1);
+        storeRowRecord(tc->buffer + tc->size + ROW_HEADER_REDO2, redoLogRecord2);
         memcpy(reinterpret_cast<void*>(tc->buffer + tc->size + ROW_HEADER_DATA),
                reinterpret_cast<const void*>(redoLogRecord1->data), redoLogRecord1->length);
         memcpy(reinterpret_cast<void*>(tc->buffer + tc->size + ROW_HEADER_DATA + redoLogRecord1->length),
@@ -296,6 +341,16 @@ namespace OpenLogReplicator {
                 transaction->firstTc = nullptr;
             }
             deleteTransactionChunk(tc);
+            swapOrderSet(transaction, transaction->chunks - 1);
+
+            // Last chunk in memory removed, bring back the last swapped one
+            if (transaction->lastTc == nullptr && transaction->swapChunks > 0) {
+                --transaction->swapChunks;
+                transaction->lastTc = swapIn(transaction, transaction->swapChunks);
+                transaction->firstTc = transaction->lastTc;
+                transaction->swapSize -= transaction->lastTc->size;
+                swapOrderSet(transaction, transaction->chunks + 1);
+            }
         }
     }
 
@@ -345,18 +400,248 @@ namespace OpenLogReplicator {
             redoLogRecord1->flg &= ~(FLG_MULTIBLOCKUNDOHEAD | FLG_MULTIBLOCKUNDOMID | FLG_MULTIBLOCKUNDOTAIL);
     }
 
+    void TransactionBuffer::storeRowRecord(uint8_t* buffer, const RedoLogRecord* redoLogRecord) {
+        RowRecord rowRecord;
+        memset(reinterpret_cast<void*>(&rowRecord), 0, sizeof(RowRecord));
+        rowRecord.version = RowRecord::VERSION;
+        rowRecord.scnRecord = redoLogRecord->scnRecord;
+        rowRecord.scn = redoLogRecord->scn;
+        rowRecord.dataOffset = redoLogRecord->dataOffset;
+        rowRecord.lobOffset = redoLogRecord->lobOffset;
+        rowRecord.uba = redoLogRecord->uba;
+        rowRecord.xid = redoLogRecord->xid;
+        rowRecord.lobId = redoLogRecord->lobId;
+        rowRecord.obj = redoLogRecord->obj;
+        rowRecord.dataObj = redoLogRecord->dataObj;
+        rowRecord.dba = redoLogRecord->dba;
+        rowRecord.bdba = redoLogRecord->bdba;
+        rowRecord.dba0 = redoLogRecord->dba0;
+        rowRecord.dba1 = redoLogRecord->dba1;
+        rowRecord.dba2 = redoLogRecord->dba2;
+        rowRecord.dba3 = redoLogRecord->dba3;
+        rowRecord.suppLogBdba = redoLogRecord->suppLogBdba;
+        rowRecord.lobPageNo = redoLogRecord->lobPageNo;
+        rowRecord.lobPageSize = redoLogRecord->lobPageSize;
+        rowRecord.lobLengthPages = redoLogRecord->lobLengthPages;
+        rowRecord.subScn = redoLogRecord->subScn;
+        rowRecord.length = static_cast<uint16_t>(redoLogRecord->length);
+        rowRecord.fieldCnt = redoLogRecord->fieldCnt;
+        rowRecord.fieldPos = static_cast<uint16_t>(redoLogRecord->fieldPos);
+        rowRecord.rowData = redoLogRecord->rowData;
+        rowRecord.slotsDelta = static_cast<uint16_t>(redoLogRecord->slotsDelta);
+        rowRecord.rowLenghsDelta = static_cast<uint16_t>(redoLogRecord->rowLenghsDelta);
+        rowRecord.fieldLengthsDelta = static_cast<uint16_t>(redoLogRecord->fieldLengthsDelta);
+        rowRecord.nullsDelta = static_cast<uint16_t>(redoLogRecord->nullsDelta);
+        rowRecord.colNumsDelta = static_cast<uint16_t>(redoLogRecord->colNumsDelta);
+        rowRecord.indKeyData = static_cast<uint16_t>(redoLogRecord->indKeyData);
+        rowRecord.indKeyDataLength = redoLogRecord->indKeyDataLength;
+        rowRecord.lobData = static_cast<uint16_t>(redoLogRecord->lobData);
+        rowRecord.lobDataLength = redoLogRecord->lobDataLength;
+        rowRecord.lobLengthRest = redoLogRecord->lobLengthRest;
+        rowRecord.flg = redoLogRecord->flg;
+        rowRecord.opCode = redoLogRecord->opCode;
+        rowRecord.opc = redoLogRecord->opc;
+        rowRecord.slot = redoLogRecord->slot;
+        rowRecord.slt = redoLogRecord->slt;
+        rowRecord.sizeDelt = redoLogRecord->sizeDelt;
+        rowRecord.suppLogCC = redoLogRecord->suppLogCC;
+        rowRecord.suppLogBefore = redoLogRecord->suppLogBefore;
+        rowRecord.suppLogAfter = redoLogRecord->suppLogAfter;
+        rowRecord.suppLogSlot = redoLogRecord->suppLogSlot;
+        rowRecord.suppLogRowData = static_cast<uint16_t>(redoLogRecord->suppLogRowData);
+        rowRecord.suppLogNumsDelta = static_cast<uint16_t>(redoLogRecord->suppLogNumsDelta);
+        rowRecord.suppLogLenDelta = static_cast<uint16_t>(redoLogRecord->suppLogLenDelta);
+        rowRecord.seq = redoLogRecord->seq;
+        rowRecord.rci = redoLogRecord->rci;
+        rowRecord.op = redoLogRecord->op;
+        rowRecord.cc = redoLogRecord->cc;
+        rowRecord.fb = redoLogRecord->fb;
+        rowRecord.nRow = redoLogRecord->nRow;
+        rowRecord.indKeyDataCode = redoLogRecord->indKeyDataCode;
+        rowRecord.suppLogType = redoLogRecord->suppLogType;
+        rowRecord.suppLogFb = redoLogRecord->suppLogFb;
+        rowRecord.compressed = redoLogRecord->compressed;
+        memcpy(reinterpret_cast<void*>(buffer), reinterpret_cast<const void*>(&rowRecord), sizeof(RowRecord));
+    }
+
+    void TransactionBuffer::loadRowRecord(RedoLogRecord* redoLogRecord, const uint8_t* buffer, uint8_t* data) {
+        RowRecord rowRecord;
+        memcpy(reinterpret_cast<void*>(&rowRecord), reinterpret_cast<const void*>(buffer), sizeof(RowRecord));
+        memset(reinterpret_cast<void*>(redoLogRecord), 0, sizeof(RedoLogRecord));
+        redoLogRecord->data = data;
+        // Empty second record of a single record row
+        if (rowRecord.version == 0)
+            return;
+        if (rowRecord.version != RowRecord::VERSION)
+            throw RedoLogException(50070, "unknown transaction buffer row version: " + std::to_string(static_cast<uint64_t>(rowRecord.version)));
+
+        redoLogRecord->scnRecord = rowRecord.scnRecord;
+        redoLogRecord->scn = rowRecord.scn;
+        redoLogRecord->dataOffset = rowRecord.dataOffset;
+        redoLogRecord->lobOffset = rowRecord.lobOffset;
+        redoLogRecord->uba = rowRecord.uba;
+        redoLogRecord->xid = rowRecord.xid;
+        redoLogRecord->lobId = rowRecord.lobId;
+        redoLogRecord->obj = rowRecord.obj;
+        redoLogRecord->dataObj = rowRecord.dataObj;
+        redoLogRecord->dba = rowRecord.dba;
+        redoLogRecord->bdba = rowRecord.bdba;
+        redoLogRecord->dba0 = rowRecord.dba0;
+        redoLogRecord->dba1 = rowRecord.dba1;
+        redoLogRecord->dba2 = rowRecord.dba2;
+        redoLogRecord->dba3 = rowRecord.dba3;
+        redoLogRecord->suppLogBdba = rowRecord.suppLogBdba;
+        redoLogRecord->lobPageNo = rowRecord.lobPageNo;
+        redoLogRecord->lobPageSize = rowRecord.lobPageSize;
+        redoLogRecord->lobLengthPages = rowRecord.lobLengthPages;
+        redoLogRecord->subScn = rowRecord.subScn;
+        redoLogRecord->length = rowRecord.length;
+        redoLogRecord->fieldCnt = rowRecord.fieldCnt;
+        redoLogRecord->fieldPos = rowRecord.fieldPos;
+        redoLogRecord->rowData = rowRecord.rowData;
+        redoLogRecord->slotsDelta = rowRecord.slotsDelta;
+        redoLogRecord->rowLenghsDelta = rowRecord.rowLenghsDelta;
+        redoLogRecord->fieldLengthsDelta = rowRecord.fieldLengthsDelta;
+        redoLogRecord->nullsDelta = rowRecord.nullsDelta;
+        redoLogRecord->colNumsDelta = rowRecord.colNumsDelta;
+        redoLogRecord->indKeyData = rowRecord.indKeyData;
+        redoLogRecord->indKeyDataLength = rowRecord.indKeyDataLength;
+        redoLogRecord->lobData = rowRecord.lobData;
+        redoLogRecord->lobDataLength = rowRecord.lobDataLength;
+        redoLogRecord->lobLengthRest = rowRecord.lobLengthRest;
+        redoLogRecord->flg = rowRecord.flg;
+        redoLogRecord->opCode = rowRecord.opCode;
+        redoLogRecord->opc = rowRecord.opc;
+        redoLogRecord->slot = rowRecord.slot;
+        redoLogRecord->slt = rowRecord.slt;
+        redoLogRecord->sizeDelt = rowRecord.sizeDelt;
+        redoLogRecord->suppLogCC = rowRecord.suppLogCC;
+        redoLogRecord->suppLogBefore = rowRecord.suppLogBefore;
+        redoLogRecord->suppLogAfter = rowRecord.suppLogAfter;
+        redoLogRecord->suppLogSlot = rowRecord.suppLogSlot;
+        redoLogRecord->suppLogRowData = rowRecord.suppLogRowData;
+        redoLogRecord->suppLogNumsDelta = rowRecord.suppLogNumsDelta;
+        redoLogRecord->suppLogLenDelta = rowRecord.suppLogLenDelta;
+        redoLogRecord->seq = rowRecord.seq;
+        redoLogRecord->rci = rowRecord.rci;
+        redoLogRecord->op = rowRecord.op;
+        redoLogRecord->cc = rowRecord.cc;
+        redoLogRecord->fb = rowRecord.fb;
+        redoLogRecord->nRow = rowRecord.nRow;
+        redoLogRecord->indKeyDataCode = rowRecord.indKeyDataCode;
+        redoLogRecord->suppLogType = rowRecord.suppLogType;
+        redoLogRecord->suppLogFb = rowRecord.suppLogFb;
+        redoLogRecord->compressed = rowRecord.compressed;
+    }
+
     void TransactionBuffer::checkpoint(typeSeq& minSequence, uint64_t& minOffset, typeXid& minXid) {
-        for (auto xidTransactionMapIt: xidTransactionMap) {
-            const Transaction* transaction = xidTransactionMapIt.second;
-            if (transaction->firstSequence < minSequence) {
-                minSequence = transaction->firstSequence;
-                minOffset = transaction->firstOffset;
-                minXid = transaction->xid;
-            } else if (transaction->firstSequence == minSequence && transaction->firstOffset < minOffset) {
-                minOffset = transaction->firstOffset;
-                minXid = transaction->xid;
-            }
+        if (transactionOrder.empty())
+            return;
+
+        const auto& first = *transactionOrder.begin();
+        if (std::get<0>(first) < minSequence || (std::get<0>(first) == minSequence && std::get<1>(first) < minOffset)) {
+            minSequence = std::get<0>(first);
+            minOffset = std::get<1>(first);
+            minXid = xidTransactionMap[std::get<2>(first)]->xid;
+        }
+    }
+
+    void TransactionBuffer::swapOrderSet(Transaction* transaction, uint64_t chunks) {
+        swapOrder.erase(std::make_pair(transaction->chunks, transaction));
+        transaction->chunks = chunks;
+        // The last chunk always stays in memory
+        if (chunks > 1)
+            swapOrder.insert(std::make_pair(chunks, transaction));
+    }
+
+    void TransactionBuffer::swapCheck() {
+        // Only transaction chunks can be swapped, LOB pages stay in memory and are not counted in
+        if (ctx->swapPath.empty() || ctx->getUsedMemoryModule(Ctx::MEMORY_MODULE_TRANSACTIONS) < ctx->swapMb)
+            return;
+
+        // Chunks released by earlier swapping are used first, memory grows only when no chunk is free
+        {
+            std::unique_lock<std::mutex> lck(mtxChunks);
+            if (!partiallyFullChunks.empty())
+                return;
+        }
+
+        // Swap the transactions keeping most chunks in memory, until the space of a whole memory chunk is released
+        uint64_t released = 0;
+        while (released < SWAP_RELEASE_MIN && !swapOrder.empty()) {
+            Transaction* transaction = swapOrder.rbegin()->second;
+            released += transaction->chunks - 1;
+            swapOut(transaction);
+        }
+    }
+
+    void TransactionBuffer::swapOut(Transaction* transaction) {
+        if (transaction->swapFileDes == -1) {
+            // The file is removed right away, the space is released when the transaction is done or the program exits
+            std::string fileName = ctx->swapPath + "/" + transaction->xid.toString() + "." + std::to_string(swapFileNum++) + ".swap";
+            transaction->swapFileDes = open(fileName.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+            if (transaction->swapFileDes == -1)
+                throw RuntimeException(10006, "file: " + fileName + " - open for write returned: " + strerror(errno));
+            if (unlink(fileName.c_str()) != 0)
+                throw RuntimeException(10010, "file: " + fileName + " - unlink returned: " + strerror(errno));
+        }
+
+        if (ctx->trace & Ctx::TRACE_TRANSACTION)
+            ctx->logTrace(Ctx::TRACE_TRANSACTION, "swap out: " + transaction->toString());
+
+        // The last chunk stays in memory for new operations and rollback
+        while (transaction->firstTc != transaction->lastTc) {
+            TransactionChunk* tc = transaction->firstTc;
+            uint64_t length = HEADER_BUFFER_SIZE + tc->size;
+            int64_t bytesWritten = pwrite(transaction->swapFileDes, reinterpret_cast<const void*>(tc), length,
+                                          static_cast<int64_t>(transaction->swapChunks * FULL_BUFFER_SIZE));
+            if (bytesWritten != static_cast<int64_t>(length))
+                throw RuntimeException(10007, "file: " + ctx->swapPath + "/" + transaction->xid.toString() + " - " + std::to_string(bytesWritten) +
+                                              " bytes written instead of " + std::to_string(length) + ", code returned: " + strerror(errno));
+
+            ++transaction->swapChunks;
+            transaction->swapSize += tc->size;
+            transaction->firstTc = tc->next;
+            transaction->firstTc->prev = nullptr;
+            deleteTransactionChunk(tc);
         }
+        swapOrderSet(transaction, 1);
+    }
+
+    TransactionChunk* TransactionBuffer::swapIn(Transaction* transaction, uint64_t index) {
+        TransactionChunk* tc = newTransactionChunk();
+        uint8_t* header = tc->header;
+        uint64_t pos = tc->pos;
+        auto offset = static_cast<int64_t>(index * FULL_BUFFER_SIZE);
+
+        int64_t bytesRead = pread(transaction->swapFileDes, reinterpret_cast<void*>(tc), HEADER_BUFFER_SIZE, offset);
+        if (bytesRead == static_cast<int64_t>(HEADER_BUFFER_SIZE) && tc->size <= DATA_BUFFER_SIZE)
+            bytesRead = pread(transaction->swapFileDes, reinterpret_cast<void*>(tc->buffer), tc->size,
+                              offset + static_cast<int64_t>(HEADER_BUFFER_SIZE));
+        else
+            bytesRead = -1;
+
+        uint64_t size = tc->size;
+        tc->header = header;
+        tc->pos = pos;
+        tc->prev = nullptr;
+        tc->next = nullptr;
+        if (bytesRead != static_cast<int64_t>(size)) {
+            deleteTransactionChunk(tc);
+            throw RuntimeException(10005, "file: " + ctx->swapPath + "/" + transaction->xid.toString() + " - " + std::to_string(bytesRead) +
+                                          " bytes read instead of " + std::to_string(size));
+        }
+
+        return tc;
+    }
+
+    void TransactionBuffer::swapDrop(Transaction* transaction) {
+        if (transaction->swapFileDes != -1) {
+            close(transaction->swapFileDes);
+            transaction->swapFileDes = -1;
+        }
+        transaction->swapChunks = 0;
+        transaction->swapSize = 0;
     }
 
     void TransactionBuffer::addOrphanedLob(RedoLogRecord* redoLogRecord1) {
@@ -366,26 +651,23 @@ namespace OpenLogReplicator {
 
         LobKey lobKey(redoLogRecord1->lobId, redoLogRecord1->dba);
 
-        if (orphanedLobs.find(lobKey) != orphanedLobs.end()) {
-            ctx->warning(60009, "duplicate orphaned lob: " + redoLogRecord1->lobId.lower() + ", page: " +
-                                std::to_string(redoLogRecord1->dba));
-            return;
+        {
+            std::unique_lock<std::mutex> lck(mtxOrphanedLobs);
+            if (orphanedLobs.find(lobKey) != orphanedLobs.end()) {
+                lck.unlock();
+                ctx->warning(60009, "duplicate orphaned lob: " + redoLogRecord1->lobId.lower() + ", page: " +
+                                    std::to_string(redoLogRecord1->dba));
+                return;
+            }
         }
 
-        orphanedLobs.insert_or_assign(lobKey, allocateLob(redoLogRecord1));
+        // The page is allocated without the lock, allocation may wait for memory freed by the builder pool threads
+        uint8_t* data = allocateLob(redoLogRecord1);
+        std::unique_lock<std::mutex> lck(mtxOrphanedLobs);
+        orphanedLobs.insert_or_assign(lobKey, data);
     }
 
-    uint8_t* TransactionBuffer::allocateLob(RedoLogRecord* redoLogRecord1) {
-        uint64_t length = redoLogRecord1->length + sizeof(RedoLogRecord) + sizeof(uint64_t);
-        uint8_t* data = new uint8_t[length];
-        *(reinterpret_cast<uint64_t*>(data)) = length;
-        memcpy(reinterpret_cast<void*>(data + sizeof(uint64_t)),
-               reinterpret_cast<const void*>(redoLogRecord1), sizeof(RedoLogRecord));
-        memcpy(reinterpret_cast<void*>(data + sizeof(uint64_t) + sizeof(RedoLogRecord)),
-               reinterpret_cast<const void*>(redoLogRecord1->data), redoLogRecord1->length);
-        redoLogRecord1 = reinterpret_cast<RedoLogRecord*>(data + sizeof(uint64_t));
-        redoLogRecord1->data = data + sizeof(uint64_t) + sizeof(RedoLogRecord);
-
-        return data;
+    uint8_t* TransactionBuffer::allocateLob(const RedoLogRecord* redoLogRecord1) {
+        return lobPool.allocatePage(redoLogRecord1);
     }
 }
@@ -20,11 +20,14 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <map>
 #include <mutex>
 #include <set>
+#include <tuple>
 #include <unordered_map>
 
 #include "../common/Ctx.h"
 #include "../common/LobKey.h"
+#include "../common/LobPool.h"
 #include "../common/types.h"
+#include "../common/typeLobId.h"
 #include "../common/typeXid.h"
 
 #ifndef TRANSACTION_BUFFER_H_
@@ -32,10 +35,10 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 #define ROW_HEADER_OP       (0)
 #define ROW_HEADER_REDO1    (sizeof(typeOp2))
-#define ROW_HEADER_REDO2    (sizeof(typeOp2)+sizeof(RedoLogRecord))
-#define ROW_HEADER_DATA     (sizeof(typeOp2)+sizeof(RedoLogRecord)+sizeof(RedoLogRecord))
-#define ROW_HEADER_SIZE     (sizeof(typeOp2)+sizeof(RedoLogRecord)+sizeof(RedoLogRecord))
-#define ROW_HEADER_TOTAL    (sizeof(typeOp2)+sizeof(RedoLogRecord)+sizeof(RedoLogRecord)+sizeof(uint64_t))
+#define ROW_HEADER_REDO2    (sizeof(typeOp2)+sizeof(RowRecord))
+#define ROW_HEADER_DATA     (sizeof(typeOp2)+sizeof(RowRecord)+sizeof(RowRecord))
+#define ROW_HEADER_SIZE     (sizeof(typeOp2)+sizeof(RowRecord)+sizeof(RowRecord))
+#define ROW_HEADER_TOTAL    (sizeof(typeOp2)+sizeof(RowRecord)+sizeof(RowRecord)+sizeof(uint64_t))
 
 #define FULL_BUFFER_SIZE    65536
 #define HEADER_BUFFER_SIZE  (sizeof(uint64_t)+sizeof(uint64_t)+sizeof(uint64_t)+sizeof(uint8_t*)+sizeof(TransactionChunk*)+sizeof(TransactionChunk*))
@@ -47,6 +50,71 @@ namespace OpenLogReplicator {
     class Transaction;
     class XmlCtx;
 
+    // Compact form of RedoLogRecord kept in the transaction buffer, only fields used when the transaction is flushed are stored.
+    // Offsets and lengths inside of the record data are limited by DATA_BUFFER_SIZE and fit in 16 bits.
+    struct RowRecord {
+        static constexpr uint8_t VERSION = 1;
+
+        typeScn scnRecord;
+        typeScn scn;
+        uint64_t dataOffset;
+        uint64_t lobOffset;
+        typeUba uba;
+        typeXid xid;
+        typeLobId lobId;
+        typeObj obj;
+        typeDataObj dataObj;
+        typeDba dba;
+        typeDba bdba;
+        typeDba dba0;
+        typeDba dba1;
+        typeDba dba2;
+        typeDba dba3;
+        typeDba suppLogBdba;
+        uint32_t lobPageNo;
+        uint32_t lobPageSize;
+        uint32_t lobLengthPages;
+        typeSubScn subScn;
+        uint16_t length;
+        typeField fieldCnt;
+        uint16_t fieldPos;
+        typeField rowData;
+        uint16_t slotsDelta;
+        uint16_t rowLenghsDelta;
+        uint16_t fieldLengthsDelta;
+        uint16_t nullsDelta;
+        uint16_t colNumsDelta;
+        uint16_t indKeyData;
+        uint16_t indKeyDataLength;
+        uint16_t lobData;
+        uint16_t lobDataLength;
+        uint16_t lobLengthRest;
+        uint16_t flg;
+        typeOp1 opCode;
+        typeOp1 opc;
+        typeSlot slot;
+        typeSlt slt;
+        uint16_t sizeDelt;
+        uint16_t suppLogCC;
+        uint16_t suppLogBefore;
+        uint16_t suppLogAfter;
+        typeSlot suppLogSlot;
+        uint16_t suppLogRowData;
+        uint16_t suppLogNumsDelta;
+        uint16_t suppLogLenDelta;
+        uint8_t version;
+        uint8_t seq;
+        typeRci rci;
+        uint8_t op;
+        uint8_t cc;
+        uint8_t fb;
+        uint8_t nRow;
+        uint8_t indKeyDataCode;
+        uint8_t suppLogType;
+        uint8_t suppLogFb;
+        bool compressed;
+    };
+
     struct TransactionChunk {
         uint64_t elements;
         uint64_t size;
@@ -58,19 +126,33 @@ namespace OpenLogReplicator {
     };
 
     class TransactionBuffer {
+    public:
+        static constexpr uint64_t SWAP_RELEASE_MIN = Ctx::MEMORY_CHUNK_SIZE / FULL_BUFFER_SIZE;
+
     protected:
         Ctx* ctx;
         uint8_t buffer[DATA_BUFFER_SIZE];
+        // Chunks are released also by the builder pool threads
+        std::mutex mtxChunks;
         std::unordered_map<uint8_t*, uint64_t> partiallyFullChunks;
 
         std::mutex mtx;
         std::unordered_map<typeXidMap, Transaction*> xidTransactionMap;
+        // Open transactions ordered by position of the first redo record, used for checkpoint
+        std::set<std::tuple<typeSeq, uint64_t, typeXidMap>> transactionOrder;
+        uint64_t swapFileNum;
+        // Open transactions with more than one chunk in memory, ordered by number of chunks, used for swap
+        std::set<std::pair<uint64_t, Transaction*>> swapOrder;
+        // Orphaned LOB pages are picked up also by the builder pool threads
+        std::mutex mtxOrphanedLobs;
         std::map<LobKey, uint8_t*> orphanedLobs;
+        LobPool lobPool;
 
     public:
         std::set<typeXid> skipXidList;
         std::set<typeXid> dumpXidList;
         std::set<typeXidMap> brokenXidMapList;
+        std::unordered_map<typeLobId, typeXid> lobIdToXidMap;
         std::string dumpPath;
 
         explicit TransactionBuffer(Ctx* newCtx);
@@ -79,6 +161,7 @@ namespace OpenLogReplicator {
         void purge();
         [[nodiscard]] Transaction* findTransaction(XmlCtx* xmlCtx, typeXid xid, typeConId conId, bool old, bool add, bool rollback);
         void dropTransaction(typeXid xid, typeConId conId);
+        void beginTransaction(Transaction* transaction, typeConId conId, typeSeq sequence, uint64_t offset);
         void addTransactionChunk(Transaction* transaction, RedoLogRecord* redoLogRecord);
         void addTransactionChunk(Transaction* transaction, RedoLogRecord* redoLogRecord1, const RedoLogRecord* redoLogRecord2);
         void rollbackTransactionChunk(Transaction* transaction);
@@ -86,9 +169,16 @@ namespace OpenLogReplicator {
         void deleteTransactionChunk(TransactionChunk* tc);
         void deleteTransactionChunks(TransactionChunk* tc);
         void mergeBlocks(uint8_t* mergeBuffer, RedoLogRecord* redoLogRecord1, const RedoLogRecord* redoLogRecord2);
+        static void storeRowRecord(uint8_t* buffer, const RedoLogRecord* redoLogRecord);
+        static void loadRowRecord(RedoLogRecord* redoLogRecord, const uint8_t* buffer, uint8_t* data);
         void checkpoint(typeSeq& minSequence, uint64_t& minOffset, typeXid& minXid);
+        void swapOrderSet(Transaction* transaction, uint64_t chunks);
+        void swapCheck();
+        void swapOut(Transaction* transaction);
+        [[nodiscard]] TransactionChunk* swapIn(Transaction* transaction, uint64_t index);
+        void swapDrop(Transaction* transaction);
         void addOrphanedLob(RedoLogRecord* redoLogRecord1);
-        uint8_t* allocateLob(RedoLogRecord* redoLogRecord1);
+        [[nodiscard]] uint8_t* allocateLob(const RedoLogRecord* redoLogRecord1);
     };
 }
 
@@ -25,6 +25,12 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <fcntl.h>
 #include <thread>
 #include <unistd.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #include "../common/Clock.h"
 #include "../common/Ctx.h"
@@ -73,6 +79,9 @@ namespace OpenLogReplicator {
             bufferEnd(0),
             status(STATUS_SLEEPING),
             ret(REDO_OK),
+            prefetching(false),
+            prefetched(false),
+            xorFoldKernel(selectXorFold()),
             redoBufferList(nullptr) {
     }
 
@@ -637,7 +646,11 @@ namespace OpenLogReplicator {
                 {
                     std::unique_lock<std::mutex> lck(mtx);
                     ret = currentRet;
-                    status = STATUS_SLEEPING;
+                    // Prefetch continues with the header check without waiting for the parser
+                    if (prefetching && currentRet == REDO_OK)
+                        status = STATUS_UPDATE;
+                    else
+                        status = STATUS_SLEEPING;
                     condParserSleeping.notify_all();
                 }
                 continue;
@@ -662,7 +675,10 @@ namespace OpenLogReplicator {
                 {
                     std::unique_lock<std::mutex> lck(mtx);
                     ret = currentRet;
-                    status = STATUS_SLEEPING;
+                    if (prefetching && currentRet == REDO_OK)
+                        status = STATUS_READ;
+                    else
+                        status = STATUS_SLEEPING;
                     condParserSleeping.notify_all();
                 }
             } else if (status == STATUS_READ) {
@@ -709,7 +725,7 @@ namespace OpenLogReplicator {
 
                     // #1 read
                     if (bufferScan < fileSize && (ctx->buffersFree > 0 || (bufferScan % Ctx::MEMORY_CHUNK_SIZE) > 0)
-                        && (!reachedZero || lastReadTime + static_cast<time_t>(ctx->redoReadSleepUs) < loopTime))
+                        && (!reachedZero || lastReadTime + static_cast<time_t>(ctx->redoReadSleepUs) < loopTime) && prefetchAllowed())
                         if (!read1())
                             break;
 
@@ -742,20 +758,79 @@ namespace OpenLogReplicator {
                 }
 
                 {
+                    // Keep the status if the parser already requested another operation
                     std::unique_lock<std::mutex> lck(mtx);
-                    status = STATUS_SLEEPING;
+                    if (status == STATUS_READ)
+                        status = STATUS_SLEEPING;
                     condParserSleeping.notify_all();
                 }
             }
         }
     }
 
-    typeSum Reader::calcChSum(uint8_t* buffer, uint64_t size) const {
-        typeSum oldChSum = ctx->read16(buffer + 14);
+    uint64_t Reader::xorFold(const uint8_t* buffer, uint64_t size) {
         uint64_t sum = 0;
 
         for (uint64_t i = 0; i < size / 8; ++i, buffer += 8)
-            sum ^= *(reinterpret_cast<uint64_t*>(buffer));
+            sum ^= *(reinterpret_cast<const uint64_t*>(buffer));
+
+        return sum;
+    }
+
+#if defined(__x86_64__)
+    __attribute__((target("avx2"))) uint64_t Reader::xorFoldAvx2(const uint8_t* buffer, uint64_t size) {
+        __m256i acc = _mm256_setzero_si256();
+        uint64_t i = 0;
+
+        for (; i + 32 <= size; i += 32)
+            acc = _mm256_xor_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer + i)));
+        __m128i acc128 = _mm_xor_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(acc128) ^ _mm_extract_epi64(acc128, 1)) ^ xorFold(buffer + i, size - i);
+    }
+
+    __attribute__((target("avx512f,avx2"))) uint64_t Reader::xorFoldAvx512(const uint8_t* buffer, uint64_t size) {
+        __m512i acc = _mm512_setzero_si512();
+        uint64_t i = 0;
+
+        for (; i + 64 <= size; i += 64)
+            acc = _mm512_xor_si512(acc, _mm512_loadu_si512(reinterpret_cast<const void*>(buffer + i)));
+        __m256i acc256 = _mm256_xor_si256(_mm512_castsi512_si256(acc), _mm512_extracti64x4_epi64(acc, 1));
+        __m128i acc128 = _mm_xor_si128(_mm256_castsi256_si128(acc256), _mm256_extracti128_si256(acc256, 1));
+
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(acc128) ^ _mm_extract_epi64(acc128, 1)) ^ xorFold(buffer + i, size - i);
+    }
+#endif
+
+#if defined(__aarch64__)
+    uint64_t Reader::xorFoldNeon(const uint8_t* buffer, uint64_t size) {
+        uint64x2_t acc = vdupq_n_u64(0);
+        uint64_t i = 0;
+
+        for (; i + 16 <= size; i += 16)
+            acc = veorq_u64(acc, vld1q_u64(reinterpret_cast<const uint64_t*>(buffer + i)));
+
+        return (vgetq_lane_u64(acc, 0) ^ vgetq_lane_u64(acc, 1)) ^ xorFold(buffer + i, size - i);
+    }
+#endif
+
+    Reader::XorFoldKernel Reader::selectXorFold() {
+#if defined(__x86_64__)
+        if (__builtin_cpu_supports("avx512f"))
+            return xorFoldAvx512;
+        if (__builtin_cpu_supports("avx2"))
+            return xorFoldAvx2;
+#endif
+#if defined(__aarch64__)
+        return xorFoldNeon;
+#else
+        return xorFold;
+#endif
+    }
+
+    typeSum Reader::calcChSum(uint8_t* buffer, uint64_t size) const {
+        typeSum oldChSum = ctx->read16(buffer + 14);
+        uint64_t sum = xorFoldKernel(buffer, size);
         sum ^= (sum >> 32);
         sum ^= (sum >> 16);
         sum ^= oldChSum;
@@ -1045,12 +1120,19 @@ namespace OpenLogReplicator {
     }
 
     void Reader::setBufferStartEnd(uint64_t newBufferStart, uint64_t newBufferEnd) {
+        std::unique_lock<std::mutex> lck(mtx);
+        // Prefetched data is already positioned at the start of the file
+        if (prefetched && bufferStart == newBufferStart)
+            return;
+        prefetched = false;
         bufferStart = newBufferStart;
         bufferEnd = newBufferEnd;
     }
 
     bool Reader::checkRedoLog() {
         std::unique_lock<std::mutex> lck(mtx);
+        prefetching = false;
+        prefetched = false;
         status = STATUS_CHECK;
         sequence = 0;
         firstScn = ZERO_SCN;
@@ -1100,11 +1182,86 @@ namespace OpenLogReplicator {
 
     void Reader::setStatusRead() {
         std::unique_lock<std::mutex> lck(mtx);
+        // Prefetch is either still reading or has already finished the file
+        if (prefetched) {
+            prefetched = false;
+            condBufferFull.notify_all();
+            return;
+        }
         status = STATUS_READ;
         condBufferFull.notify_all();
         condReaderSleeping.notify_all();
     }
 
+    bool Reader::prefetchAllowed() const {
+        if (!prefetching)
+            return true;
+
+        // Buffers needed by the reader of the file being parsed are never used for prefetch
+        if (redoBufferList[(bufferScan / Ctx::MEMORY_CHUNK_SIZE) % ctx->readBufferMax] != nullptr)
+            return true;
+        return ctx->buffersFree > ctx->readBufferMax / 2 + ctx->archPrefetch;
+    }
+
+    void Reader::prefetch() {
+        std::unique_lock<std::mutex> lck(mtx);
+        prefetching = true;
+        prefetched = false;
+        status = STATUS_CHECK;
+        sequence = 0;
+        firstScn = ZERO_SCN;
+        nextScn = ZERO_SCN;
+        condBufferFull.notify_all();
+        condReaderSleeping.notify_all();
+    }
+
+    bool Reader::prefetchClaim() {
+        std::unique_lock<std::mutex> lck(mtx);
+        while (status == STATUS_CHECK || status == STATUS_UPDATE) {
+            if (ctx->softShutdown)
+                break;
+            if (ctx->trace & Ctx::TRACE_SLEEP)
+                ctx->logTrace(Ctx::TRACE_SLEEP, "Reader:prefetchClaim");
+            condParserSleeping.wait(lck);
+        }
+
+        // Only a file which is being read or was read completely can be used, otherwise it is opened again
+        prefetching = false;
+        prefetched = (status == STATUS_READ && ret == REDO_OK) || (status == STATUS_SLEEPING && ret == REDO_FINISHED);
+        condBufferFull.notify_all();
+        return prefetched;
+    }
+
+    void Reader::prefetchCancel() {
+        std::unique_lock<std::mutex> lck(mtx);
+        prefetching = false;
+        prefetched = false;
+        while (status == STATUS_CHECK || status == STATUS_UPDATE) {
+            if (ctx->softShutdown)
+                return;
+            if (ctx->trace & Ctx::TRACE_SLEEP)
+                ctx->logTrace(Ctx::TRACE_SLEEP, "Reader:prefetchCancel");
+            condParserSleeping.wait(lck);
+        }
+
+        // Stop reading, the header is read again and the read buffers are released
+        if (status == STATUS_READ) {
+            status = STATUS_UPDATE;
+            condBufferFull.notify_all();
+            condReaderSleeping.notify_all();
+            while (status == STATUS_UPDATE) {
+                if (ctx->softShutdown)
+                    return;
+                if (ctx->trace & Ctx::TRACE_SLEEP)
+                    ctx->logTrace(Ctx::TRACE_SLEEP, "Reader:prefetchCancel");
+                condParserSleeping.wait(lck);
+            }
+        }
+
+        for (uint64_t num = 0; num < ctx->readBufferMax; ++num)
+            bufferFree(num);
+    }
+
     void Reader::confirmReadData(uint64_t confirmedBufferStart) {
         std::unique_lock<std::mutex> lck(mtx);
         bufferStart = confirmedBufferStart;
@@ -81,10 +81,25 @@ namespace OpenLogReplicator {
         std::atomic<uint64_t> bufferEnd;
         std::atomic<uint64_t> status;
         std::atomic<uint64_t> ret;
+        std::atomic<bool> prefetching;
+        bool prefetched;
         std::condition_variable condBufferFull;
         std::condition_variable condReaderSleeping;
         std::condition_variable condParserSleeping;
 
+        typedef uint64_t (*XorFoldKernel)(const uint8_t* buffer, uint64_t size);
+        XorFoldKernel xorFoldKernel;
+
+        static uint64_t xorFold(const uint8_t* buffer, uint64_t size);
+#if defined(__x86_64__)
+        static uint64_t xorFoldAvx2(const uint8_t* buffer, uint64_t size);
+        static uint64_t xorFoldAvx512(const uint8_t* buffer, uint64_t size);
+#endif
+#if defined(__aarch64__)
+        static uint64_t xorFoldNeon(const uint8_t* buffer, uint64_t size);
+#endif
+        static XorFoldKernel selectXorFold();
+
         virtual void redoClose() = 0;
         virtual uint64_t redoOpen() = 0;
         virtual int64_t redoRead(uint8_t* buf, uint64_t offset, uint64_t size) = 0;
@@ -92,6 +107,7 @@ namespace OpenLogReplicator {
         virtual uint64_t reloadHeaderRead();
         uint64_t checkBlockHeader(uint8_t* buffer, typeBlk blockNumber, bool showHint);
         uint64_t reloadHeader();
+        [[nodiscard]] bool prefetchAllowed() const;
         bool read1();
         bool read2();
         void mainLoop();
@@ -147,6 +163,9 @@ namespace OpenLogReplicator {
         bool checkRedoLog();
         bool updateRedoLog();
         void setStatusRead();
+        void prefetch();
+        [[nodiscard]] bool prefetchClaim();
+        void prefetchCancel();
         void confirmReadData(uint64_t confirmedBufferStart);
         [[nodiscard]] bool checkFinished(uint64_t confirmedBufferStart);
     };
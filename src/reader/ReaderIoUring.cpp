@@ -0,0 +1,209 @@
+/* Class reading redo log files using io_uring
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#define _LARGEFILE_SOURCE
+#define _FILE_OFFSET_BITS 64
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/uio.h>
+
+#include "../common/Clock.h"
+#include "../common/Ctx.h"
+#include "ReaderIoUring.h"
+
+namespace OpenLogReplicator {
+    ReaderIoUring::ReaderIoUring(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, int64_t newGroup,
+                                 bool newConfiguredBlockSum, uint64_t newQueueDepth) :
+            ReaderFilesystem(newCtx, newAlias, newDatabase, newGroup, newConfiguredBlockSum),
+            queueDepth(newQueueDepth),
+            ringInitialized(false),
+            buffersRegistered(false),
+            segmentResults(newQueueDepth, 0) {
+        memset(reinterpret_cast<void*>(&ring), 0, sizeof(ring));
+    }
+
+    ReaderIoUring::~ReaderIoUring() {
+        ReaderFilesystem::redoClose();
+
+        ringReset();
+    }
+
+    bool ReaderIoUring::ringInit() {
+        int ringRet = io_uring_queue_init(static_cast<unsigned>(queueDepth), &ring, 0);
+        if (ringRet < 0) {
+            ctx->error(10071, "file: " + fileName + " - io_uring_queue_init returned: " + strerror(-ringRet));
+            return false;
+        }
+        ringInitialized = true;
+
+        // Read buffers are registered in place when first used, one slot per read buffer
+        if (io_uring_register_buffers_sparse(&ring, static_cast<unsigned>(ctx->readBufferMax)) == 0) {
+            buffersRegistered = true;
+            registeredBuffers.assign(ctx->readBufferMax, nullptr);
+        } else
+            ctx->warning(60038, "file: " + fileName + " - can't register read buffers for io_uring, using unregistered buffers");
+
+        return true;
+    }
+
+    void ReaderIoUring::ringReset() {
+        // Drops all entries left in the ring, the next read uses a new one
+        if (!ringInitialized)
+            return;
+
+        io_uring_queue_exit(&ring);
+        memset(reinterpret_cast<void*>(&ring), 0, sizeof(ring));
+        ringInitialized = false;
+        buffersRegistered = false;
+        registeredBuffers.clear();
+    }
+
+    uint64_t ReaderIoUring::redoOpen() {
+        uint64_t openRet = ReaderFilesystem::redoOpen();
+        if (openRet != REDO_OK || ringInitialized)
+            return openRet;
+
+        if (!ringInit()) {
+            redoClose();
+            return REDO_ERROR;
+        }
+
+        return REDO_OK;
+    }
+
+    int64_t ReaderIoUring::registeredBuffer(uint8_t* buf, uint64_t offset) {
+        if (!buffersRegistered)
+            return -1;
+
+        // Reads to the read buffers always start at the position of the file offset in the chunk
+        uint64_t redoBufferNum = (offset / Ctx::MEMORY_CHUNK_SIZE) % ctx->readBufferMax;
+        uint8_t* chunk = buf - (offset % Ctx::MEMORY_CHUNK_SIZE);
+        if (redoBufferList == nullptr || redoBufferList[redoBufferNum] != chunk)
+            return -1;
+
+        if (registeredBuffers[redoBufferNum] != chunk) {
+            struct iovec iov;
+            iov.iov_base = chunk;
+            iov.iov_len = Ctx::MEMORY_CHUNK_SIZE;
+            __u64 tag = 0;
+            if (io_uring_register_buffers_update_tag(&ring, static_cast<unsigned>(redoBufferNum), &iov, &tag, 1) < 0)
+                return -1;
+            registeredBuffers[redoBufferNum] = chunk;
+        }
+
+        return static_cast<int64_t>(redoBufferNum);
+    }
+
+    int64_t ReaderIoUring::redoRead(uint8_t* buf, uint64_t offset, uint64_t size) {
+        // Small reads (like the header) don't benefit from splitting
+        if (!ringInitialized || blockSize == 0 || size <= SEGMENT_MIN)
+            return ReaderFilesystem::redoRead(buf, offset, size);
+
+        uint64_t startTime = 0;
+        if (ctx->trace & Ctx::TRACE_PERFORMANCE)
+            startTime = ctx->clock->getTimeUt();
+
+        uint64_t segment = (size + queueDepth - 1) / queueDepth;
+        if (segment < SEGMENT_MIN)
+            segment = SEGMENT_MIN;
+        segment = ((segment + blockSize - 1) / blockSize) * blockSize;
+        uint64_t segments = (size + segment - 1) / segment;
+        int64_t bufIndex = registeredBuffer(buf, offset);
+
+        // Every segment needs a free entry, nothing is queued unless all fit
+        if (io_uring_sq_space_left(&ring) < segments)
+            return ReaderFilesystem::redoRead(buf, offset, size);
+
+        for (uint64_t i = 0; i < segments; ++i) {
+            struct io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+            if (sqe == nullptr) {
+                ringReset();
+                return ReaderFilesystem::redoRead(buf, offset, size);
+            }
+
+            uint64_t segmentSize = (i == segments - 1) ? size - i * segment : segment;
+            if (bufIndex >= 0)
+                io_uring_prep_read_fixed(sqe, fileDes, buf + i * segment, static_cast<unsigned>(segmentSize),
+                                         static_cast<__u64>(offset + i * segment), static_cast<int>(bufIndex));
+            else
+                io_uring_prep_read(sqe, fileDes, buf + i * segment, static_cast<unsigned>(segmentSize),
+                                   static_cast<__u64>(offset + i * segment));
+            io_uring_sqe_set_data64(sqe, i);
+        }
+
+        int submitted = io_uring_submit(&ring);
+        if (submitted < 0) {
+            ctx->error(10071, "file: " + fileName + " - io_uring_submit returned: " + strerror(-submitted));
+            ringReset();
+            return ReaderFilesystem::redoRead(buf, offset, size);
+        }
+
+        // Reap all submitted entries, so that nothing is left for the next read
+        std::fill(segmentResults.begin(), segmentResults.begin() + static_cast<int64_t>(segments), 0);
+        int reaped = 0;
+        while (reaped < submitted) {
+            struct io_uring_cqe* cqe;
+            int waitRet = io_uring_wait_cqe(&ring, &cqe);
+            if (waitRet == -EINTR)
+                continue;
+            if (waitRet < 0) {
+                ctx->error(10071, "file: " + fileName + " - io_uring_wait_cqe returned: " + strerror(-waitRet));
+                ringReset();
+                return ReaderFilesystem::redoRead(buf, offset, size);
+            }
+
+            uint64_t segmentNum = io_uring_cqe_get_data64(cqe);
+            if (segmentNum < segments)
+                segmentResults[segmentNum] = cqe->res;
+            io_uring_cqe_seen(&ring, cqe);
+            ++reaped;
+        }
+
+        // Not submitted entries would stay in the ring
+        if (static_cast<uint64_t>(submitted) != segments) {
+            ringReset();
+            return ReaderFilesystem::redoRead(buf, offset, size);
+        }
+
+        int64_t bytes = 0;
+        for (uint64_t i = 0; i < segments; ++i) {
+            uint64_t segmentSize = (i == segments - 1) ? size - i * segment : segment;
+            if (ctx->trace & Ctx::TRACE_FILE)
+                ctx->logTrace(Ctx::TRACE_FILE, "read " + fileName + ", " + std::to_string(offset + i * segment) + ", " +
+                                               std::to_string(segmentSize) + " returns " + std::to_string(segmentResults[i]));
+            if (segmentResults[i] > 0)
+                bytes += segmentResults[i];
+            if (segmentResults[i] < static_cast<int64_t>(segmentSize))
+                break;
+        }
+
+        // Errors and retries are handled by the synchronous read
+        if (bytes == 0 && segmentResults[0] < 0)
+            return ReaderFilesystem::redoRead(buf, offset, size);
+
+        if (ctx->trace & Ctx::TRACE_PERFORMANCE) {
+            sumRead += bytes;
+            sumTime += ctx->clock->getTimeUt() - startTime;
+        }
+
+        return bytes;
+    }
+}
@@ -0,0 +1,54 @@
+/* Header for ReaderIoUring class
+   Copyright (C) 2018-2024 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <liburing.h>
+#include <vector>
+
+#include "ReaderFilesystem.h"
+
+#ifndef READER_IO_URING_H_
+#define READER_IO_URING_H_
+
+namespace OpenLogReplicator {
+    class ReaderIoUring final : public ReaderFilesystem {
+    protected:
+        static constexpr uint64_t SEGMENT_MIN = 64 * 1024;
+
+        struct io_uring ring;
+        uint64_t queueDepth;
+        bool ringInitialized;
+        bool buffersRegistered;
+        std::vector<uint8_t*> registeredBuffers;
+        // Results of the segments of one read, at most one segment per queue entry
+        std::vector<int64_t> segmentResults;
+
+        bool ringInit();
+        void ringReset();
+        uint64_t redoOpen() override;
+        int64_t redoRead(uint8_t* buf, uint64_t offset, uint64_t size) override;
+        int64_t registeredBuffer(uint8_t* buf, uint64_t offset);
+
+    public:
+        ReaderIoUring(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, int64_t newGroup, bool newConfiguredBlockSum,
+                      uint64_t newQueueDepth);
+        ~ReaderIoUring() override;
+    };
+}
+
+#endif
@@ -37,6 +37,9 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "../parser/Transaction.h"
 #include "../parser/TransactionBuffer.h"
 #include "../reader/ReaderFilesystem.h"
+#ifdef LINK_LIBRARY_URING
+#include "../reader/ReaderIoUring.h"
+#endif /* LINK_LIBRARY_URING */
 #include "Replicator.h"
 
 namespace OpenLogReplicator {
@@ -47,8 +50,10 @@ namespace OpenLogReplicator {
             builder(newBuilder),
             metadata(newMetadata),
             transactionBuffer(newTransactionBuffer),
+            parserPool(nullptr),
             database(newDatabase),
-            archReader(nullptr) {
+            archReader(nullptr),
+            archReadersPrefetch(0) {
     }
 
     Replicator::~Replicator() {
@@ -114,6 +119,9 @@ namespace OpenLogReplicator {
         }
 
         archReader = nullptr;
+        archPrefetched.clear();
+        archReadersIdle.clear();
+        archReadersPrefetch = 0;
         readers.clear();
     }
 
@@ -269,7 +277,9 @@ namespace OpenLogReplicator {
 
         ctx->info(0, "Oracle replicator for: " + database + " is shutting down");
 
-        ctx->replicatorFinished = true;
+        // With many sources the writers finish when all replicators are done
+        if (--ctx->replicatorsRunning == 0)
+            ctx->replicatorFinished = true;
         ctx->info(0, "Oracle replicator for: " + database + " allocated at most " + std::to_string(ctx->getMaxUsedMemory()) +
                      "MB memory, max disk read buffer: " + std::to_string(ctx->buffersMaxUsed * Ctx::MEMORY_CHUNK_SIZE_MB) + "MB");
 
@@ -285,8 +295,18 @@ namespace OpenLogReplicator {
             if (reader->getGroup() == group)
                 return reader;
 
-        auto readerFS = new ReaderFilesystem(ctx, alias + "-reader-" + std::to_string(group), database, group,
-                                             metadata->dbBlockChecksum != "OFF" && metadata->dbBlockChecksum != "FALSE");
+        return readerSpawn(group, alias + "-reader-" + std::to_string(group));
+    }
+
+    Reader* Replicator::readerSpawn(int64_t group, const std::string& name) {
+        ReaderFilesystem* readerFS;
+#ifdef LINK_LIBRARY_URING
+        if (ctx->redoReadQueueDepth > 0)
+            readerFS = new ReaderIoUring(ctx, name, database, group, metadata->dbBlockChecksum != "OFF" && metadata->dbBlockChecksum != "FALSE",
+                                         ctx->redoReadQueueDepth);
+        else
+#endif /* LINK_LIBRARY_URING */
+            readerFS = new ReaderFilesystem(ctx, name, database, group, metadata->dbBlockChecksum != "OFF" && metadata->dbBlockChecksum != "FALSE");
         readers.insert(readerFS);
         readerFS->initialize();
 
@@ -313,6 +333,7 @@ namespace OpenLogReplicator {
                                              reader->getGroup(), reader->fileName);
 
                     parser->reader = reader;
+                    parser->pool = parserPool;
                     ctx->info(0, "online redo log: " + reader->fileName);
                     onlineRedoSet.insert(parser);
                     break;
@@ -521,6 +542,7 @@ namespace OpenLogReplicator {
                 auto parser = new Parser(replicator->ctx, replicator->builder, replicator->metadata,
                                          replicator->transactionBuffer, 0, fileName);
 
+                parser->pool = replicator->parserPool;
                 parser->firstScn = ZERO_SCN;
                 parser->nextScn = ZERO_SCN;
                 parser->sequence = sequence;
@@ -575,6 +597,7 @@ namespace OpenLogReplicator {
 
                 auto parser = new Parser(replicator->ctx, replicator->builder, replicator->metadata,
                                          replicator->transactionBuffer, 0, mappedPath);
+                parser->pool = replicator->parserPool;
                 parser->firstScn = ZERO_SCN;
                 parser->nextScn = ZERO_SCN;
                 parser->sequence = sequence;
@@ -607,6 +630,7 @@ namespace OpenLogReplicator {
 
                     auto parser = new Parser(replicator->ctx, replicator->builder, replicator->metadata,
                                              replicator->transactionBuffer, 0, fileName);
+                    parser->pool = replicator->parserPool;
                     parser->firstScn = ZERO_SCN;
                     parser->nextScn = ZERO_SCN;
                     parser->sequence = sequence;
@@ -736,12 +760,13 @@ namespace OpenLogReplicator {
                 }
 
                 logsProcessed = true;
+                bool prefetched = archPrefetchClaim(parser);
                 parser->reader = archReader;
 
                 archReader->fileName = parser->path;
                 uint64_t retry = ctx->archReadTries;
 
-                while (true) {
+                while (!prefetched) {
                     if (archReader->checkRedoLog() && archReader->updateRedoLog()) {
                         break;
                     }
@@ -756,6 +781,7 @@ namespace OpenLogReplicator {
                     --retry;
                 }
 
+                archPrefetchStart(parser);
                 ret = parser->parse();
                 metadata->firstScn = parser->firstScn;
                 metadata->nextScn = parser->nextScn;
@@ -792,9 +818,83 @@ namespace OpenLogReplicator {
                 break;
         }
 
+        archPrefetchCancel();
         return logsProcessed;
     }
 
+    bool Replicator::archPrefetchClaim(Parser* parser) {
+        auto archPrefetchedIt = archPrefetched.find(parser->sequence);
+        if (archPrefetchedIt == archPrefetched.end())
+            return false;
+
+        Reader* reader = archPrefetchedIt->second;
+        archPrefetched.erase(archPrefetchedIt);
+
+        // Prefetch always starts at the beginning of the file
+        if (reader->fileName != parser->path || metadata->offset != 0) {
+            reader->prefetchCancel();
+            archReadersIdle.push_back(reader);
+            return false;
+        }
+
+        if (ctx->trace & Ctx::TRACE_REDO)
+            ctx->logTrace(Ctx::TRACE_REDO, "using prefetched archived redo log: " + parser->path);
+        archReadersIdle.push_back(archReader);
+        archReader = reader;
+        return archReader->prefetchClaim();
+    }
+
+    void Replicator::archPrefetchStart(Parser* parser) {
+        if (ctx->archPrefetch == 0 || archiveRedoQueue.size() < 2)
+            return;
+
+        // Find the following archived redo logs, the current one is on top of the queue
+        std::vector<Parser*> nextParsers;
+        archiveRedoQueue.pop();
+        while (!archiveRedoQueue.empty() && nextParsers.size() < ctx->archPrefetch &&
+               archiveRedoQueue.top()->sequence == parser->sequence + nextParsers.size() + 1) {
+            nextParsers.push_back(archiveRedoQueue.top());
+            archiveRedoQueue.pop();
+        }
+        archiveRedoQueue.push(parser);
+        for (Parser* nextParser: nextParsers)
+            archiveRedoQueue.push(nextParser);
+
+        for (Parser* nextParser: nextParsers) {
+            auto archPrefetchedIt = archPrefetched.find(nextParser->sequence);
+            if (archPrefetchedIt != archPrefetched.end()) {
+                if (archPrefetchedIt->second->fileName == nextParser->path)
+                    continue;
+                archPrefetchedIt->second->prefetchCancel();
+                archReadersIdle.push_back(archPrefetchedIt->second);
+                archPrefetched.erase(archPrefetchedIt);
+            }
+
+            Reader* reader;
+            if (!archReadersIdle.empty()) {
+                reader = archReadersIdle.back();
+                archReadersIdle.pop_back();
+            } else {
+                reader = readerSpawn(0, alias + "-reader-0-prefetch-" + std::to_string(archReadersPrefetch));
+                ++archReadersPrefetch;
+            }
+
+            if (ctx->trace & Ctx::TRACE_REDO)
+                ctx->logTrace(Ctx::TRACE_REDO, "prefetching archived redo log: " + nextParser->path);
+            reader->fileName = nextParser->path;
+            reader->prefetch();
+            archPrefetched.insert_or_assign(nextParser->sequence, reader);
+        }
+    }
+
+    void Replicator::archPrefetchCancel() {
+        for (auto archPrefetchedIt: archPrefetched) {
+            archPrefetchedIt.second->prefetchCancel();
+            archReadersIdle.push_back(archPrefetchedIt.second);
+        }
+        archPrefetched.clear();
+    }
+
     bool Replicator::processOnlineRedoLogs() {
         Parser* parser;
         bool logsProcessed = false;
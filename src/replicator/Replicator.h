@@ -18,6 +18,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
 #include <fstream>
+#include <map>
 #include <queue>
 #include <set>
 #include <unordered_map>
@@ -33,6 +34,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     class Parser;
+    class ParserPool;
     class Builder;
     class Metadata;
     class Reader;
@@ -51,10 +53,14 @@ namespace OpenLogReplicator {
         Builder* builder;
         Metadata* metadata;
         TransactionBuffer* transactionBuffer;
+        ParserPool* parserPool;
         std::string database;
         std::string redoCopyPath;
         // Redo log files
         Reader* archReader;
+        std::map<typeSeq, Reader*> archPrefetched;
+        std::vector<Reader*> archReadersIdle;
+        uint64_t archReadersPrefetch;
         std::string lastCheckedDay;
         std::priority_queue<Parser*, std::vector<Parser*>, parserCompare> archiveRedoQueue;
         std::set<Parser*> onlineRedoSet;
@@ -65,6 +71,10 @@ namespace OpenLogReplicator {
         void cleanArchList();
         void updateOnlineLogs();
         void readerDropAll(void);
+        Reader* readerSpawn(int64_t group, const std::string& name);
+        bool archPrefetchClaim(Parser* parser);
+        void archPrefetchStart(Parser* parser);
+        void archPrefetchCancel();
         static uint64_t getSequenceFromFileName(Replicator* replicator, const std::string& file);
         virtual const char* getModeName() const;
         virtual bool checkConnection();
@@ -966,8 +966,7 @@ namespace OpenLogReplicator {
             readSystemDictionariesMetadata(metadata->schema, metadata->firstDataScn);
 
             for (const SchemaElement* element: metadata->schemaElements)
-                createSchemaForTable(metadata->firstDataScn, element->owner, element->table, element->keys, element->keysStr, element->conditionStr,
-                                     element->options, msgs);
+                createSchemaForTable(metadata->firstDataScn, element, msgs);
             metadata->schema->resetTouched();
 
             if (metadata->ctx->trace & Ctx::TRACE_CHECKPOINT)
@@ -1827,17 +1826,14 @@ namespace OpenLogReplicator {
         }
     }
 
-    void ReplicatorOnline::createSchemaForTable(typeScn targetScn, const std::string& owner, const std::string& table, const std::vector<std::string>& keys,
-                                                const std::string& keysStr, const std::string& conditionStr, typeOptions options,
-                                                std::vector<std::string>& msgs) {
+    void ReplicatorOnline::createSchemaForTable(typeScn targetScn, const SchemaElement* element, std::vector<std::string>& msgs) {
         if (ctx->trace & Ctx::TRACE_REDO)
-            ctx->logTrace(Ctx::TRACE_REDO, "creating table schema for owner: " + owner + " table: " + table + " options: " +
-                                           std::to_string(static_cast<uint64_t>(options)));
+            ctx->logTrace(Ctx::TRACE_REDO, "creating table schema for owner: " + element->owner + " table: " + element->table + " options: " +
+                                           std::to_string(static_cast<uint64_t>(element->options)));
 
-        readSystemDictionaries(metadata->schema, targetScn, owner, table, options);
+        readSystemDictionaries(metadata->schema, targetScn, element->owner, element->table, element->options);
 
-        metadata->schema->buildMaps(owner, table, keys, keysStr, conditionStr, options, msgs, metadata->suppLogDbPrimary,
-                                    metadata->suppLogDbAll, metadata->defaultCharacterMapId,
+        metadata->schema->buildMaps(element, msgs, metadata->suppLogDbPrimary, metadata->suppLogDbAll, metadata->defaultCharacterMapId,
                                     metadata->defaultCharacterNcharMapId);
     }
 
@@ -1998,6 +1994,7 @@ namespace OpenLogReplicator {
 
                 auto parser = new Parser(replicator->ctx, replicator->builder, replicator->metadata,
                                          replicator->transactionBuffer, 0, mappedPath);
+                parser->pool = replicator->parserPool;
                 parser->firstScn = firstScn;
                 parser->nextScn = nextScn;
                 parser->sequence = sequence;
@@ -39,7 +39,7 @@ namespace OpenLogReplicator {
 
         virtual void list(std::set<std::string>& namesList) = 0;
         [[nodiscard]] virtual bool read(const std::string& name, uint64_t maxSize, std::string& in) = 0;
-        virtual void write(const std::string& name, typeScn scn, const std::ostringstream& out) = 0;
+        virtual void write(const std::string& name, typeScn scn, const std::ostringstream& out, bool binary) = 0;
         virtual void drop(const std::string& name) = 0;
     };
 }
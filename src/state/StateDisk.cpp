@@ -59,9 +59,12 @@ namespace OpenLogReplicator {
             if (S_ISDIR(fileStat.st_mode))
                 continue;
 
-            std::string suffix(".json");
-            if (fileName.length() < suffix.length() || fileName.substr(fileName.length() - suffix.length(), fileName.length()) != suffix)
-                continue;
+            std::string suffix(SUFFIX_JSON);
+            if (fileName.length() < suffix.length() || fileName.substr(fileName.length() - suffix.length(), fileName.length()) != suffix) {
+                suffix = SUFFIX_BINARY;
+                if (fileName.length() < suffix.length() || fileName.substr(fileName.length() - suffix.length(), fileName.length()) != suffix)
+                    continue;
+            }
 
             std::string fileBase(fileName.substr(0, fileName.length() - suffix.length()));
             namesList.insert(fileBase);
@@ -70,17 +73,22 @@ namespace OpenLogReplicator {
     }
 
     bool StateDisk::read(const std::string& name, uint64_t maxSize, std::string& in) {
-        std::string fileName(path + "/" + name + ".json");
+        std::string fileName(path + "/" + name + SUFFIX_JSON);
         struct stat fileStat;
         if (stat(fileName.c_str(), &fileStat) != 0) {
-            ctx->warning(60034, "file: " + fileName + " - stat returned: " + strerror(errno));
-            return false;
+            int errnoJson = errno;
+            std::string fileNameBinary(path + "/" + name + SUFFIX_BINARY);
+            if (errnoJson != ENOENT || stat(fileNameBinary.c_str(), &fileStat) != 0) {
+                ctx->warning(60034, "file: " + fileName + " - stat returned: " + strerror(errnoJson));
+                return false;
+            }
+            fileName = fileNameBinary;
         }
         if (static_cast<uint64_t>(fileStat.st_size) > maxSize || fileStat.st_size == 0)
             throw RuntimeException(10004, "file: " + fileName + " - wrong size: " + std::to_string(fileStat.st_size));
 
         std::ifstream inputStream;
-        inputStream.open(fileName.c_str(), std::ios::in);
+        inputStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
 
         if (!inputStream.is_open())
             throw RuntimeException(10001, "file: " + fileName + " - open returned: " + strerror(errno));
@@ -90,11 +98,11 @@ namespace OpenLogReplicator {
         return true;
     }
 
-    void StateDisk::write(const std::string& name, typeScn scn __attribute__((unused)), const std::ostringstream& out) {
-        std::string fileName(path + "/" + name + ".json");
+    void StateDisk::write(const std::string& name, typeScn scn __attribute__((unused)), const std::ostringstream& out, bool binary) {
+        std::string fileName(path + "/" + name + (binary ? SUFFIX_BINARY : SUFFIX_JSON));
         std::ofstream outputStream;
 
-        outputStream.open(fileName.c_str(), std::ios::out | std::ios::trunc);
+        outputStream.open(fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
         if (!outputStream.is_open())
             throw RuntimeException(10006, "file: " + fileName + " - open for write returned: " + strerror(errno));
 
@@ -107,8 +115,14 @@ namespace OpenLogReplicator {
     }
 
     void StateDisk::drop(const std::string& name) {
-        std::string fileName(path + "/" + name + ".json");
-        if (unlink(fileName.c_str()) != 0)
-            throw RuntimeException(10010, "file: " + fileName + " - unlink returned: " + strerror(errno));
+        std::string fileName(path + "/" + name + SUFFIX_JSON);
+        if (unlink(fileName.c_str()) != 0) {
+            if (errno != ENOENT)
+                throw RuntimeException(10010, "file: " + fileName + " - unlink returned: " + strerror(errno));
+
+            fileName = path + "/" + name + SUFFIX_BINARY;
+            if (unlink(fileName.c_str()) != 0)
+                throw RuntimeException(10010, "file: " + fileName + " - unlink returned: " + strerror(errno));
+        }
     }
 }
@@ -25,6 +25,9 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 namespace OpenLogReplicator {
     class StateDisk final : public State {
     protected:
+        static constexpr const char* SUFFIX_JSON = ".json";
+        static constexpr const char* SUFFIX_BINARY = ".bin";
+
         std::string path;
 
     public:
@@ -33,7 +36,7 @@ namespace OpenLogReplicator {
 
         void list(std::set<std::string>& namesList) override;
         [[nodiscard]] bool read(const std::string& name, uint64_t maxSize, std::string& in) override;
-        void write(const std::string& name, typeScn scn, const std::ostringstream& out) override;
+        void write(const std::string& name, typeScn scn, const std::ostringstream& out, bool binary) override;
         void drop(const std::string& name) override;
     };
 }
@@ -27,4 +27,21 @@ namespace OpenLogReplicator {
     }
 
     Stream::~Stream() = default;
+
+    // Message memory must stay untouched until confirmed by the client, the default implementation sends it right away
+    void Stream::queueMessage(const void* msg, uint64_t length) {
+        sendMessage(msg, length);
+    }
+
+    // Returns the time in microseconds left before the queued messages are sent, 0 when nothing is waiting
+    uint64_t Stream::flushPending() {
+        return 0;
+    }
+
+    void Stream::flush() {
+    }
+
+    // Drops queued messages which were not sent yet, their memory is about to be released
+    void Stream::discard() {
+    }
 }
@@ -40,6 +40,10 @@ namespace OpenLogReplicator {
         virtual void initializeClient() = 0;
         virtual void initializeServer() = 0;
         virtual void sendMessage(const void* msg, uint64_t length) = 0;
+        virtual void queueMessage(const void* msg, uint64_t length);
+        virtual uint64_t flushPending();
+        virtual void flush();
+        virtual void discard();
         virtual uint64_t receiveMessage(void* msg, uint64_t length) = 0;
         virtual uint64_t receiveMessageNB(void* msg, uint64_t length) = 0;
         [[nodiscard]] virtual bool isConnected() = 0;
@@ -20,9 +20,15 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <cerrno>
 #include <cstring>
 #include <fcntl.h>
+#include <linux/errqueue.h>
 #include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/select.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
+#include "../common/Clock.h"
 #include "../common/Ctx.h"
 #include "../common/exception/ConfigurationException.h"
 #include "../common/exception/NetworkException.h"
@@ -35,8 +41,23 @@ namespace OpenLogReplicator {
             socketFD(-1),
             serverFD(-1),
             readBufferLen(0),
-            res(nullptr) {
+            res(nullptr),
+            batchBytes(DEFAULT_BATCH_BYTES),
+            lingerUs(0),
+            zeroCopyBytes(0),
+            zeroCopy(false),
+            batchZeroCopy(false),
+            batchMessages(0),
+            batchIovFirst(0),
+            batchIovCount(0),
+            batchLength(0),
+            batchTime(0),
+            zeroCopySent(0),
+            zeroCopyDone(0),
+            batchSet(0) {
         readBuffer[0] = 0;
+        batchSetSent[0] = 0;
+        batchSetSent[1] = 0;
     }
 
     StreamNetwork::~StreamNetwork() {
@@ -125,109 +146,233 @@ namespace OpenLogReplicator {
         }
     }
 
-    void StreamNetwork::sendMessage(const void* msg, uint64_t length) {
-        uint32_t length32 = length;
-        uint64_t sent = 0;
+    void StreamNetwork::setBatch(uint64_t newBatchBytes, uint64_t newLingerUs, uint64_t newZeroCopyBytes) {
+        batchBytes = newBatchBytes;
+        lingerUs = newLingerUs;
+        zeroCopyBytes = newZeroCopyBytes;
+    }
 
+    void StreamNetwork::resetBatch() {
+        batchZeroCopy = false;
+        batchMessages = 0;
+        batchIovFirst = 0;
+        batchIovCount = 0;
+        batchLength = 0;
+    }
+
+    void StreamNetwork::closeSocket() {
+        close(socketFD);
+        socketFD = -1;
+        resetBatch();
+    }
+
+    void StreamNetwork::addMessage(const void* msg, uint64_t length) {
         if (socketFD == -1)
             throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno) + " (10)");
 
-        fd_set wset;
-        fd_set w;
-        FD_ZERO(&wset);
-        FD_SET(socketFD, &wset);
+        // The headers of the set might be still used by a zero-copy send
+        if (batchMessages == 0)
+            waitZeroCopy(batchSetSent[batchSet]);
 
         // Header content
+        uint8_t* header = batchHeader[batchSet][batchMessages];
+        uint64_t headerLength;
         if (length < 0xFFFFFFFF) {
             // 32-bit length
-            while (sent < sizeof(uint32_t)) {
-                if (ctx->softShutdown)
-                    return;
-
-                w = wset;
-                // Blocking select
-                select(socketFD + 1, nullptr, &w, nullptr, nullptr);
-                ssize_t r = write(socketFD, (reinterpret_cast<uint8_t*>(&length32)) + sent, sizeof(uint32_t) - sent);
-                if (r <= 0) {
-                    if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
-                        r = 0;
-                    else {
-                        close(socketFD);
-                        socketFD = -1;
-                        throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " +
-                                                      strerror(errno) + " (11)");
-                    }
-                }
-                sent += r;
-            }
+            uint32_t length32 = length;
+            memcpy(reinterpret_cast<void*>(header), reinterpret_cast<const void*>(&length32), sizeof(uint32_t));
+            headerLength = sizeof(uint32_t);
         } else {
             // 64-bit length
-            length32 = 0xFFFFFFFF;
-            while (sent < sizeof(uint32_t)) {
-                if (ctx->softShutdown)
-                    return;
-
-                w = wset;
-                // Blocking select
-                select(socketFD + 1, nullptr, &w, nullptr, nullptr);
-                ssize_t r = write(socketFD, (reinterpret_cast<uint8_t*>(&length32)) + sent, sizeof(uint32_t) - sent);
-                if (r <= 0) {
-                    if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
-                        r = 0;
-                    else {
-                        close(socketFD);
-                        socketFD = -1;
-                        throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " +
-                                                      strerror(errno) + " (12)");
-                    }
-                }
-                sent += r;
-            }
-
-            sent = 0;
-            while (sent < sizeof(uint64_t)) {
-                if (ctx->softShutdown)
-                    return;
-
-                w = wset;
-                // Blocking select
-                select(socketFD + 1, nullptr, &w, nullptr, nullptr);
-                ssize_t r = write(socketFD, (reinterpret_cast<uint8_t*>(&length)) + sent, sizeof(uint64_t) - sent);
-                if (r <= 0) {
-                    if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
-                        r = 0;
-                    else {
-                        close(socketFD);
-                        socketFD = -1;
-                        throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " +
-                                                      strerror(errno) + " (13)");
-                    }
-                }
-                sent += r;
-            }
+            uint32_t length32 = 0xFFFFFFFF;
+            memcpy(reinterpret_cast<void*>(header), reinterpret_cast<const void*>(&length32), sizeof(uint32_t));
+            memcpy(reinterpret_cast<void*>(header + sizeof(uint32_t)), reinterpret_cast<const void*>(&length), sizeof(uint64_t));
+            headerLength = HEADER_SIZE;
         }
 
-        sent = 0;
+        if (batchMessages == 0)
+            batchTime = ctx->clock->getTimeUt();
+
+        batchIov[batchIovCount].iov_base = header;
+        batchIov[batchIovCount].iov_len = headerLength;
+        ++batchIovCount;
+
         // Message content
-        while (sent < length) {
-            if (ctx->softShutdown)
+        if (length > 0) {
+            batchIov[batchIovCount].iov_base = const_cast<void*>(msg);
+            batchIov[batchIovCount].iov_len = length;
+            ++batchIovCount;
+        }
+
+        batchLength += headerLength + length;
+        ++batchMessages;
+    }
+
+    void StreamNetwork::sendMessage(const void* msg, uint64_t length) {
+        // The buffer belongs to the caller, send it right away and without zero-copy
+        flush();
+        if (ctx->softShutdown)
+            return;
+
+        addMessage(msg, length);
+        sendBatch(false);
+    }
+
+    void StreamNetwork::queueMessage(const void* msg, uint64_t length) {
+        addMessage(msg, length);
+        if (zeroCopy && length >= zeroCopyBytes)
+            batchZeroCopy = true;
+
+        if (batchMessages == BATCH_MESSAGES || batchLength >= batchBytes)
+            flush();
+    }
+
+    uint64_t StreamNetwork::flushPending() {
+        if (batchMessages == 0)
+            return 0;
+
+        // Coalescing window, wait for more messages to send them together
+        uint64_t waitedUs = ctx->clock->getTimeUt() - batchTime;
+        if (waitedUs < lingerUs)
+            return lingerUs - waitedUs;
+
+        flush();
+        return 0;
+    }
+
+    void StreamNetwork::discard() {
+        // Zero-copy sends may still read the memory of messages which are about to be released
+        if (socketFD != -1)
+            waitZeroCopy(zeroCopySent);
+        resetBatch();
+    }
+
+    void StreamNetwork::flush() {
+        if (batchMessages == 0)
+            return;
+
+        // The client is gone, it would request the messages again after reconnecting
+        if (socketFD == -1) {
+            resetBatch();
+            return;
+        }
+
+        sendBatch(batchZeroCopy);
+    }
+
+    void StreamNetwork::sendBatch(bool useZeroCopy) {
+        fd_set wset;
+        fd_set w;
+        FD_ZERO(&wset);
+        FD_SET(socketFD, &wset);
+
+        int flags = MSG_NOSIGNAL;
+#ifdef MSG_ZEROCOPY
+        if (useZeroCopy)
+            flags |= MSG_ZEROCOPY;
+#endif
+
+        // Data queued before a soft shutdown is still sent, only a hard shutdown abandons it
+        while (batchIovFirst < batchIovCount) {
+            if (ctx->hardShutdown)
                 return;
 
             w = wset;
-            // Blocking select
-            select(socketFD + 1, nullptr, &w, nullptr, nullptr);
-            ssize_t r = write(socketFD, reinterpret_cast<const char*>(msg) + sent, length - sent);
+            struct timeval tv = {0, SELECT_TIMEOUT_US};
+            if (select(socketFD + 1, nullptr, &w, nullptr, &tv) == 0)
+                continue;
+
+            struct msghdr header;
+            memset(reinterpret_cast<void*>(&header), 0, sizeof(header));
+            header.msg_iov = batchIov + batchIovFirst;
+            header.msg_iovlen = batchIovCount - batchIovFirst;
+            ssize_t r = sendmsg(socketFD, &header, flags);
+#ifdef MSG_ZEROCOPY
+            if (r > 0 && (flags & MSG_ZEROCOPY) != 0) {
+                ++zeroCopySent;
+                batchSetSent[batchSet] = zeroCopySent;
+            }
+#endif
             if (r <= 0) {
                 if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
-                    r = 0;
-                else {
-                    close(socketFD);
-                    socketFD = -1;
-                    throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " +
-                                                  strerror(errno) + " (14)");
+                    continue;
+
+#ifdef MSG_ZEROCOPY
+                // No socket memory left for zero-copy, send the rest of the batch with a copy
+                if (r < 0 && errno == ENOBUFS && (flags & MSG_ZEROCOPY) != 0) {
+                    reapZeroCopy();
+                    flags &= ~MSG_ZEROCOPY;
+                    continue;
                 }
+#endif
+
+                closeSocket();
+                throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno) + " (11)");
+            }
+
+            // Skip the part which was sent
+            uint64_t sent = r;
+            while (sent > 0) {
+                if (sent >= batchIov[batchIovFirst].iov_len) {
+                    sent -= batchIov[batchIovFirst].iov_len;
+                    ++batchIovFirst;
+                } else {
+                    batchIov[batchIovFirst].iov_base = reinterpret_cast<uint8_t*>(batchIov[batchIovFirst].iov_base) + sent;
+                    batchIov[batchIovFirst].iov_len -= sent;
+                    sent = 0;
+                }
+            }
+        }
+
+        if (zeroCopy) {
+            reapZeroCopy();
+            if (static_cast<int32_t>(batchSetSent[batchSet] - zeroCopyDone) > 0)
+                batchSet ^= 1;
+        }
+        resetBatch();
+    }
+
+    void StreamNetwork::reapZeroCopy() {
+#ifdef MSG_ZEROCOPY
+        uint8_t control[256];
+        struct msghdr header;
+        while (true) {
+            memset(reinterpret_cast<void*>(&header), 0, sizeof(header));
+            header.msg_control = control;
+            header.msg_controllen = sizeof(control);
+            if (recvmsg(socketFD, &header, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+                break;
+
+            for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+                if ((cmsg->cmsg_level != SOL_IP || cmsg->cmsg_type != IP_RECVERR) &&
+                    (cmsg->cmsg_level != SOL_IPV6 || cmsg->cmsg_type != IPV6_RECVERR))
+                    continue;
+
+                struct sock_extended_err err;
+                memcpy(reinterpret_cast<void*>(&err), reinterpret_cast<const void*>(CMSG_DATA(cmsg)), sizeof(err));
+                if (err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                    continue;
+
+                // Range of finished sends, the counter may wrap around
+                if (static_cast<int32_t>(err.ee_data + 1 - zeroCopyDone) > 0)
+                    zeroCopyDone = err.ee_data + 1;
             }
-            sent += r;
+        }
+#endif
+    }
+
+    void StreamNetwork::waitZeroCopy(uint32_t sent) {
+        while (static_cast<int32_t>(sent - zeroCopyDone) > 0 && socketFD != -1 && !ctx->hardShutdown) {
+            reapZeroCopy();
+            if (static_cast<int32_t>(sent - zeroCopyDone) <= 0)
+                break;
+
+            // The notifications are reported as an error condition
+            struct pollfd pfd;
+            pfd.fd = socketFD;
+            pfd.events = 0;
+            pfd.revents = 0;
+            poll(&pfd, 1, 1);
         }
     }
 
@@ -428,6 +573,26 @@ namespace OpenLogReplicator {
         if (fcntl(socketFD, F_SETFL, flags | O_NONBLOCK) < 0)
             throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno) + " (20)");
 
+        // A new client, messages queued for the previous one are sent again after the client requests them
+        resetBatch();
+        zeroCopy = false;
+        zeroCopySent = 0;
+        zeroCopyDone = 0;
+        batchSet = 0;
+        batchSetSent[0] = 0;
+        batchSetSent[1] = 0;
+        if (zeroCopyBytes > 0) {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+            int opt = 1;
+            if (setsockopt(socketFD, SOL_SOCKET, SO_ZEROCOPY, &opt, sizeof(opt)) == 0)
+                zeroCopy = true;
+            else
+                ctx->warning(60041, "can't use zero-copy send - setsockopt returned: " + std::string(strerror(errno)));
+#else
+            ctx->warning(60041, "can't use zero-copy send - setsockopt returned: " + std::string(strerror(ENOTSUP)));
+#endif
+        }
+
         if (socketFD != -1)
             return true;
 
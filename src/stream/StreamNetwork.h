@@ -18,6 +18,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
 #include <netinet/in.h>
+#include <sys/uio.h>
 
 #include "Stream.h"
 
@@ -26,6 +27,12 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     class StreamNetwork final : public Stream {
+    public:
+        static constexpr uint64_t BATCH_MESSAGES = 512;
+        static constexpr uint64_t DEFAULT_BATCH_BYTES = 256 * 1024;
+        static constexpr uint64_t HEADER_SIZE = sizeof(uint32_t) + sizeof(uint64_t);
+        static constexpr int64_t SELECT_TIMEOUT_US = 100000;
+
     protected:
         int socketFD;
         int serverFD;
@@ -36,6 +43,32 @@ namespace OpenLogReplicator {
         uint64_t readBufferLen;
         struct addrinfo* res;
 
+        // Messages waiting to be sent with one sendmsg call, the payload is referenced directly
+        uint64_t batchBytes;
+        uint64_t lingerUs;
+        uint64_t zeroCopyBytes;
+        bool zeroCopy;
+        bool batchZeroCopy;
+        uint64_t batchMessages;
+        uint64_t batchIovFirst;
+        uint64_t batchIovCount;
+        uint64_t batchLength;
+        time_ut batchTime;
+        // Zero-copy sends keep referencing the headers, two sets are used in turns
+        uint32_t zeroCopySent;
+        uint32_t zeroCopyDone;
+        uint64_t batchSet;
+        uint32_t batchSetSent[2];
+        uint8_t batchHeader[2][BATCH_MESSAGES][HEADER_SIZE];
+        struct iovec batchIov[BATCH_MESSAGES * 2];
+
+        void addMessage(const void* msg, uint64_t length);
+        void sendBatch(bool useZeroCopy);
+        void reapZeroCopy();
+        void waitZeroCopy(uint32_t sent);
+        void resetBatch();
+        void closeSocket();
+
     public:
         StreamNetwork(Ctx* newCtx, const char* newUri);
         ~StreamNetwork() override;
@@ -44,7 +77,12 @@ namespace OpenLogReplicator {
         [[nodiscard]] std::string getName() const override;
         void initializeClient() override;
         void initializeServer() override;
+        void setBatch(uint64_t newBatchBytes, uint64_t newLingerUs, uint64_t newZeroCopyBytes);
         void sendMessage(const void* msg, uint64_t length) override;
+        void queueMessage(const void* msg, uint64_t length) override;
+        uint64_t flushPending() override;
+        void flush() override;
+        void discard() override;
         uint64_t receiveMessage(void* msg, uint64_t length) override;
         uint64_t receiveMessageNB(void* msg, uint64_t length) override;
         [[nodiscard]] bool isConnected() override;
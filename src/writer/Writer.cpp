@@ -33,8 +33,10 @@ namespace OpenLogReplicator {
     Writer::Writer(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata) :
             Thread(newCtx, newAlias),
             database(newDatabase),
+            checkpointName(newDatabase + "-chkpt"),
             builder(newBuilder),
             metadata(newMetadata),
+            builderWriter(0),
             builderQueue(nullptr),
             checkpointScn(ZERO_SCN),
             checkpointIdx(0),
@@ -46,7 +48,12 @@ namespace OpenLogReplicator {
             streaming(false),
             confirmedScn(ZERO_SCN),
             confirmedIdx(0),
-            queue(nullptr) {
+            clientScn(ZERO_SCN),
+            clientIdx(0),
+            queue(nullptr),
+            msgSlots(nullptr),
+            msgFree(nullptr),
+            msgFreeSize(0) {
     }
 
     Writer::~Writer() {
@@ -54,20 +61,77 @@ namespace OpenLogReplicator {
             delete[] queue;
             queue = nullptr;
         }
+
+        if (msgSlots != nullptr) {
+            delete[] msgSlots;
+            msgSlots = nullptr;
+        }
+
+        if (msgFree != nullptr) {
+            delete[] msgFree;
+            msgFree = nullptr;
+        }
     }
 
     void Writer::initialize() {
         if (queue != nullptr)
             return;
         queue = new BuilderMsg* [ctx->queueSize];
+        msgSlots = new BuilderMsg[ctx->queueSize];
+        msgFree = new BuilderMsg* [ctx->queueSize];
+        for (uint64_t i = 0; i < ctx->queueSize; ++i)
+            msgFree[i] = &msgSlots[ctx->queueSize - i - 1];
+        msgFreeSize = ctx->queueSize;
+
+        // Every writer of the same source has its own checkpoint, the first one keeps the default name
+        builderWriter = builder->registerWriter();
+        if (builderWriter > 0)
+            checkpointName = database + "-" + alias + "-chkpt";
+        metadata->registerWriter();
     }
 
-    void Writer::createMessage(BuilderMsg* msg) {
+    BuilderMsg* Writer::createMessage(const BuilderMsg* msg) {
         ++sentMessages;
 
-        queue[currentQueueSize++] = msg;
+        BuilderMsg* msgCopy = msgFree[--msgFreeSize];
+        msgCopy->ptr = msg->ptr;
+        msgCopy->id = msg->id;
+        msgCopy->queueId = msg->queueId;
+        msgCopy->length = msg->length.load();
+        msgCopy->scn = msg->scn;
+        msgCopy->lwnScn = msg->lwnScn;
+        msgCopy->lwnIdx = msg->lwnIdx;
+        msgCopy->data = msg->data;
+        msgCopy->sequence = msg->sequence;
+        msgCopy->obj = msg->obj;
+        msgCopy->pos = msg->pos;
+        msgCopy->flags = msg->flags;
+
+        queue[currentQueueSize++] = msgCopy;
         if (currentQueueSize > maxQueueSize)
             maxQueueSize = currentQueueSize;
+        return msgCopy;
+    }
+
+    void Writer::releaseMessage(BuilderMsg* msg) {
+        if ((msg->flags & OUTPUT_BUFFER_MESSAGE_ALLOCATED) != 0) {
+            delete[] msg->data;
+            msg->flags &= ~OUTPUT_BUFFER_MESSAGE_ALLOCATED;
+        }
+        msgFree[msgFreeSize++] = msg;
+    }
+
+    bool Writer::isNewData(typeScn scn, typeIdx idx) const {
+        if (clientScn == ZERO_SCN)
+            return true;
+
+        if (clientScn < scn)
+            return true;
+
+        if (clientScn == scn && clientIdx < idx)
+            return true;
+
+        return false;
     }
 
     void Writer::sortQueue() {
@@ -105,11 +169,10 @@ namespace OpenLogReplicator {
     }
 
     void Writer::resetMessageQueue() {
-        for (uint64_t i = 0; i < currentQueueSize; ++i) {
-            BuilderMsg* msg = queue[i];
-            if ((msg->flags & OUTPUT_BUFFER_MESSAGE_ALLOCATED) != 0)
-                delete[] msg->data;
-        }
+        // Messages waiting in the output batch are released below
+        discard();
+        for (uint64_t i = 0; i < currentQueueSize; ++i)
+            releaseMessage(queue[i]);
         currentQueueSize = 0;
 
         oldLength = builderQueue->start;
@@ -141,6 +204,7 @@ namespace OpenLogReplicator {
         {
             while (currentQueueSize > 0 && (queue[0]->flags & OUTPUT_BUFFER_MESSAGE_CONFIRMED) != 0) {
                 maxId = queue[0]->queueId;
+                releaseMessage(queue[0]);
                 if (confirmedScn == ZERO_SCN || msg->lwnScn > confirmedScn) {
                     confirmedScn = msg->lwnScn;
                     confirmedIdx = msg->lwnIdx;
@@ -170,7 +234,7 @@ namespace OpenLogReplicator {
             }
         }
 
-        builder->releaseBuffers(maxId);
+        builder->releaseBuffers(builderWriter, maxId);
     }
 
     void Writer::run() {
@@ -185,6 +249,7 @@ namespace OpenLogReplicator {
         try {
             // Before anything, read the latest checkpoint
             readCheckpoint();
+            metadata->startWriter(checkpointScn, checkpointIdx);
             builderQueue = builder->firstBuilderQueue;
             oldLength = 0;
             currentQueueSize = 0;
@@ -262,7 +327,13 @@ namespace OpenLogReplicator {
 
                 if (ctx->softShutdown && ctx->replicatorFinished)
                     break;
-                builder->sleepForWriterWork(currentQueueSize, ctx->pollIntervalUs);
+
+                // Nothing new, send the queued messages when the coalescing window passes
+                uint64_t lingerUs = flushPending();
+                if (lingerUs > 0 && lingerUs < ctx->pollIntervalUs)
+                    builder->sleepForWriterWork(currentQueueSize, lingerUs * 1000);
+                else
+                    builder->sleepForWriterWork(currentQueueSize, ctx->pollIntervalUs);
             }
 
             // Send the message
@@ -274,6 +345,8 @@ namespace OpenLogReplicator {
                 // The queue is full
                 pollQueue();
                 while (currentQueueSize >= ctx->queueSize && !ctx->hardShutdown) {
+                    // The client can't confirm messages which are not sent yet
+                    flush();
                     if (ctx->trace & Ctx::TRACE_WRITER)
                         ctx->logTrace(Ctx::TRACE_WRITER, "output queue is full (" + std::to_string(currentQueueSize) +
                                                          " elements), sleeping " + std::to_string(ctx->pollIntervalUs) + "us");
@@ -290,14 +363,14 @@ namespace OpenLogReplicator {
 
                 // Message in one part - send directly from buffer
                 if (oldLength + length8 <= OUTPUT_BUFFER_DATA_SIZE) {
-                    createMessage(msg);
+                    BuilderMsg* msgSend = createMessage(msg);
                     // Send the message to the client in one part
-                    if (((msg->flags & OUTPUT_BUFFER_MESSAGE_CHECKPOINT) && !ctx->flagsSet(Ctx::REDO_FLAGS_SHOW_CHECKPOINT)) ||
-                        !metadata->isNewData(msg->lwnScn, msg->lwnIdx))
-                        confirmMessage(msg);
+                    if (((msgSend->flags & OUTPUT_BUFFER_MESSAGE_CHECKPOINT) && !ctx->flagsSet(Ctx::REDO_FLAGS_SHOW_CHECKPOINT)) ||
+                        !isNewData(msgSend->lwnScn, msgSend->lwnIdx))
+                        confirmMessage(msgSend);
                     else {
-                        uint64_t msgLength = msg->length;
-                        sendMessage(msg);
+                        uint64_t msgLength = msgSend->length;
+                        sendMessage(msgSend);
                         if (ctx->metrics) {
                             ctx->metrics->emitBytesSent(msgLength);
                             ctx->metrics->emitMessagesSent(1);
@@ -307,38 +380,38 @@ namespace OpenLogReplicator {
 
                 } else {
                     // The message is split to many parts - merge & copy
-                    msg->data = new uint8_t[msg->length];
-                    if (msg->data == nullptr)
-                        throw RuntimeException(10016, "couldn't allocate " + std::to_string(msg->length) +
+                    BuilderMsg* msgSend = createMessage(msg);
+                    msgSend->data = new uint8_t[msgSend->length];
+                    if (msgSend->data == nullptr)
+                        throw RuntimeException(10016, "couldn't allocate " + std::to_string(msgSend->length) +
                                                       " bytes memory for: temporary buffer for JSON message");
-                    msg->flags |= OUTPUT_BUFFER_MESSAGE_ALLOCATED;
+                    msgSend->flags |= OUTPUT_BUFFER_MESSAGE_ALLOCATED;
 
                     uint64_t copied = 0;
-                    while (msg->length > copied) {
-                        uint64_t toCopy = msg->length - copied;
+                    while (msgSend->length > copied) {
+                        uint64_t toCopy = msgSend->length - copied;
                         if (toCopy > newLength - oldLength) {
                             toCopy = newLength - oldLength;
-                            memcpy(reinterpret_cast<void*>(msg->data + copied),
+                            memcpy(reinterpret_cast<void*>(msgSend->data + copied),
                                    reinterpret_cast<const void*>(builderQueue->data + oldLength), toCopy);
                             builderQueue = builderQueue->next;
                             newLength = OUTPUT_BUFFER_DATA_SIZE;
                             oldLength = 0;
                         } else {
-                            memcpy(reinterpret_cast<void*>(msg->data + copied),
+                            memcpy(reinterpret_cast<void*>(msgSend->data + copied),
                                    reinterpret_cast<const void*>(builderQueue->data + oldLength), toCopy);
                             oldLength += (toCopy + 7) & 0xFFFFFFFFFFFFFFF8;
                         }
                         copied += toCopy;
                     }
 
-                    createMessage(msg);
                     // Send only new messages to the client
-                    if (((msg->flags & OUTPUT_BUFFER_MESSAGE_CHECKPOINT) && !ctx->flagsSet(Ctx::REDO_FLAGS_SHOW_CHECKPOINT)) ||
-                        !metadata->isNewData(msg->lwnScn, msg->lwnIdx))
-                        confirmMessage(msg);
+                    if (((msgSend->flags & OUTPUT_BUFFER_MESSAGE_CHECKPOINT) && !ctx->flagsSet(Ctx::REDO_FLAGS_SHOW_CHECKPOINT)) ||
+                        !isNewData(msgSend->lwnScn, msgSend->lwnIdx))
+                        confirmMessage(msgSend);
                     else {
-                        uint64_t msgLength = msg->length;
-                        sendMessage(msg);
+                        uint64_t msgLength = msgSend->length;
+                        sendMessage(msgSend);
                         if (ctx->metrics) {
                             ctx->metrics->emitBytesSent(msgLength);
                             ctx->metrics->emitMessagesSent(1);
@@ -347,6 +420,7 @@ namespace OpenLogReplicator {
                     break;
                 }
             }
+            flushPending();
 
             // All work done?
             if (ctx->softShutdown && ctx->replicatorFinished) {
@@ -357,9 +431,20 @@ namespace OpenLogReplicator {
             }
         }
 
+        flush();
         writeCheckpoint(true);
     }
 
+    void Writer::flush() {
+    }
+
+    uint64_t Writer::flushPending() {
+        return 0;
+    }
+
+    void Writer::discard() {
+    }
+
     void Writer::writeCheckpoint(bool force) {
         // Nothing changed
         if ((checkpointScn == confirmedScn && checkpointIdx == confirmedIdx) || confirmedScn == ZERO_SCN)
@@ -384,7 +469,6 @@ namespace OpenLogReplicator {
                                                      std::to_string(confirmedIdx) + " checkpoint scn: " + std::to_string(checkpointScn) + " idx: " +
                                                      std::to_string(checkpointIdx));
         }
-        std::string name(database + "-chkpt");
         std::ostringstream ss;
         ss << R"({"database":")" << database
            << R"(","scn":)" << std::dec << confirmedScn
@@ -392,7 +476,7 @@ namespace OpenLogReplicator {
            << R"(,"resetlogs":)" << std::dec << metadata->resetlogs
            << R"(,"activation":)" << std::dec << metadata->activation << "}";
 
-        if (metadata->stateWrite(name, confirmedScn, ss)) {
+        if (metadata->stateWrite(checkpointName, confirmedScn, ss, false)) {
             checkpointScn = confirmedScn;
             checkpointIdx = confirmedIdx;
             checkpointTime = now;
@@ -400,7 +484,7 @@ namespace OpenLogReplicator {
     }
 
     void Writer::readCheckpoint() {
-        std::string name(database + "-chkpt");
+        const std::string& name = checkpointName;
 
         // Checkpoint is present - read it
         std::string checkpoint;
@@ -426,20 +510,15 @@ namespace OpenLogReplicator {
 
         // Started earlier - continue work & ignore default startup parameters
         checkpointScn = Ctx::getJsonFieldU64(name, document, "scn");
-        metadata->clientScn = checkpointScn;
+        clientScn = checkpointScn;
         if (document.HasMember("idx"))
             checkpointIdx = Ctx::getJsonFieldU64(name, document, "idx");
         else
             checkpointIdx = 0;
-        metadata->clientIdx = checkpointIdx;
-        metadata->startScn = checkpointScn;
-        metadata->startSequence = ZERO_SEQ;
-        metadata->startTime.clear();
-        metadata->startTimeRel = 0;
+        clientIdx = checkpointIdx;
 
         ctx->info(0, "checkpoint - all confirmed till scn: " + std::to_string(checkpointScn) + ", idx: " +
                      std::to_string(checkpointIdx));
-        metadata->setStatusReplicate();
     }
 
     void Writer::wakeUp() {
@@ -32,8 +32,10 @@ namespace OpenLogReplicator {
     class Writer : public Thread {
     protected:
         std::string database;
+        std::string checkpointName;
         Builder* builder;
         Metadata* metadata;
+        uint64_t builderWriter;
         // Information about local checkpoint
         BuilderQueue* builderQueue;
         typeScn checkpointScn;
@@ -49,10 +51,22 @@ namespace OpenLogReplicator {
         // scn,idx confirmed by client
         typeScn confirmedScn;
         typeIdx confirmedIdx;
+        // scn,idx of the last message already delivered before start
+        typeScn clientScn;
+        typeIdx clientIdx;
         BuilderMsg** queue;
+        // Private copies of message headers, the builder buffers are shared with other writers
+        BuilderMsg* msgSlots;
+        BuilderMsg** msgFree;
+        uint64_t msgFreeSize;
 
-        void createMessage(BuilderMsg* msg);
+        BuilderMsg* createMessage(const BuilderMsg* msg);
+        void releaseMessage(BuilderMsg* msg);
+        [[nodiscard]] bool isNewData(typeScn scn, typeIdx idx) const;
         virtual void sendMessage(BuilderMsg* msg) = 0;
+        virtual void flush();
+        virtual uint64_t flushPending();
+        virtual void discard();
         virtual std::string getName() const = 0;
         virtual void pollQueue() = 0;
         void run() override;
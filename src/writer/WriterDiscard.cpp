@@ -28,6 +28,7 @@ namespace OpenLogReplicator {
     }
 
     void WriterDiscard::initialize() {
+        Writer::initialize();
     }
 
     void WriterDiscard::sendMessage(BuilderMsg* msg) {
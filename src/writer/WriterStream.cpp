@@ -172,6 +172,8 @@ namespace OpenLogReplicator {
                 metadata->clientIdx = request.c_idx();
             paramIdx = ", idx: " + std::to_string(metadata->clientIdx);
         }
+        clientScn = metadata->clientScn;
+        clientIdx = metadata->clientIdx;
         ctx->info(0, "client requested scn: " + std::to_string(metadata->clientScn) + paramIdx);
 
         resetMessageQueue();
@@ -267,6 +269,19 @@ namespace OpenLogReplicator {
     }
 
     void WriterStream::sendMessage(BuilderMsg* msg) {
-        stream->sendMessage(msg->data, msg->length);
+        // The message stays in memory until the client confirms it
+        stream->queueMessage(msg->data, msg->length);
+    }
+
+    void WriterStream::flush() {
+        stream->flush();
+    }
+
+    uint64_t WriterStream::flushPending() {
+        return stream->flushPending();
+    }
+
+    void WriterStream::discard() {
+        stream->discard();
     }
 }
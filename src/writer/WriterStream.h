@@ -39,6 +39,9 @@ namespace OpenLogReplicator {
         void processConfirm();
         void pollQueue() override;
         void sendMessage(BuilderMsg* msg) override;
+        void flush() override;
+        uint64_t flushPending() override;
+        void discard() override;
 
     public:
         WriterStream(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata, Stream* newStream);